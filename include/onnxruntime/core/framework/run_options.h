@@ -5,8 +5,10 @@
 
 #include <string>
 #include <atomic>
+#include <mutex>
 #include "core/session/onnxruntime_c_api.h"
 #include "core/framework/config_options.h"
+#include "core/platform/ort_mutex.h"
 
 /**
  * Configuration information for a Run call.
@@ -40,6 +42,36 @@ struct OrtRunOptions {
   // /include/onnxruntime/core/session/onnxruntime_run_options_config_keys.h
   onnxruntime::ConfigOptions config_options;
 
+  // JSON latency breakdown of the last Run() call using this instance to complete, when the "run.latency_breakdown"
+  // config entry is "1". Run() sets it even though the instance is const there, so it is guarded by a mutex for the
+  // concurrent Run() and RunAsync() calls sharing the instance.
+  class LatencyBreakdown {
+   public:
+    LatencyBreakdown() = default;
+    LatencyBreakdown(const LatencyBreakdown& other) : json_(other.Get()) {}
+    LatencyBreakdown& operator=(const LatencyBreakdown& other) {
+      if (this != &other) {
+        Set(other.Get());
+      }
+      return *this;
+    }
+
+    std::string Get() const {
+      std::lock_guard<onnxruntime::OrtMutex> lock(mutex_);
+      return json_;
+    }
+
+    void Set(std::string json) {
+      std::lock_guard<onnxruntime::OrtMutex> lock(mutex_);
+      json_ = std::move(json);
+    }
+
+   private:
+    mutable onnxruntime::OrtMutex mutex_;
+    std::string json_;
+  };
+  mutable LatencyBreakdown latency_breakdown;
+
   OrtRunOptions() = default;
   ~OrtRunOptions() = default;
 };
@@ -399,7 +399,10 @@ class Node {
   bool ClearAttribute(const std::string& attr_name);
 
   /** Gets the Node's mutable attributes. */
-  NodeAttributes& GetMutableAttributes() noexcept { return attributes_; }
+  NodeAttributes& GetMutableAttributes() noexcept {
+    ++attributes_version_;
+    return attributes_;
+  }
 
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
@@ -666,6 +669,9 @@ class Node {
   // This allows attribute adding and removing.
   NodeAttributes attributes_;
 
+  // Incremented whenever attributes_ may have been modified. Used by Graph::Resolve to detect changed nodes.
+  uint64_t attributes_version_ = 0;
+
   // Graph that contains this Node
   Graph* graph_ = nullptr;
 
@@ -1574,6 +1580,9 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
 
   common::Status VerifyNodeAndOpMatch(const ResolveOptions& options);
 
+  // Get the state of a node its type and shape inference depends on. See node_inference_states_.
+  std::string GetNodeInferenceState(const Node& node) const;
+
   // Set graph inputs/outputs when resolving a graph..
   common::Status SetGraphInputsOutputs();
 
@@ -1757,6 +1766,16 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   // number of times Resolve has run.
   int num_resolves_ = 0;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // State of each node as of its last type and shape inference: the schema, attributes and the types of the node's
+  // inputs and outputs. Resolve skips the inference for nodes whose state is unchanged, so a graph transformer only
+  // pays for inferencing the nodes it modified and the nodes whose inputs changed as a result.
+  InlinedHashMap<NodeIndex, std::string> node_inference_states_;
+
+  // Incremented when an initializer is replaced in place, as the data of a constant input may affect inference.
+  uint64_t initializers_version_ = 0;
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
   const logging::Logger& logger_;
 
   // If true, all inconsistencies encountered during shape and type inference
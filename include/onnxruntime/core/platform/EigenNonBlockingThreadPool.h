@@ -53,6 +53,7 @@
 #include "core/platform/ort_mutex.h"
 #include "core/platform/ort_spin_lock.h"
 #include "core/platform/Barrier.h"
+#include "core/platform/threadpool.h"
 
 // ORT thread pool overview
 // ------------------------
@@ -339,6 +340,7 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
                              unsigned n, std::ptrdiff_t block_size) = 0;
   virtual void StartProfiling() = 0;
   virtual std::string StopProfiling() = 0;
+  virtual ThreadPoolTelemetry GetTelemetry() const = 0;
 };
 
 class ThreadPoolParallelSection {
@@ -730,6 +732,24 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return profiler_.Stop();
   }
 
+  ThreadPoolTelemetry GetTelemetry() const override {
+    ThreadPoolTelemetry telemetry;
+    telemetry.tasks_executed.reserve(num_threads_);
+    for (size_t i = 0; i < worker_data_.size(); ++i) {
+      const auto& counters = worker_data_[i].counters;
+      telemetry.tasks_executed.push_back(counters.tasks_executed.load(std::memory_order_relaxed));
+      telemetry.tasks_stolen += counters.tasks_stolen.load(std::memory_order_relaxed);
+      telemetry.spin_iterations += counters.spin_iterations.load(std::memory_order_relaxed);
+      telemetry.parks += counters.parks.load(std::memory_order_relaxed);
+      telemetry.unparks += counters.unparks.load(std::memory_order_relaxed);
+      telemetry.unpark_latency_ns += counters.unpark_latency_ns.load(std::memory_order_relaxed);
+    }
+    telemetry.parallel_loops = parallel_loops_.load(std::memory_order_relaxed);
+    telemetry.parallel_loop_ns = parallel_loop_ns_.load(std::memory_order_relaxed);
+    telemetry.parallel_loop_wait_ns = parallel_loop_wait_ns_.load(std::memory_order_relaxed);
+    return telemetry;
+  }
+
   struct Tag {
     constexpr Tag() : v_(0) {
     }
@@ -1270,6 +1290,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         }
       }
     };
+    const uint64_t start_ns = NowNs();
     RunInParallelInternal(*pt, ps, n, false, std::move(worker_fn));
     assert(ps.dispatch_q_idx == -1);
     profiler_.LogEndAndStart(ThreadPoolProfiler::DISTRIBUTION);
@@ -1277,6 +1298,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     // Run work in the main thread
     loop.fn(0);
     profiler_.LogEndAndStart(ThreadPoolProfiler::RUN);
+    const uint64_t run_end_ns = NowNs();
 
     // Wait for workers to exit the loop
     ps.current_loop = 0;
@@ -1284,6 +1306,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       onnxruntime::concurrency::SpinPause();
     }
     profiler_.LogEnd(ThreadPoolProfiler::WAIT);
+    RecordParallelLoop(start_ns, run_end_ns, NowNs());
   }
 
   // Run a single parallel loop _without_ a parallel section.  This is a
@@ -1303,13 +1326,16 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     profiler_.LogStartAndCoreAndBlock(block_size);
     PerThread* pt = GetPerThread();
     ThreadPoolParallelSection ps;
+    const uint64_t start_ns = NowNs();
     StartParallelSectionInternal(*pt, ps);
     RunInParallelInternal(*pt, ps, n, true, fn);  // select dispatcher and do job distribution;
     profiler_.LogEndAndStart(ThreadPoolProfiler::DISTRIBUTION);
     fn(0);  // run fn(0)
     profiler_.LogEndAndStart(ThreadPoolProfiler::RUN);
+    const uint64_t run_end_ns = NowNs();
     EndParallelSectionInternal(*pt, ps);  // wait for all
     profiler_.LogEnd(ThreadPoolProfiler::WAIT);
+    RecordParallelLoop(start_ns, run_end_ns, NowNs());
   }
 
   int NumThreads() const final {
@@ -1449,6 +1475,8 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         assert(seen != ThreadStatus::Blocking);
         if (seen == ThreadStatus::Blocked) {
           status.store(ThreadStatus::Waking, std::memory_order_relaxed);
+          Increment(counters.unparks);
+          wake_time_ns = NowNs();
           lk.unlock();
           cv.notify_one();
         }
@@ -1475,20 +1503,57 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       status.store(ThreadStatus::Blocking, std::memory_order_relaxed);
       if (should_block()) {
         status.store(ThreadStatus::Blocked, std::memory_order_relaxed);
+        Increment(counters.parks);
         do {
           cv.wait(lk);
         } while (status.load(std::memory_order_relaxed) == ThreadStatus::Blocked);
+        // the wake-up notification was sent at wake_time_ns, unless the thread is woken up for exit
+        const uint64_t now_ns = NowNs();
+        Increment(counters.unpark_latency_ns, now_ns > wake_time_ns ? now_ns - wake_time_ns : 0);
         post_block();
       }
       status.store(ThreadStatus::Spinning, std::memory_order_relaxed);
     }
 
+    // Telemetry of the thread, see ThreadPoolTelemetry.  The counters are written by the thread itself, except for
+    // unparks which is written by the waking thread under the mutex, so they are updated without read-modify-write.
+    struct ORT_ALIGN_TO_AVOID_FALSE_SHARING Counters {
+      std::atomic<uint64_t> tasks_executed{0};
+      std::atomic<uint64_t> tasks_stolen{0};
+      std::atomic<uint64_t> spin_iterations{0};
+      std::atomic<uint64_t> parks{0};
+      std::atomic<uint64_t> unparks{0};
+      std::atomic<uint64_t> unpark_latency_ns{0};
+    };
+    Counters counters;
+
    private:
     std::atomic<ThreadStatus> status{ThreadStatus::Spinning};
     OrtMutex mutex;
     OrtCondVar cv;
+    // time of the last wake-up notification, protected by mutex
+    uint64_t wake_time_ns{0};
   };
 
+  // Adds to a counter that has a single writer at a time
+  static void Increment(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  static uint64_t NowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+  }
+
+  // Records a parallel loop entered at start_ns, in which the entering thread finished its own share of the work at
+  // run_end_ns and the other threads at end_ns
+  void RecordParallelLoop(uint64_t start_ns, uint64_t run_end_ns, uint64_t end_ns) {
+    parallel_loops_.fetch_add(1, std::memory_order_relaxed);
+    parallel_loop_ns_.fetch_add(end_ns - start_ns, std::memory_order_relaxed);
+    parallel_loop_wait_ns_.fetch_add(end_ns - run_end_ns, std::memory_order_relaxed);
+  }
+
   Environment& env_;
   const unsigned num_threads_;
   const bool allow_spinning_;
@@ -1510,6 +1575,11 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // Default is no control over spinning
   std::atomic<SpinLoopStatus> spin_loop_status_{SpinLoopStatus::kBusy};
 
+  // Telemetry of the parallel loops, see ThreadPoolTelemetry.  Updated by the threads entering the loops.
+  std::atomic<uint64_t> parallel_loops_{0};
+  std::atomic<uint64_t> parallel_loop_ns_{0};
+  std::atomic<uint64_t> parallel_loop_wait_ns_{0};
+
   // Wake any blocked workers so that they can cleanly exit WorkerLoop().  For
   // a clean exit, each thread will observe (1) done_ set, indicating that the
   // destructor has been called, (2) all threads blocked, and (3) no
@@ -1543,9 +1613,11 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       Task t = q.PopFront();
       if (!t) {
         // Spin waiting for work.
-        for (int i = 0; i < spin_count && !done_; i++) {
-          if (((i + 1) % steal_count == 0)) {
+        int spins = 0;
+        for (; spins < spin_count && !done_; spins++) {
+          if (((spins + 1) % steal_count == 0)) {
             t = Steal(StealAttemptKind::TRY_ONE);
+            if (t) Increment(td.counters.tasks_stolen);
           } else {
             t = q.PopFront();
           }
@@ -1556,6 +1628,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           }
           onnxruntime::concurrency::SpinPause();
         }
+        Increment(td.counters.spin_iterations, spins);
 
         // Attempt to block
         if (!t) {
@@ -1619,7 +1692,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           // blocking, or are exiting, then either work was pushed to
           // us, or it was pushed to an overloaded queue
           if (!t) t = q.PopFront();
-          if (!t) t = Steal(StealAttemptKind::TRY_ALL);
+          if (!t) {
+            t = Steal(StealAttemptKind::TRY_ALL);
+            if (t) Increment(td.counters.tasks_stolen);
+          }
         }
       }
 
@@ -1627,6 +1703,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         td.SetActive();
         t();
         profiler_.LogRun(thread_id);
+        Increment(td.counters.tasks_executed);
         td.SetSpinning();
       }
     }
@@ -136,6 +136,35 @@ class ExtendedThreadPoolInterface;
 class LoopCounter;
 class ThreadPoolParallelSection;
 
+// Counters of a thread pool since it was created.  They are always on: the workers update their own counters with
+// relaxed atomics, and the parallel loops add three clock reads in the thread entering them.  A snapshot taken
+// while the pool is busy may be off by the work in flight.
+struct ThreadPoolTelemetry {
+  // tasks run by each worker thread
+  std::vector<uint64_t> tasks_executed;
+  // tasks a worker took from the queue of another worker
+  uint64_t tasks_stolen = 0;
+  // iterations of the spin-wait loops of the workers, i.e. time spent polling for work
+  uint64_t spin_iterations = 0;
+  // times a worker blocked waiting for work, times a blocked worker was woken up, and the total time from the
+  // wake-up notification to the worker running again
+  uint64_t parks = 0;
+  uint64_t unparks = 0;
+  uint64_t unpark_latency_ns = 0;
+  // parallel loops run in the pool, their total duration in the threads entering them, and the time those threads
+  // waited for the other threads after running their own share, i.e. the cost of load imbalance and stragglers
+  uint64_t parallel_loops = 0;
+  uint64_t parallel_loop_ns = 0;
+  uint64_t parallel_loop_wait_ns = 0;
+
+  // counters accumulated since an earlier snapshot of the same pool
+  ThreadPoolTelemetry Since(const ThreadPoolTelemetry& earlier) const;
+
+  // JSON object with the counters, the mean unpark latency and the load imbalance, i.e. the fraction of the
+  // duration of the parallel loops that the entering threads spent waiting
+  std::string ToJson() const;
+};
+
 class ThreadPool {
  public:
 #ifdef _WIN32
@@ -366,6 +395,9 @@ class ThreadPool {
   static void StartProfiling(concurrency::ThreadPool* tp);
   static std::string StopProfiling(concurrency::ThreadPool* tp);
 
+  // Snapshot of the always-on counters of the pool.  Empty if tp is nullptr or the pool has no threads.
+  static ThreadPoolTelemetry GetTelemetry(const concurrency::ThreadPool* tp);
+
  private:
   friend class LoopCounter;
 
@@ -415,6 +447,8 @@ class ThreadPool {
 
   std::string StopProfiling();
 
+  ThreadPoolTelemetry GetTelemetry() const;
+
   ThreadOptions thread_options_;
 
   // If a thread pool is created with degree_of_parallelism != 1 then an underlying
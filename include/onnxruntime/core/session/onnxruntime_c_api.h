@@ -4385,7 +4385,11 @@ struct OrtApi {
   ORT_API2_STATUS(CreateAndRegisterAllocatorV2, _Inout_ OrtEnv* env, _In_ const char* provider_type, _In_ const OrtMemoryInfo* mem_info, _In_ const OrtArenaCfg* arena_cfg,
                   _In_reads_(num_keys) const char* const* provider_options_keys, _In_reads_(num_keys) const char* const* provider_options_values, _In_ size_t num_keys);
 
-  /** \brief Run the model asynchronously in a thread owned by intra op thread pool
+  /** \brief Run the model asynchronously in a thread owned by the session
+   *
+   * Requests are queued and at most "session.run_async_max_in_flight" of them run at the same time. The queue is
+   * ordered by the "run.async_priority" run option, and "run.async_deadline_ms" cancels a request that takes too long.
+   * RunAsync fails if the queue is bounded by "session.run_async_max_queue_size" and full.
    *
    * \param[in] session
    * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
@@ -4665,6 +4669,78 @@ struct OrtApi {
                   _In_reads_(num_external_initializer_files) char* const* external_initializer_file_buffer_array,
                   _In_reads_(num_external_initializer_files) const size_t* external_initializer_file_lengths,
                   size_t num_external_initializer_files);
+
+  /** \brief Get a snapshot of the always-on sampling profiler of a session
+   *
+   * The sampling profiler is enabled with the session option "session.sampling_profiler_enable". It keeps running
+   * after the snapshot, so this can be called at any time, e.g. periodically or when an operator requests it.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string. It must be used to free it.
+   * \param[out] out Null terminated JSON document with the count, mean, p50, p90, p99 and max latency in
+   *                 microseconds per op type and per node, and the most recent sampled kernel events.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.19.
+   */
+  ORT_API2_STATUS(SessionGetProfilingSnapshot, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Get the report of the memory profiler of a session
+   *
+   * The memory profiler is enabled with the session option "session.memory_profile_enable". It records the activation
+   * tensors allocated and freed in every run, and keeps the run with the highest peak.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string. It must be used to free it.
+   * \param[out] out Null terminated JSON document with, for the run with the highest peak, the node, size, arena chunk
+   *                 size and lifetime of every tensor, the timeline of allocations and frees, and per device the
+   *                 tensors that are live at the peak and the internal and external fragmentation of the arena.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.19.
+   */
+  ORT_API2_STATUS(SessionGetMemoryProfile, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Get the counters of the thread pools used by a session
+   *
+   * The counters are always on and count since the thread pools were created. Global thread pools shared between
+   * sessions include the work of every session. The difference between two calls gives the counters of the runs in
+   * between.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string. It must be used to free it.
+   * \param[out] out Null terminated JSON document with, for the intra-op and inter-op thread pools, the tasks executed
+   *                 per worker thread, the tasks stolen, the spin-wait iterations, the times workers blocked and were
+   *                 woken up with the wake-up latency, and the number, duration and load imbalance of parallel loops.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.19.
+   */
+  ORT_API2_STATUS(SessionGetThreadPoolTelemetry, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Get the latency breakdown of the last OrtApi::Run call that used the run options
+   *
+   * The breakdown is recorded when the "run.latency_breakdown" config entry of the run options is "1".
+   * See onnxruntime_run_options_config_keys.h. It is empty if no Run call recorded one.
+   *
+   * \param[in] options
+   * \param[in] allocator Allocator used to allocate the returned string. It must be used to free it.
+   * \param[out] out Null terminated JSON document with the total time of the run and the time spent validating the
+   *                 inputs, allocating and planning, transferring data between devices and copying the outputs, with
+   *                 the number of kernels and the compute time of each execution provider. Times are in nanoseconds.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.19.
+   */
+  ORT_API2_STATUS(RunOptionsGetLatencyBreakdown, _In_ const OrtRunOptions* options, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
 };
 
 /*
@@ -754,6 +754,15 @@ struct RunOptions : detail::Base<OrtRunOptions> {
 
   RunOptions& AddConfigEntry(const char* config_key, const char* config_value);  ///< Wraps OrtApi::AddRunConfigEntry
 
+  /** \brief Returns the latency breakdown of the last Session::Run call that used this RunOptions instance
+   *
+   * Recorded when the "run.latency_breakdown" config entry is "1".
+   *  \param allocator to allocate memory for the copy of the breakdown returned
+   *  \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   *  The OrtAllocator instances must be valid at the point of memory release.
+   */
+  AllocatedStringPtr GetLatencyBreakdownAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::RunOptionsGetLatencyBreakdown
+
   /** \brief Terminates all currently executing Session::Run calls that were made using this RunOptions instance
    *
    * If a currently executing session needs to be force terminated, this can be called from another thread to force it to fail with an error
@@ -1036,6 +1045,31 @@ struct ConstSessionImpl : Base<T> {
   AllocatedStringPtr GetOverridableInitializerNameAllocated(size_t index, OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetOverridableInitializerName
 
   uint64_t GetProfilingStartTimeNs() const;  ///< Wraps OrtApi::SessionGetProfilingStartTimeNs
+
+  /** \brief Returns a snapshot of the sampling profiler as a JSON document
+   *
+   *  \param allocator to allocate memory for the copy of the snapshot returned
+   *  \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   *  The OrtAllocator instances must be valid at the point of memory release.
+   */
+  AllocatedStringPtr GetProfilingSnapshotAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetProfilingSnapshot
+
+  /** \brief Returns the report of the memory profiler as a JSON document
+   *
+   *  \param allocator to allocate memory for the copy of the report returned
+   *  \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   *  The OrtAllocator instances must be valid at the point of memory release.
+   */
+  AllocatedStringPtr GetMemoryProfileAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetMemoryProfile
+
+  /** \brief Returns the counters of the thread pools used by the session as a JSON document
+   *
+   *  \param allocator to allocate memory for the copy of the counters returned
+   *  \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   *  The OrtAllocator instances must be valid at the point of memory release.
+   */
+  AllocatedStringPtr GetThreadPoolTelemetryAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetThreadPoolTelemetry
+
   ModelMetadata GetModelMetadata() const;    ///< Wraps OrtApi::SessionGetModelMetadata
 
   TypeInfo GetInputTypeInfo(size_t index) const;                   ///< Wraps OrtApi::SessionGetInputTypeInfo
@@ -1076,7 +1110,7 @@ struct SessionImpl : ConstSessionImpl<T> {
 
   void Run(const RunOptions& run_options, const IoBinding&);  ///< Wraps OrtApi::RunWithBinding
 
-  /** \brief Run the model asynchronously in a thread owned by intra op thread pool
+  /** \brief Run the model asynchronously in a thread owned by the session
    *
    * Wraps OrtApi::RunAsync
    *
@@ -49,3 +49,17 @@ static const char* const kOrtRunOptionsConfigQnnRpcControlLatency = "qnn.rpc_con
 // If the value is set to -1, cuda graph capture/replay is disabled in that run.
 // User are not expected to set the value to 0 as it is reserved for internal use.
 static const char* const kOrtRunOptionsConfigCudaGraphAnnotation = "gpu_graph_id";
+
+// Priority of a RunAsync request. Queued requests with a higher priority start first; requests with the same
+// priority start in submission order. The value is an integer. Default to "0".
+static const char* const kOrtRunOptionsConfigRunAsyncPriority = "run.async_priority";
+
+// Deadline of a RunAsync request in milliseconds after RunAsync is called. A request that has not started by then
+// completes with an error without running, and a running request is terminated as if RunOptions::terminate was set.
+// The value is a positive integer. Not set by default.
+static const char* const kOrtRunOptionsConfigRunAsyncDeadlineMs = "run.async_deadline_ms";
+
+// Set to '1' to record a latency breakdown of each Run: the time spent validating the inputs, allocating and planning,
+// in the kernels of each execution provider, transferring data between devices with the DataTransferManager, and
+// copying the outputs. Read it with OrtApi::RunOptionsGetLatencyBreakdown after the Run. Default to "0".
+static const char* const kOrtRunOptionsConfigEnableLatencyBreakdown = "run.latency_breakdown";
@@ -128,13 +128,28 @@ static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "ses
 /// <summary>
 /// Key for using the ORT format model flatbuffer bytes directly for initializers.
 /// This avoids copying the bytes and reduces peak memory usage during model loading and initialization.
-/// Requires `session.use_ort_model_bytes_directly` to be true.
+/// When creating the InferenceSession from a byte array, requires `session.use_ort_model_bytes_directly` to be true.
 /// If set, the flatbuffer bytes provided when creating the InferenceSession MUST remain valid for the entire
 /// duration of the InferenceSession.
+/// When creating the InferenceSession from a file path, the file is memory mapped for the duration of the
+/// InferenceSession, so CPU initializers are used in place without being read or copied.
 /// </summary>
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesForInitializers =
     "session.use_ort_model_bytes_for_initializers";
 
+// Key for sharing identical initializers between sessions, e.g. sessions of fine-tuned variants of a model.
+// Only applies to sessions created with a PrepackedWeightsContainer (CreateSessionWithPrepackedWeightsContainer).
+// If set to "1", a constant CPU initializer is stored once in the container for all the sessions using it that have
+// an initializer with the same data type, shape and data, and pre-packed versions of it are shared as well.
+// The container keeps the shared initializers until it is released.
+// Combine with the environment's allocators and thread pools ("session.use_env_allocators" and
+// DisablePerSessionThreads) to share those between the sessions too.
+// Option values:
+// - "0": Initializers are not shared. [DEFAULT]
+// - "1": Identical initializers are shared between the sessions using the same PrepackedWeightsContainer.
+static const char* const kOrtSessionOptionsConfigShareInitializersAcrossSessions =
+    "session.share_initializers_across_sessions";
+
 // This should only be specified when exporting an ORT format model for use on a different platform.
 // If the ORT format model will be used on ARM platforms set to "1". For other platforms set to "0"
 // Available since version 1.11.
@@ -194,6 +209,97 @@ static const char* const kOrtSessionOptionsConfigStrictShapeTypeInference = "ses
 // is used for development purpose.
 static const char* const kOrtSessionOptionsConfigStrictAllowReleasedOpsetsOnly = "session.allow_released_opsets_only";
 
+// Parallelizes session initialization over the intra-op thread pool: initializers placed on CPU are deserialized
+// (including reads of external data), CPU kernels are created and CPU kernels pre-pack their weights concurrently.
+// Kernels of other execution providers, control flow kernels and custom op kernels are still initialized sequentially.
+// Option values:
+// - "0": session initialization runs on the calling thread. [DEFAULT]
+// - "1": session initialization uses the intra-op thread pool.
+static const char* const kOrtSessionOptionsConfigParallelInitialization = "session.parallel_initialization";
+
+// Minimum size in bytes of the raw data of an initializer in an ONNX model loaded from a file for the data to be
+// skipped while the model is parsed. Such an initializer refers to its bytes in the model file instead, and they are
+// memory mapped when the initializer is placed on CPU, so large embedded weights are not held in memory twice.
+// Option values:
+// - "0": all initializer data is read into memory when the model is parsed. [DEFAULT]
+// - a positive integer: the threshold in bytes, e.g. "1024".
+static const char* const kOrtSessionOptionsConfigInPlaceInitializerMinSizeInBytes = "session.in_place_initializer_min_size_in_bytes";
+
+// Directory of a cache of optimized models. When set, the ONNX model graph after all graph optimizations and
+// partitioning is saved in ORT format under a key computed from the model bytes and external data, the session
+// options, the execution providers and the CPU features. Later sessions with the same key load the optimized model
+// from the cache instead of optimizing the graph again.
+// The cache is only used for models loaded from a file path or a byte array, and not when execution providers compile
+// nodes, external initializers are provided via session options or an optimized model is being saved.
+// The directory is created if it does not exist. The value is a UTF-8 path. Not set by default.
+static const char* const kOrtSessionOptionsConfigOptimizedModelCacheDir = "session.optimized_model_cache_dir";
+
+// Maximum number of RunAsync requests of a session that execute at the same time. RunAsync requests are executed by
+// threads dedicated to the session and not by the intra-op thread pool, which stays available to the kernels.
+// Requests above the limit wait in a queue ordered by the "run.async_priority" run option and then by submission.
+// The value must be a positive integer. Defaults to the number of threads of the intra-op thread pool.
+static const char* const kOrtSessionOptionsConfigRunAsyncMaxInFlight = "session.run_async_max_in_flight";
+
+// Maximum number of RunAsync requests of a session waiting for execution. RunAsync fails once the queue is full.
+// Option values:
+// - "0": the queue is unbounded. [DEFAULT]
+// - a positive integer: the maximum queue length.
+static const char* const kOrtSessionOptionsConfigRunAsyncMaxQueueSize = "session.run_async_max_queue_size";
+
+// Warm up the session at the end of initialization, so the first requests don't pay for the work done by the first
+// Run: arena growth, creation of memory patterns, tunable op searches and page faults on the weights.
+// The model is run with synthetic zero filled inputs with the shapes in "session.warm_up_input_shapes".
+// A failed warm-up is logged as a warning and doesn't fail the initialization.
+// Option values:
+// - "0": The session is not warmed up. [DEFAULT]
+// - "1": The session is warmed up.
+static const char* const kOrtSessionOptionsConfigWarmUp = "session.warm_up";
+
+// Input shapes to warm up the session with. Each set of shapes separated by ';' is run separately, so the memory
+// patterns of each set are created. Within a set, inputs are separated by ',' and written as name:dims, with the
+// dims separated by 'x', e.g. "input_ids:1x128,attention_mask:1x128;input_ids:8x128,attention_mask:8x128".
+// A scalar is written as "name:". Symbolic dimensions of inputs that are not in a set are 1.
+// Not set by default, which warms up a single set with all symbolic dimensions set to 1.
+static const char* const kOrtSessionOptionsConfigWarmUpInputShapes = "session.warm_up_input_shapes";
+
+// Enable the always-on sampling profiler. It keeps a latency histogram per node and a ring buffer of sampled kernel
+// events, and is cheap enough to leave enabled in production. Get the per op type and per node latency percentiles
+// with SessionGetProfilingSnapshot at any time. It is independent of enable_profiling and its JSON trace file.
+// Option values:
+// - "0": The sampling profiler is disabled. [DEFAULT]
+// - "1": The sampling profiler is enabled.
+static const char* const kOrtSessionOptionsConfigEnableSamplingProfiler = "session.sampling_profiler_enable";
+
+// Number of recent kernel events kept by the sampling profiler. Defaults to "4096".
+static const char* const kOrtSessionOptionsConfigSamplingProfilerRingBufferSize =
+    "session.sampling_profiler_ring_buffer_size";
+
+// One in this many kernel executions of each thread is added to the ring buffer of the sampling profiler.
+// All executions are added to the latency histograms. "0" only keeps the histograms. Defaults to "64".
+static const char* const kOrtSessionOptionsConfigSamplingProfilerSampleInterval =
+    "session.sampling_profiler_sample_interval";
+
+// Enable the runtime memory profiler. It records every activation tensor allocated and freed during a run with the
+// node that produced and released it, its size and the arena chunk holding it. Get the timeline of the run with the
+// highest peak and the tensors that make up the peak of every device, with the fragmentation of the arena at that
+// point, with SessionGetMemoryProfile. Unlike ORT_MEMORY_PROFILE builds, it doesn't need a custom build.
+// Option values:
+// - "0": The memory profiler is disabled. [DEFAULT]
+// - "1": The memory profiler is enabled.
+static const char* const kOrtSessionOptionsConfigEnableMemoryProfile = "session.memory_profile_enable";
+
+// Set to "1" to add hardware performance counters (cycles, instructions and last level cache misses) to the kernel
+// events of the profiler, with the derived IPC and memory bandwidth. Linux only, using perf_event. The counters are
+// left out with a warning if perf_event is not available, e.g. due to /proc/sys/kernel/perf_event_paranoid.
+// Defaults to "0".
+static const char* const kOrtSessionOptionsConfigProfileHardwareCounters = "session.profile_hardware_counters";
+
+// Set to "1" to add a lane per thread to the profile. The share of each ParallelFor run by every intra-op worker, the
+// arena extensions of a kernel and the hand-offs between streams on the inter-op workers are recorded on the lanes
+// of the threads that run them, named after the worker. The profile is a Chrome trace, which Perfetto also opens.
+// Defaults to "0".
+static const char* const kOrtSessionOptionsConfigProfileThreadPoolTrace = "session.profile_thread_pool_trace";
+
 // The file saves configuration for partitioning node among logic streams
 static const char* const kNodePartitionConfigFile = "session.node_partition_config_file";
 
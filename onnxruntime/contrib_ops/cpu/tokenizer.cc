@@ -8,6 +8,8 @@
 #include "core/common/utf8_util.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/text/string_batching.h"
 #include "re2/re2.h"
 
 #ifdef _MSC_VER
@@ -15,6 +17,8 @@
 #define ORT_PMR_ALLOCATOR_SUPPORTED
 #endif
 
+#include <algorithm>
+#include <memory>
 #include <optional>
 #include <type_traits>
 #include <vector>
@@ -38,19 +42,27 @@ class Tokenizer final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  struct TokenizedRows;
+  using TokenizeRowsFn = Status (Tokenizer::*)(gsl::span<const std::string> input_span,
+                                               std::unique_ptr<TokenizedRows>& result) const;
+
   Status EstimateNumberOfTokens(gsl::span<const std::string> input_span,
                                 size_t& max_tokens_per_row,
                                 size_t& total_tokens_estimate) const;
 
-  Status CharTokenize(OpKernelContext* context, size_t N, size_t C,
-                      gsl::span<const int64_t> input_dims) const;
+  Status CharTokenize(OpKernelContext* context, gsl::span<const int64_t> input_dims) const;
+
+  Status SeparatorExpressionTokenizer(gsl::span<const std::string> input_span,
+                                      std::unique_ptr<TokenizedRows>& result) const;
 
-  Status SeparatorExpressionTokenizer(OpKernelContext* context, size_t N, size_t C,
-                                      gsl::span<const int64_t> input_dims) const;
+  Status TokenExpression(gsl::span<const std::string> input_span,
+                         std::unique_ptr<TokenizedRows>& result) const;
 
-  Status TokenExpression(OpKernelContext* ctx,
-                         size_t N, size_t C,
-                         gsl::span<const int64_t> input_dims) const;
+  Status TokenizeInParallel(OpKernelContext* context, gsl::span<const int64_t> input_dims,
+                            TokenizeRowsFn tokenize_rows) const;
+
+  std::string* CreateOutput(OpKernelContext* context, gsl::span<const int64_t> input_dims,
+                            size_t& max_tokens) const;
 
   void OutputData(gsl::span<const SlicesVector> rows,
                   size_t max_tokens, size_t max_output_index, std::string* output_data) const;
@@ -79,6 +91,7 @@ constexpr char kEndMarker = 0x3;
 }  // namespace tokenizer_details
 
 using namespace tokenizer_details;
+using namespace string_batching;
 
 Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
   int64_t mark = 0;
@@ -159,36 +172,16 @@ Status Tokenizer::EstimateNumberOfTokens(gsl::span<const std::string> input_span
   return Status::OK();
 }
 
-Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
-                               gsl::span<const int64_t> input_dims) const {
-  // With char tokenzation we get as many tokens as the number of
-  // utf8 characters in the string. So for every string we calculate its character(utf8) length
-  // add padding and add start/end test separators if necessary
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    size_t tokens = 0;  // length in utf8 chars
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       tokens)) {
-      // Please do not include the input text in the error message as it could
-      // be deemed as a compliance violation by teams using this operator
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input string contains invalid utf8 chars:", s);
-    }
-    max_tokens = std::max(max_tokens, tokens);
-    ++curr_input;
-  }
-
+std::string* Tokenizer::CreateOutput(OpKernelContext* ctx, gsl::span<const int64_t> input_dims,
+                                     size_t& max_tokens) const {
   TensorShapeVector output_dims(input_dims.begin(), input_dims.end());
-  // Check if we have no output due to apparently empty strings input.
+  // Check if we have no output due to either empty input
+  // or everything is a separator
   if (max_tokens == 0) {
     output_dims.push_back(0);
     TensorShape output_shape(output_dims);
     ctx->Output(0, output_shape);
-    return Status::OK();
+    return nullptr;
   }
 
   if (mark_) {
@@ -198,40 +191,81 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
   output_dims.push_back(max_tokens);
   TensorShape output_shape(output_dims);
   auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->MutableData<std::string>();
-  size_t output_index = 0;
-  curr_input = input_data;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    if (mark_) {
-      output_data[output_index].assign(&kStartMarker, 1);
-      ++output_index;
-    }
-    size_t tokens = 0;
-    const size_t str_len = s.size();
-    for (size_t token_idx = 0; token_idx < str_len;) {
-      size_t tlen = 0;
-      [[maybe_unused]] bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
-      assert(result);
-      assert(token_idx + tlen <= str_len);
-      output_data[output_index] = s.substr(token_idx, tlen);
-      ++output_index;
-      token_idx += tlen;
-      ++tokens;
-    }
-    if (mark_) {
-      output_data[output_index].assign(&kEndMarker, 1);
-      ++output_index;
-    }
-    // Padding strings
-    assert(tokens + (static_cast<size_t>(mark_) * 2) <= max_tokens);
-    const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - tokens;
-    for (size_t p = 0; p < pads; ++p) {
-      output_data[output_index] = pad_value_;
-      ++output_index;
+  return output_tensor->MutableData<std::string>();
+}
+
+Status Tokenizer::CharTokenize(OpKernelContext* ctx, gsl::span<const int64_t> input_dims) const {
+  // With char tokenzation we get as many tokens as the number of
+  // utf8 characters in the string. So for every string we calculate its character(utf8) length
+  // add padding and add start/end test separators if necessary
+  auto X = ctx->Input<Tensor>(0);
+  const auto input_span = X->DataAsSpan<std::string>();
+  const auto input_count = static_cast<ptrdiff_t>(input_span.size());
+
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const ptrdiff_t num_batches = ComputeNumBatches(tp, input_span);
+  InlinedVector<Status> batch_status(static_cast<size_t>(num_batches));
+  InlinedVector<size_t> batch_max_tokens(static_cast<size_t>(num_batches), 0);
+
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_batches, [&](ptrdiff_t batch_num) {
+    auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_batches, input_count);
+    size_t& max_tokens = batch_max_tokens[static_cast<size_t>(batch_num)];
+    for (auto i = work.start; i < work.end; ++i) {
+      const auto& s = input_span[static_cast<size_t>(i)];
+      size_t tokens = 0;  // length in utf8 chars
+      if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
+                         tokens)) {
+        // Please do not include the input text in the error message as it could
+        // be deemed as a compliance violation by teams using this operator
+        batch_status[static_cast<size_t>(batch_num)] =
+            ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input string contains invalid utf8 chars:", s);
+        return;
+      }
+      max_tokens = std::max(max_tokens, tokens);
     }
-    ++curr_input;
+  });
+  ORT_RETURN_IF_ERROR(FirstError(batch_status));
+
+  size_t max_tokens = *std::max_element(batch_max_tokens.begin(), batch_max_tokens.end());
+  auto const output_data = CreateOutput(ctx, input_dims, max_tokens);
+  if (output_data == nullptr) {
+    return Status::OK();
   }
+
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_batches, [&](ptrdiff_t batch_num) {
+    auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_batches, input_count);
+    for (auto i = work.start; i < work.end; ++i) {
+      const auto& s = input_span[static_cast<size_t>(i)];
+      size_t output_index = static_cast<size_t>(i) * max_tokens;
+      if (mark_) {
+        output_data[output_index].assign(&kStartMarker, 1);
+        ++output_index;
+      }
+      size_t tokens = 0;
+      const size_t str_len = s.size();
+      for (size_t token_idx = 0; token_idx < str_len;) {
+        size_t tlen = 0;
+        [[maybe_unused]] bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
+        assert(result);
+        assert(token_idx + tlen <= str_len);
+        output_data[output_index].assign(s, token_idx, tlen);
+        ++output_index;
+        token_idx += tlen;
+        ++tokens;
+      }
+      if (mark_) {
+        output_data[output_index].assign(&kEndMarker, 1);
+        ++output_index;
+      }
+      // Padding strings
+      assert(tokens + (static_cast<size_t>(mark_) * 2) <= max_tokens);
+      const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - tokens;
+      for (size_t p = 0; p < pads; ++p) {
+        output_data[output_index] = pad_value_;
+        ++output_index;
+      }
+    }
+  });
   return Status::OK();
 }
 
@@ -316,6 +350,17 @@ class MemoryAllocator {
 #endif
 }  // namespace
 
+// Tokens of a contiguous range of input strings. Every parallel batch owns one,
+// so the allocator is never shared between threads. The rows are declared after
+// the allocator so they are destroyed first.
+struct Tokenizer::TokenizedRows {
+  explicit TokenizedRows(size_t num_of_slices) : allocator(num_of_slices) {}
+
+  MemoryAllocator allocator;
+  std::vector<SlicesVector> rows;
+  size_t max_tokens = 0;
+};
+
 void Tokenizer::OutputData(gsl::span<const SlicesVector> rows,
                            size_t max_tokens, [[maybe_unused]] size_t max_output_index, std::string* output_data) const {
   size_t output_index = 0;
@@ -340,13 +385,47 @@ void Tokenizer::OutputData(gsl::span<const SlicesVector> rows,
   }
 }
 
-Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
-                                               size_t N, size_t C,
-                                               gsl::span<const int64_t> input_dims) const {
-  using namespace re2;
-
+Status Tokenizer::TokenizeInParallel(OpKernelContext* ctx, gsl::span<const int64_t> input_dims,
+                                     TokenizeRowsFn tokenize_rows) const {
   auto X = ctx->Input<Tensor>(0);
   const auto input_span = X->DataAsSpan<std::string>();
+  const auto input_count = static_cast<ptrdiff_t>(input_span.size());
+
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const ptrdiff_t num_batches = ComputeNumBatches(tp, input_span);
+  std::vector<std::unique_ptr<TokenizedRows>> batches(static_cast<size_t>(num_batches));
+  InlinedVector<Status> batch_status(static_cast<size_t>(num_batches));
+
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_batches, [&](ptrdiff_t batch_num) {
+    auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_batches, input_count);
+    auto batch_input = input_span.subspan(static_cast<size_t>(work.start), static_cast<size_t>(work.end - work.start));
+    batch_status[static_cast<size_t>(batch_num)] = (this->*tokenize_rows)(batch_input, batches[static_cast<size_t>(batch_num)]);
+  });
+  ORT_RETURN_IF_ERROR(FirstError(batch_status));
+
+  size_t max_tokens = 0;
+  for (const auto& batch : batches) {
+    max_tokens = std::max(max_tokens, batch->max_tokens);
+  }
+
+  auto const output_data = CreateOutput(ctx, input_dims, max_tokens);
+  if (output_data == nullptr) {
+    return Status::OK();
+  }
+
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_batches, [&](ptrdiff_t batch_num) {
+    auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_batches, input_count);
+    const auto& batch = *batches[static_cast<size_t>(batch_num)];
+    const size_t output_offset = static_cast<size_t>(work.start) * max_tokens;
+    OutputData(batch.rows, max_tokens, batch.rows.size() * max_tokens, output_data + output_offset);
+  });
+
+  return Status::OK();
+}
+
+Status Tokenizer::SeparatorExpressionTokenizer(gsl::span<const std::string> input_span,
+                                               std::unique_ptr<TokenizedRows>& result) const {
+  using namespace re2;
 
   // Let's estimate maximum number of tokens
   // It is hard to estimate the number of separate characters that would not appear in the
@@ -358,13 +437,10 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
   total_tokens_estimate += max_tokens_per_row;
 
   // Pre-allocate memory for all tokens (StringPieces)
-  MemoryAllocator allocator(total_tokens_estimate);
-
-  // Make sure the vectors below are destroyed before the allocator
-  const size_t vector_num = SafeInt<size_t>(N) * C;
-
-  std::vector<SlicesVector> rows;
-  rows.reserve(vector_num);
+  result = std::make_unique<TokenizedRows>(total_tokens_estimate);
+  auto& allocator = result->allocator;
+  auto& rows = result->rows;
+  rows.reserve(input_span.size());
 
   // Re-use the same vector for each tokenization round
   SlicesVector tokens = allocator.CreateVectorWithAllocator();
@@ -376,7 +452,6 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
 
   // Scan all strings and attempt to find separators in them
   // collect all the output tokens here
-  size_t max_tokens = 0;
   for (const auto& s : input_span) {
     size_t utf8_chars = 0;  // length in utf8 chars
     if (!utf8_len(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
@@ -451,58 +526,26 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
       tokens.clear();
       break;
     }  // separators_
-    max_tokens = std::max(max_tokens, row.size());
-  }
-
-  TensorShapeVector output_dims(input_dims.begin(), input_dims.end());
-  // Check if we have no output due to either empty input
-  // or everything is a separator
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
-
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
+    result->max_tokens = std::max(result->max_tokens, row.size());
   }
 
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->MutableData<std::string>();
-
-  OutputData(rows, max_tokens, narrow<size_t>(output_shape.Size()), output_data);
-
   return Status::OK();
 }
 
-Status Tokenizer::TokenExpression(OpKernelContext* ctx,
-                                  size_t N, size_t C,
-                                  gsl::span<const int64_t> input_dims) const {
+Status Tokenizer::TokenExpression(gsl::span<const std::string> input_span,
+                                  std::unique_ptr<TokenizedRows>& result) const {
   using namespace re2;
 
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  const auto input_span = X->DataAsSpan<std::string>();
-
   // Let's estimate maximum number of tokens
   size_t total_tokens_estimate = 0;
   size_t max_tokens_per_row = 0;
   ORT_RETURN_IF_ERROR(EstimateNumberOfTokens(input_span, max_tokens_per_row, total_tokens_estimate));
 
   // Pre-allocate memory for all tokens (StringPieces)
-  MemoryAllocator allocator(total_tokens_estimate);
-
-  // Make sure the vectors below are destroyed before the allocator
-  const size_t vector_num = SafeInt<size_t>(N) * C;
-
-  // We use std::vector in this case, because InlinedVector::clear() is incompatible
-  // with std::vector. It also deallocates memory, which is not what we want.
-  std::vector<SlicesVector> rows;
-  rows.reserve(vector_num);
+  result = std::make_unique<TokenizedRows>(total_tokens_estimate);
+  auto& allocator = result->allocator;
+  auto& rows = result->rows;
+  rows.reserve(input_span.size());
 
   // We do not constraint the search to match
   // on the beginning or end of the string
@@ -550,32 +593,9 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
         }
       } while (match);
     }
-    max_tokens = std::max(max_tokens, row.size());
+    result->max_tokens = std::max(result->max_tokens, row.size());
   }
 
-  // Check for empty output
-  TensorShapeVector output_dims(input_dims.begin(), input_dims.end());
-  // Check if we have no output due to either empty input
-  // everything is a separator
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
-
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
-  }
-
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->MutableData<std::string>();
-
-  OutputData(rows, max_tokens, narrow<size_t>(output_shape.Size()), output_data);
-
   return Status::OK();
 }
 
@@ -590,15 +610,7 @@ Status Tokenizer::Compute(OpKernelContext* ctx) const {
 
   auto& input_shape = X->Shape();
   auto input_dims = input_shape.GetDims();
-  size_t N = 0;
-  size_t C = 0;
-  if (input_dims.size() == 1) {
-    N = 1;
-    C = narrow<size_t>(input_dims[0]);
-  } else if (input_dims.size() == 2) {
-    N = narrow<size_t>(input_dims[0]);
-    C = narrow<size_t>(input_dims[1]);
-  } else {
+  if (input_dims.size() != 1 && input_dims.size() != 2) {
     return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                   "Input dimensions are either [C] or [N][C] allowed");
   }
@@ -617,14 +629,15 @@ Status Tokenizer::Compute(OpKernelContext* ctx) const {
     return s;
   }
 
+  // Rows are tokenized in parallel batches
   if (char_tokenezation_) {
-    s = CharTokenize(ctx, N, C, input_dims);
+    s = CharTokenize(ctx, input_dims);
   } else {
     if (!separators_.empty()) {
-      s = SeparatorExpressionTokenizer(ctx, N, C, input_dims);
+      s = TokenizeInParallel(ctx, input_dims, &Tokenizer::SeparatorExpressionTokenizer);
     } else {
       assert(regex_ != nullptr);
-      s = TokenExpression(ctx, N, C, input_dims);
+      s = TokenizeInParallel(ctx, input_dims, &Tokenizer::TokenExpression);
     }
   }
   return s;
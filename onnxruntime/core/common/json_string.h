@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "nlohmann/json.hpp"
+
+namespace onnxruntime {
+namespace utils {
+
+/**
+ * Quotes and escapes a string, e.g. a node or tensor name, for a JSON report written by hand.
+ * Invalid UTF-8 is replaced rather than failing the report.
+ */
+inline std::string JsonString(const std::string& value) {
+  return nlohmann::json(value).dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+}  // namespace utils
+}  // namespace onnxruntime
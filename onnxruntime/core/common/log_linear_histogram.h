@@ -0,0 +1,143 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace onnxruntime {
+
+/**
+ * Histogram of non-negative values with a bounded relative error, in the style of HdrHistogram.
+ * Values below 2^SubBucketBits get a bucket each. Every larger power of two is split linearly into 2^SubBucketBits
+ * buckets, so a bucket is at most 2^-SubBucketBits of its values wide. Values of 2^MaxExponent and above share the
+ * last bucket. Header only so that tools linking only the shared library can use it. Not thread safe.
+ */
+template <int SubBucketBits, int MaxExponent>
+class LogLinearHistogram {
+  static_assert(0 < SubBucketBits && SubBucketBits < MaxExponent && MaxExponent < 64, "invalid bucket layout");
+
+ public:
+  static constexpr int kSubBucketBits = SubBucketBits;
+  static constexpr int kMaxExponent = MaxExponent;
+  static constexpr size_t kNumBuckets = (size_t{kMaxExponent - kSubBucketBits + 1} << kSubBucketBits) + 1;
+
+  LogLinearHistogram() : buckets_(kNumBuckets) {}
+
+  // From the counts of each bucket, the sum and the max of values recorded elsewhere, e.g. by lock-free counters.
+  LogLinearHistogram(std::vector<uint64_t> buckets, uint64_t sum, uint64_t max)
+      : buckets_(std::move(buckets)), sum_(sum), max_(max) {
+    buckets_.resize(kNumBuckets);
+    for (uint64_t bucket_count : buckets_) {
+      count_ += bucket_count;
+    }
+  }
+
+  void Record(uint64_t value) noexcept {
+    ++buckets_[BucketIndex(value)];
+    ++count_;
+    sum_ += value;
+    max_ = std::max(max_, value);
+  }
+
+  void Merge(const LogLinearHistogram& other) {
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+      buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+  }
+
+  void Reset() {
+    std::fill(buckets_.begin(), buckets_.end(), uint64_t{0});
+    count_ = 0;
+    sum_ = 0;
+    max_ = 0;
+  }
+
+  uint64_t Count() const { return count_; }
+  uint64_t Sum() const { return sum_; }
+  uint64_t Max() const { return max_; }
+  double Mean() const { return count_ > 0 ? static_cast<double>(sum_) / count_ : 0.0; }
+
+  // Estimate of the value at or below which the given fraction of the values are, e.g. 0.99 for P99: the middle of
+  // the bucket of that rank, bounded by the largest value recorded. 0 if nothing was recorded.
+  uint64_t ValueAtPercentile(double fraction) const {
+    if (count_ == 0) {
+      return 0;
+    }
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * count_ + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+      seen += buckets_[i];
+      if (seen >= rank) {
+        const uint64_t lower = BucketLowerBound(i);
+        const uint64_t upper = i + 1 < kNumBuckets ? BucketLowerBound(i + 1) : lower;
+        return std::min(lower + (upper - lower) / 2, std::max(max_, lower));
+      }
+    }
+    return max_;
+  }
+
+  static size_t BucketIndex(uint64_t value) noexcept {
+    constexpr uint64_t num_sub_buckets = uint64_t{1} << kSubBucketBits;
+    if (value < num_sub_buckets) {
+      return static_cast<size_t>(value);
+    }
+    const int exponent = Log2Floor(value);
+    if (exponent >= kMaxExponent) {
+      return kNumBuckets - 1;
+    }
+    const auto sub_bucket = static_cast<size_t>((value >> (exponent - kSubBucketBits)) & (num_sub_buckets - 1));
+    return (static_cast<size_t>(exponent - kSubBucketBits + 1) << kSubBucketBits) + sub_bucket;
+  }
+
+  // the smallest value in the bucket
+  static uint64_t BucketLowerBound(size_t index) noexcept {
+    constexpr size_t num_sub_buckets = size_t{1} << kSubBucketBits;
+    if (index < num_sub_buckets) {
+      return index;
+    }
+    if (index >= kNumBuckets - 1) {
+      return uint64_t{1} << kMaxExponent;
+    }
+    const int exponent = static_cast<int>(index >> kSubBucketBits) + kSubBucketBits - 1;
+    const uint64_t sub_bucket = index & (num_sub_buckets - 1);
+    return (num_sub_buckets + sub_bucket) << (exponent - kSubBucketBits);
+  }
+
+ private:
+  // floor(log2(n)) for n > 0
+  static int Log2Floor(uint64_t n) noexcept {
+#if defined(__GNUC__)
+    return 63 ^ __builtin_clzll(n);
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanReverse64(&index, n);
+    return static_cast<int>(index);
+#else
+    int r = -1;
+    while (n > 0) {
+      ++r;
+      n >>= 1;
+    }
+    return r;
+#endif
+  }
+
+  std::vector<uint64_t> buckets_;
+  uint64_t count_{0};
+  uint64_t sum_{0};
+  uint64_t max_{0};
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,216 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/perf_event_profiler.h"
+
+#if defined(__linux__)
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+#include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+constexpr uint64_t kCounterConfigs[] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                        PERF_COUNT_HW_CACHE_MISSES};
+constexpr uint64_t kCacheLineSize = 64;
+
+int OpenCounter(int tid, uint64_t config, int group_fd) {
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // user space only, which is allowed with the default perf_event_paranoid setting
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, group_fd, PERF_FLAG_FD_CLOEXEC));
+}
+}  // namespace
+
+PerfEventProfiler::~PerfEventProfiler() {
+  CloseCounters();
+}
+
+void PerfEventProfiler::CloseCounters() {
+  for (int fd : member_fds_) {
+    close(fd);
+  }
+  for (const auto& [tid, fd] : group_fds_) {
+    close(fd);
+  }
+  member_fds_.clear();
+  group_fds_.clear();
+}
+
+bool PerfEventProfiler::StartProfiling(TimePoint) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  CloseCounters();
+  started_.clear();
+  stopped_.clear();
+
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task", error)) {
+    int tid = 0;
+    if (!TryParseStringWithClassicLocale(entry.path().filename().string(), tid)) {
+      continue;
+    }
+
+    const int group_fd = OpenCounter(tid, kCounterConfigs[0], -1);
+    if (group_fd < 0) {
+      // the thread may have exited. if the first thread fails, counters are not available at all.
+      if (group_fds_.empty()) {
+        LOGS_DEFAULT(WARNING) << "Hardware performance counters are not available: " << strerror(errno)
+                              << ". Check /proc/sys/kernel/perf_event_paranoid.";
+        return false;
+      }
+      continue;
+    }
+
+    bool opened = true;
+    const size_t num_member_fds = member_fds_.size();
+    for (size_t i = 1; i < kNumCounters && opened; ++i) {
+      const int fd = OpenCounter(tid, kCounterConfigs[i], group_fd);
+      if (fd < 0) {
+        opened = false;
+      } else {
+        member_fds_.push_back(fd);
+      }
+    }
+    if (!opened) {
+      LOGS_DEFAULT(WARNING) << "Failed to open the hardware performance counters of thread " << tid << ": "
+                            << strerror(errno);
+      for (size_t i = num_member_fds; i < member_fds_.size(); ++i) {
+        close(member_fds_[i]);
+      }
+      member_fds_.resize(num_member_fds);
+      close(group_fd);
+      continue;
+    }
+
+    group_fds_.emplace_back(tid, group_fd);
+  }
+
+  return !group_fds_.empty();
+}
+
+std::vector<PerfEventProfiler::Reading> PerfEventProfiler::ReadCounters() const {
+  std::vector<Reading> readings(group_fds_.size());
+  for (size_t i = 0; i < group_fds_.size(); ++i) {
+    // layout for PERF_FORMAT_GROUP with the times: nr, time_enabled, time_running, values[nr]
+    uint64_t data[3 + kNumCounters] = {};
+    if (read(group_fds_[i].second, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+      // the thread exited. its counts stay at zero.
+      memset(&readings[i], 0, sizeof(Reading));
+      continue;
+    }
+    readings[i].time_enabled = data[1];
+    readings[i].time_running = data[2];
+    for (size_t c = 0; c < kNumCounters; ++c) {
+      readings[i].values[c] = data[3 + c];
+    }
+  }
+  return readings;
+}
+
+void PerfEventProfiler::Start(uint64_t id) {
+  if (group_fds_.empty()) {
+    return;
+  }
+  auto readings = ReadCounters();
+  const int tid = static_cast<int>(logging::GetThreadId());
+  std::lock_guard<OrtMutex> lock(mutex_);
+  started_[{tid, id}] = std::move(readings);
+}
+
+void PerfEventProfiler::Stop(uint64_t id) {
+  if (group_fds_.empty()) {
+    return;
+  }
+  const auto end_readings = ReadCounters();
+  const int tid = static_cast<int>(logging::GetThreadId());
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = started_.find({tid, id});
+  if (it == started_.end()) {
+    return;
+  }
+
+  Sample sample{};
+  const auto& start_readings = it->second;
+  for (size_t i = 0; i < end_readings.size(); ++i) {
+    const Reading& start = start_readings[i];
+    const Reading& end = end_readings[i];
+    if (end.time_enabled < start.time_enabled) {
+      continue;
+    }
+    // scale for the time the counters were not scheduled on the PMU when counters are multiplexed
+    const uint64_t enabled = end.time_enabled - start.time_enabled;
+    const uint64_t running = end.time_running - start.time_running;
+    const double scale = running > 0 && running < enabled ? static_cast<double>(enabled) / running : 1.0;
+    for (size_t c = 0; c < kNumCounters; ++c) {
+      const uint64_t delta = end.values[c] >= start.values[c] ? end.values[c] - start.values[c] : 0;
+      sample.values[c] += static_cast<uint64_t>(delta * scale);
+      if (c == 0 && delta > 0) {
+        sample.thread_cycles.emplace_back(group_fds_[i].first, static_cast<uint64_t>(delta * scale));
+      }
+    }
+  }
+
+  stopped_[{tid, id}].push_back(std::move(sample));
+  started_.erase(it);
+}
+
+void PerfEventProfiler::EndProfiling(TimePoint, Events& events) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  for (auto& event : events) {
+    auto it = stopped_.find({event.tid, static_cast<uint64_t>(event.ts)});
+    if (it == stopped_.end() || it->second.empty()) {
+      continue;
+    }
+    const Sample sample = std::move(it->second.front());
+    it->second.pop_front();
+
+    const uint64_t cycles = sample.values[0];
+    const uint64_t instructions = sample.values[1];
+    const uint64_t llc_miss_bytes = sample.values[2] * kCacheLineSize;
+    event.args["hw_cycles"] = std::to_string(cycles);
+    event.args["hw_instructions"] = std::to_string(instructions);
+    event.args["hw_llc_misses"] = std::to_string(sample.values[2]);
+    event.args["hw_ipc"] = std::to_string(cycles > 0 ? static_cast<double>(instructions) / cycles : 0.0);
+    event.args["hw_llc_miss_bytes"] = std::to_string(llc_miss_bytes);
+    // bytes per nanosecond is GB/s
+    event.args["hw_llc_miss_gbps"] =
+        std::to_string(event.dur > 0 ? static_cast<double>(llc_miss_bytes) / (event.dur * 1000.0) : 0.0);
+
+    std::ostringstream thread_cycles;
+    thread_cycles << "{";
+    for (size_t i = 0; i < sample.thread_cycles.size(); ++i) {
+      thread_cycles << (i > 0 ? ", " : "") << "\"" << sample.thread_cycles[i].first
+                    << "\": " << sample.thread_cycles[i].second;
+    }
+    thread_cycles << "}";
+    event.args["hw_thread_cycles"] = thread_cycles.str();
+  }
+
+  started_.clear();
+  stopped_.clear();
+  CloseCounters();
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
+
+#endif  // defined(__linux__)
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/profiler_common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+#if defined(__linux__)
+
+/**
+ * Profiler plug-in that attributes hardware performance counters to the profiled events, using Linux perf_event.
+ *
+ * When profiling starts a counter group is opened for every thread of the process, counting user space cycles,
+ * instructions and last level cache misses. The groups are read when an event starts and when it ends, and the
+ * difference summed over all threads is added to the event's args together with derived metrics:
+ * the IPC, the bytes brought in by LLC misses (64 bytes each), and the resulting bandwidth.
+ * The cycles per thread are added as well, so the work done by the intra-op thread pool can be matched with its
+ * thread_scheduling_stats.
+ *
+ * Counts include all the threads of the process, so concurrent Run calls are attributed to each other's events.
+ * Threads started after profiling starts are not counted.
+ */
+class PerfEventProfiler final : public EpProfiler {
+ public:
+  PerfEventProfiler() = default;
+  ~PerfEventProfiler() override;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PerfEventProfiler);
+
+  bool StartProfiling(TimePoint profiling_start_time) override;
+  void EndProfiling(TimePoint start_time, Events& events) override;
+  void Start(uint64_t id) override;
+  void Stop(uint64_t id) override;
+
+ private:
+  static constexpr size_t kNumCounters = 3;  // cycles, instructions, LLC misses
+
+  // values of the counters of a thread, with the times used to scale them if the counters were multiplexed
+  struct Reading {
+    uint64_t values[kNumCounters];
+    uint64_t time_enabled;
+    uint64_t time_running;
+  };
+
+  struct Sample {
+    uint64_t values[kNumCounters];
+    // cycles of each thread with a non-zero count, by thread id
+    InlinedVector<std::pair<int, uint64_t>> thread_cycles;
+  };
+
+  // readings of all the counter groups, in the order of group_fds_
+  std::vector<Reading> ReadCounters() const;
+  void CloseCounters();
+
+  // thread id and counter group leader of every counted thread
+  std::vector<std::pair<int, int>> group_fds_;
+  // file descriptors of the other counters of the groups
+  std::vector<int> member_fds_;
+
+  OrtMutex mutex_;
+  // keyed on the id of the thread recording the event and the id passed to Start(), which is the start time of the
+  // event. events of a thread starting in the same microsecond are matched in order.
+  std::map<std::pair<int, uint64_t>, std::vector<Reading>> started_;
+  std::map<std::pair<int, uint64_t>, std::deque<Sample>> stopped_;
+};
+
+#else
+
+class PerfEventProfiler final : public EpProfiler {
+ public:
+  PerfEventProfiler() = default;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PerfEventProfiler);
+  bool StartProfiling(TimePoint) override { return false; }
+  void EndProfiling(TimePoint, Events&) override {}
+};
+
+#endif
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -102,6 +102,35 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
   }
 }
 
+void Profiler::RecordThreadEvent(EventCategory category,
+                                 const std::string& event_name,
+                                 const TimePoint& start_time,
+                                 const std::string& thread_name,
+                                 const std::initializer_list<std::pair<std::string, std::string>>& event_args) {
+  long long dur = TimeDiffMicroSeconds(start_time);
+  long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
+
+  const int tid = static_cast<int>(logging::GetThreadId());
+  EventRecord event(category, logging::GetProcessId(), tid, event_name, ts, dur,
+                    {event_args.begin(), event_args.end()});
+  if (profile_with_logger_) {
+    custom_logger_->SendProfileEvent(event);
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (!thread_name.empty()) {
+    thread_names_.try_emplace(tid, thread_name);
+  }
+  if (events_.size() < max_num_events_) {
+    events_.emplace_back(std::move(event));
+  } else if (session_logger_ && !max_events_reached) {
+    LOGS(*session_logger_, ERROR)
+        << "Maximum number of events reached, could not record profile event.";
+    max_events_reached = true;
+  }
+}
+
 std::string Profiler::EndProfiling() {
   if (!enabled_) {
     return std::string();
@@ -122,6 +151,17 @@ std::string Profiler::EndProfiling() {
     ep_profiler->EndProfiling(profiling_start_time_, events_);
   }
 
+  // name the lanes of the thread pool workers so that the trace viewer shows them as such
+  const int pid = logging::GetProcessId();
+  size_t num_thread_names = 0;
+  for (const auto& thread_name : thread_names_) {
+    profile_stream_ << R"({"ph" : "M", "name" : "thread_name", "pid" :)" << pid
+                    << ", \"tid\" :" << thread_name.first
+                    << R"(, "args" : {"name" : ")" << thread_name.second << "\"}}";
+    ++num_thread_names;
+    profile_stream_ << (num_thread_names == thread_names_.size() && events_.empty() ? "\n" : ",\n");
+  }
+
   for (size_t i = 0; i < events_.size(); ++i) {
     auto& rec = events_[i];
     profile_stream_ << R"({"cat" : ")" << event_category_names_[rec.cat] << "\",";
@@ -157,5 +197,22 @@ std::string Profiler::EndProfiling() {
   return profile_stream_file_;
 }
 
+namespace {
+thread_local const TraceScope* current_trace_scope = nullptr;
+}  // namespace
+
+TraceScope::TraceScope(Profiler& profiler, const std::string& parent)
+    : profiler_(profiler), parent_(parent), previous_(current_trace_scope) {
+  current_trace_scope = this;
+}
+
+TraceScope::~TraceScope() {
+  current_trace_scope = previous_;
+}
+
+const TraceScope* TraceScope::Current() {
+  return current_trace_scope;
+}
+
 }  // namespace profiling
 }  // namespace onnxruntime
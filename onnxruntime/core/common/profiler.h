@@ -7,9 +7,12 @@
 #include <fstream>
 #include <initializer_list>
 #include <iostream>
+#include <memory>
 #include <tuple>
+#include <unordered_map>
 
 #include "core/common/profiler_common.h"
+#include "core/common/sampling_profiler.h"
 #include "core/common/logging/logging.h"
 #include "core/platform/ort_mutex.h"
 
@@ -110,6 +113,43 @@ class Profiler {
     global_max_num_events_.store(new_max_num_events);
   }
 
+  /*
+  Enable the always-on sampling profiler of kernel latencies. It is independent of StartProfiling/EndProfiling.
+  */
+  void EnableSampling(size_t ring_buffer_size, uint32_t sample_interval) {
+    sampling_profiler_ = std::make_unique<SamplingProfiler>(ring_buffer_size, sample_interval);
+  }
+
+  /*
+  Return the sampling profiler, or nullptr if it is not enabled.
+  */
+  SamplingProfiler* GetSamplingProfiler() const {
+    return sampling_profiler_.get();
+  }
+
+  /*
+  Enable the trace of thread pool work. The ParallelFor work items of a kernel, the arena extensions it triggers and
+  the inter-op stream hand-offs are recorded on the lanes of the threads that run them. It only takes effect while
+  profiling is started.
+  */
+  void EnableThreadPoolTrace() {
+    thread_pool_trace_ = true;
+  }
+
+  bool IsThreadPoolTraceEnabled() const {
+    return enabled_ && thread_pool_trace_;
+  }
+
+  /*
+  Record an event of the calling thread. It may be called from thread pool workers, so unlike EndTimeAndRecordEvent
+  it does not notify the EP profilers. A non-empty thread_name names the lane of the thread in the trace.
+  */
+  void RecordThreadEvent(EventCategory category,
+                         const std::string& event_name,
+                         const TimePoint& start_time,
+                         const std::string& thread_name,
+                         const std::initializer_list<std::pair<std::string, std::string>>& event_args = {});
+
   void AddEpProfilers(std::unique_ptr<EpProfiler> ep_profiler) {
     if (ep_profiler) {
       ep_profilers_.push_back(std::move(ep_profiler));
@@ -149,6 +189,9 @@ class Profiler {
   Events events_;
   bool max_events_reached{false};
   bool profile_with_logger_{false};
+  bool thread_pool_trace_{false};
+  // names of the lanes of the threads that recorded thread events, written as "thread_name" metadata events
+  std::unordered_map<int, std::string> thread_names_;
   const size_t max_num_events_{global_max_num_events_.load()};
 
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
@@ -156,6 +199,31 @@ class Profiler {
 #endif
 
   std::vector<std::unique_ptr<EpProfiler>> ep_profilers_;
+  std::unique_ptr<SamplingProfiler> sampling_profiler_;
+};
+
+/**
+ * Marks the work of the calling thread as part of a parent event, e.g. a kernel, while the thread pool trace is
+ * enabled. The work the thread hands to a thread pool and the arena extensions it triggers are recorded under the
+ * name of the innermost scope of the thread. The parent name is referenced, so it must outlive the scope.
+ */
+class TraceScope {
+ public:
+  TraceScope(Profiler& profiler, const std::string& parent);
+  ~TraceScope();
+
+  // The innermost scope of the calling thread, or nullptr.
+  static const TraceScope* Current();
+
+  Profiler& GetProfiler() const { return profiler_; }
+  const std::string& Parent() const { return parent_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(TraceScope);
+
+  Profiler& profiler_;
+  const std::string& parent_;
+  const TraceScope* previous_;
 };
 
 }  // namespace profiling
@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/sampling_profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/json_string.h"
+#include "core/common/logging/logging.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+std::atomic<uint64_t> next_profiler_id{1};
+
+void WriteStats(std::ostream& out, const SamplingProfiler::LatencyHistogram::Snapshot& stats) {
+  out << "\"count\": " << stats.Count()
+      << ", \"mean_us\": " << stats.Mean() / 1000.0
+      << ", \"p50_us\": " << stats.ValueAtPercentile(0.5) / 1000.0
+      << ", \"p90_us\": " << stats.ValueAtPercentile(0.9) / 1000.0
+      << ", \"p99_us\": " << stats.ValueAtPercentile(0.99) / 1000.0
+      << ", \"max_us\": " << stats.Max() / 1000.0;
+}
+}  // namespace
+
+void SamplingProfiler::LatencyHistogram::Record(uint64_t duration_ns) noexcept {
+  sum_ns_.fetch_add(duration_ns, std::memory_order_relaxed);
+  buckets_[Snapshot::BucketIndex(duration_ns)].fetch_add(1, std::memory_order_relaxed);
+
+  uint64_t max_ns = max_ns_.load(std::memory_order_relaxed);
+  while (duration_ns > max_ns &&
+         !max_ns_.compare_exchange_weak(max_ns, duration_ns, std::memory_order_relaxed)) {
+  }
+}
+
+SamplingProfiler::LatencyHistogram::Snapshot SamplingProfiler::LatencyHistogram::GetSnapshot() const {
+  // the counters are read one by one while executions may be recorded, so they can be off by the executions in flight
+  std::vector<uint64_t> buckets(kNumBuckets);
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+  }
+  return Snapshot(std::move(buckets), sum_ns_.load(std::memory_order_relaxed), max_ns_.load(std::memory_order_relaxed));
+}
+
+SamplingProfiler::SamplingProfiler(size_t ring_buffer_size, uint32_t sample_interval)
+    : start_time_(std::chrono::high_resolution_clock::now()),
+      sample_interval_(sample_interval),
+      id_(next_profiler_id.fetch_add(1, std::memory_order_relaxed)),
+      ring_buffer_size_(sample_interval > 0 ? ring_buffer_size : 0) {
+  if (ring_buffer_size_ > 0) {
+    ring_buffer_ = std::make_unique<SampledEvent[]>(ring_buffer_size_);
+  }
+}
+
+uint32_t& SamplingProfiler::ExecutionsSinceSample() noexcept {
+  // the sessions run on a thread each have their own count. the count of the last profiler used is cached, as a
+  // thread usually runs a single session at a time. the elements of an unordered_map don't move on insertion.
+  // the few bytes of the count of a destroyed profiler are kept until the thread exits.
+  thread_local std::unordered_map<uint64_t, uint32_t> executions_since_sample;
+  thread_local uint64_t cached_id = 0;
+  thread_local uint32_t* cached_count = nullptr;
+  if (cached_count == nullptr || cached_id != id_) {
+    cached_id = id_;
+    cached_count = &executions_since_sample[id_];
+  }
+  return *cached_count;
+}
+
+SamplingProfiler::NodeStats* SamplingProfiler::AddNode(std::string name, std::string op_type) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return &nodes_.emplace_back(std::move(name), std::move(op_type));
+}
+
+void SamplingProfiler::Record(NodeStats& node, const TimePoint& start_time, const TimePoint& end_time) noexcept {
+  const auto duration_ns = static_cast<uint64_t>(
+      std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count()));
+  node.histogram.Record(duration_ns);
+
+  if (ring_buffer_size_ == 0) {
+    return;
+  }
+
+  // sampled per thread so that threads don't contend on a shared counter for every execution
+  uint32_t& executions_since_sample = ExecutionsSinceSample();
+  if (++executions_since_sample < sample_interval_) {
+    return;
+  }
+  executions_since_sample = 0;
+
+  const uint64_t position = next_event_.fetch_add(1, std::memory_order_relaxed);
+  SampledEvent& event = ring_buffer_[position % ring_buffer_size_];
+  event.sequence.store(2 * position + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  event.node.store(&node, std::memory_order_relaxed);
+  event.start_us.store(TimeDiffMicroSeconds(start_time_, start_time), std::memory_order_relaxed);
+  event.duration_ns.store(duration_ns, std::memory_order_relaxed);
+  event.thread_id.store(logging::GetThreadId(), std::memory_order_relaxed);
+  event.sequence.store(2 * position + 2, std::memory_order_release);
+}
+
+std::string SamplingProfiler::Snapshot() const {
+  std::ostringstream out;
+
+  // std::map so that the op types are in a stable order
+  std::map<std::string, LatencyHistogram::Snapshot> op_stats;
+  out << "{\n\"nodes\": [";
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    bool first = true;
+    for (const auto& node : nodes_) {
+      const auto stats = node.histogram.GetSnapshot();
+      op_stats[node.op_type].Merge(stats);
+      if (stats.Count() == 0) {
+        continue;
+      }
+      out << (first ? "\n" : ",\n") << "{\"name\": " << utils::JsonString(node.name)
+          << ", \"op_type\": " << utils::JsonString(node.op_type) << ", ";
+      WriteStats(out, stats);
+      out << "}";
+      first = false;
+    }
+  }
+
+  out << "],\n\"ops\": [";
+  bool first = true;
+  for (const auto& [op_type, stats] : op_stats) {
+    if (stats.Count() == 0) {
+      continue;
+    }
+    out << (first ? "\n" : ",\n") << "{\"op_type\": " << utils::JsonString(op_type) << ", ";
+    WriteStats(out, stats);
+    out << "}";
+    first = false;
+  }
+
+  out << "],\n\"sampled_events\": [";
+  const uint64_t end = next_event_.load(std::memory_order_acquire);
+  const uint64_t begin = end > ring_buffer_size_ ? end - ring_buffer_size_ : 0;
+  first = true;
+  for (uint64_t position = begin; position < end; ++position) {
+    const SampledEvent& event = ring_buffer_[position % ring_buffer_size_];
+    const uint64_t sequence = event.sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * position + 2) {
+      // being written, or already overwritten by a newer event
+      continue;
+    }
+    const NodeStats* node = event.node.load(std::memory_order_relaxed);
+    const int64_t start_us = event.start_us.load(std::memory_order_relaxed);
+    const uint64_t duration_ns = event.duration_ns.load(std::memory_order_relaxed);
+    const uint32_t thread_id = event.thread_id.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (event.sequence.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+
+    out << (first ? "\n" : ",\n") << "{\"name\": " << utils::JsonString(node->name)
+        << ", \"op_type\": " << utils::JsonString(node->op_type) << ", \"tid\": " << thread_id
+        << ", \"ts_us\": " << start_us << ", \"dur_us\": " << duration_ns / 1000.0 << "}";
+    first = false;
+  }
+  out << "]\n}\n";
+
+  return out.str();
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
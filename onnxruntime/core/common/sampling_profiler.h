@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/log_linear_histogram.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+/**
+ * Always-on profiler of kernel latencies that is cheap enough to leave enabled in production.
+ * Every kernel execution is added to a latency histogram of its node with relaxed atomic counters, and one in
+ * sample_interval executions per thread is written to a fixed size ring buffer of recent events.
+ * Nothing is serialized on the execution path: Snapshot() aggregates the histograms per op type when it is requested.
+ */
+class SamplingProfiler {
+ public:
+  /**
+   * Lock-free recorder of durations in nanoseconds into buckets of 1/8 of a power of two, i.e. a relative error of at
+   * most 12.5% for the percentiles. Durations of 2^40 ns (~18 minutes) and above share the last bucket.
+   */
+  class LatencyHistogram {
+   public:
+    using Snapshot = LogLinearHistogram</*SubBucketBits*/ 3, /*MaxExponent*/ 40>;
+    static constexpr size_t kNumBuckets = Snapshot::kNumBuckets;
+
+    void Record(uint64_t duration_ns) noexcept;
+    Snapshot GetSnapshot() const;
+
+   private:
+    std::atomic<uint64_t> sum_ns_{0};
+    std::atomic<uint64_t> max_ns_{0};
+    std::array<std::atomic<uint64_t>, kNumBuckets> buckets_{};
+  };
+
+  struct NodeStats {
+    NodeStats(std::string name_in, std::string op_type_in)
+        : name(std::move(name_in)), op_type(std::move(op_type_in)) {}
+
+    const std::string name;
+    const std::string op_type;
+    LatencyHistogram histogram;
+  };
+
+  // sample_interval of 0 disables the ring buffer and only keeps the histograms
+  SamplingProfiler(size_t ring_buffer_size, uint32_t sample_interval);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SamplingProfiler);
+
+  // Adds a node to profile. Called while sessions are initialized. The returned stats live as long as the profiler.
+  NodeStats* AddNode(std::string name, std::string op_type);
+
+  // Records an execution of a node. Lock-free.
+  void Record(NodeStats& node, const TimePoint& start_time, const TimePoint& end_time) noexcept;
+
+  /**
+   * Returns a JSON document with the count, mean, p50, p90, p99 and max duration in microseconds per op type and
+   * per node, and the sampled events in the ring buffer, oldest first.
+   */
+  std::string Snapshot() const;
+
+ private:
+  // An entry of the ring buffer. sequence is odd while the entry is written, so a reader can detect and skip entries
+  // that were overwritten while it read them.
+  struct SampledEvent {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<const NodeStats*> node{nullptr};
+    std::atomic<int64_t> start_us{0};
+    std::atomic<uint64_t> duration_ns{0};
+    std::atomic<uint32_t> thread_id{0};
+  };
+
+  // Executions on the calling thread since its last sampled event for this profiler.
+  uint32_t& ExecutionsSinceSample() noexcept;
+
+  const TimePoint start_time_;
+  const uint32_t sample_interval_;
+  // identifies the profiler in the per-thread execution counts. unlike its address, it is never reused.
+  const uint64_t id_;
+
+  // guards nodes_ against concurrent additions and snapshots. not used when recording.
+  mutable OrtMutex mutex_;
+  // a deque so that NodeStats don't move when nodes are added
+  std::deque<NodeStats> nodes_;
+
+  std::unique_ptr<SampledEvent[]> ring_buffer_;
+  const size_t ring_buffer_size_;
+  std::atomic<uint64_t> next_event_{0};
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
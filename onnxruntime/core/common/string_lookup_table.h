@@ -0,0 +1,212 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace string_lookup_details {
+
+inline void PrefetchForRead(const void* p) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(p, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+  ORT_UNUSED_PARAMETER(p);
+#endif
+}
+
+// std::hash<std::string_view> gives no guarantee about the quality of the high bits, and size_t may be
+// 32-bit, so the value is spread over 64 bits before it is split into a slot index and a tag.
+inline uint64_t HashKey(std::string_view key) {
+  uint64_t h = static_cast<uint64_t>(std::hash<std::string_view>{}(key));
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h;
+}
+
+}  // namespace string_lookup_details
+
+// Read-mostly map from strings to TValue for kernels that look up many input strings against a
+// dictionary fixed at kernel construction (LabelEncoder, CategoryMapper, TfIdfVectorizer).
+//
+// All key characters are stored back to back in a single pool and the table itself is an open addressing
+// (linear probing) array of 8-byte slots that hold a hash tag and an entry index. A lookup touches one
+// slot cache line and, only on a tag match, the key bytes in the pool. Unlike std::unordered_map there
+// is no per-entry heap allocation and no pointer chasing through buckets.
+//
+// Entries can be added while the owning kernel is being constructed; the table must not be modified
+// once it is shared between threads.
+template <typename TValue>
+class StringLookupTable {
+ public:
+  StringLookupTable() = default;
+
+  size_t size() const noexcept { return values_.size(); }
+  bool empty() const noexcept { return values_.empty(); }
+
+  void reserve(size_t num_entries) {
+    entries_.reserve(num_entries);
+    values_.reserve(num_entries);
+    if (SlotCountFor(num_entries) > slots_.size()) {
+      Rehash(SlotCountFor(num_entries));
+    }
+  }
+
+  // Adds key -> value if key is not present yet. Returns false if the key already exists, in which case
+  // the existing value is kept (same semantics as std::unordered_map::emplace).
+  bool Emplace(std::string_view key, const TValue& value) {
+    return Insert(key, value, /*overwrite*/ false);
+  }
+
+  // Adds key -> value, replacing the value of an existing entry (same semantics as map[key] = value).
+  void InsertOrAssign(std::string_view key, const TValue& value) {
+    Insert(key, value, /*overwrite*/ true);
+  }
+
+  // Returns a pointer to the value for key or nullptr if the key is not present.
+  const TValue* Find(std::string_view key) const {
+    if (values_.empty()) {
+      return nullptr;
+    }
+    const int64_t index = FindIndex(key, string_lookup_details::HashKey(key));
+    return index < 0 ? nullptr : &values_[static_cast<size_t>(index)];
+  }
+
+  // Looks up count keys and writes the mapped value, or default_value for missing keys, to output.
+  // Hashes for a block of keys are computed first and their slots prefetched so the cache misses of
+  // independent lookups overlap instead of being serialized.
+  template <typename TKey>
+  void FindAll(const TKey* keys, size_t count, TValue* output, const TValue& default_value) const {
+    if (values_.empty()) {
+      std::fill(output, output + count, default_value);
+      return;
+    }
+
+    constexpr size_t kBlockSize = 16;
+    uint64_t hashes[kBlockSize];
+    for (size_t block_start = 0; block_start < count; block_start += kBlockSize) {
+      const size_t block_size = std::min(kBlockSize, count - block_start);
+      for (size_t i = 0; i < block_size; ++i) {
+        hashes[i] = string_lookup_details::HashKey(AsStringView(keys[block_start + i]));
+        string_lookup_details::PrefetchForRead(&slots_[static_cast<size_t>(hashes[i]) & slot_mask_]);
+      }
+      for (size_t i = 0; i < block_size; ++i) {
+        const int64_t index = FindIndex(AsStringView(keys[block_start + i]), hashes[i]);
+        output[block_start + i] = index < 0 ? default_value : values_[static_cast<size_t>(index)];
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    uint32_t tag;
+    uint32_t entry;  // index into entries_ plus one, 0 marks an empty slot
+  };
+
+  struct Entry {
+    size_t offset;  // start of the key in pool_
+    size_t length;
+  };
+
+  template <typename TKey>
+  static std::string_view AsStringView(const TKey& key) {
+    // Also accepts std::reference_wrapper<const std::string>.
+    return std::string_view(static_cast<const std::string&>(key));
+  }
+
+  static uint32_t TagOf(uint64_t hash) { return static_cast<uint32_t>(hash >> 32); }
+
+  // Keeps the load factor at or below 0.5 so probe sequences stay short for misses as well as hits.
+  static size_t SlotCountFor(size_t num_entries) {
+    size_t slot_count = 16;
+    while (slot_count < num_entries * 2) {
+      slot_count *= 2;
+    }
+    return slot_count;
+  }
+
+  bool KeyEquals(const Entry& entry, std::string_view key) const {
+    return entry.length == key.size() &&
+           (key.empty() || std::memcmp(pool_.data() + entry.offset, key.data(), key.size()) == 0);
+  }
+
+  int64_t FindIndex(std::string_view key, uint64_t hash) const {
+    const uint32_t tag = TagOf(hash);
+    for (size_t pos = static_cast<size_t>(hash) & slot_mask_;; pos = (pos + 1) & slot_mask_) {
+      const Slot& slot = slots_[pos];
+      if (slot.entry == 0) {
+        return -1;
+      }
+      if (slot.tag == tag && KeyEquals(entries_[slot.entry - 1], key)) {
+        return static_cast<int64_t>(slot.entry - 1);
+      }
+    }
+  }
+
+  bool Insert(std::string_view key, const TValue& value, bool overwrite) {
+    if (SlotCountFor(values_.size() + 1) > slots_.size()) {
+      Rehash(SlotCountFor(values_.size() + 1));
+    }
+
+    const uint64_t hash = string_lookup_details::HashKey(key);
+    const int64_t existing = FindIndex(key, hash);
+    if (existing >= 0) {
+      if (overwrite) {
+        values_[static_cast<size_t>(existing)] = value;
+      }
+      return false;
+    }
+
+    ORT_ENFORCE(values_.size() < std::numeric_limits<uint32_t>::max(), "Too many entries in StringLookupTable.");
+    entries_.push_back(Entry{pool_.size(), key.size()});
+    values_.push_back(value);
+    pool_.append(key.data(), key.size());
+    PlaceSlot(Slot{TagOf(hash), static_cast<uint32_t>(values_.size())}, hash);
+    return true;
+  }
+
+  void PlaceSlot(const Slot& slot, uint64_t hash) {
+    size_t pos = static_cast<size_t>(hash) & slot_mask_;
+    while (slots_[pos].entry != 0) {
+      pos = (pos + 1) & slot_mask_;
+    }
+    slots_[pos] = slot;
+  }
+
+  void Rehash(size_t slot_count) {
+    slots_.assign(slot_count, Slot{0, 0});
+    slot_mask_ = slot_count - 1;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      const std::string_view key(pool_.data() + entries_[i].offset, entries_[i].length);
+      const uint64_t hash = string_lookup_details::HashKey(key);
+      PlaceSlot(Slot{TagOf(hash), static_cast<uint32_t>(i + 1)}, hash);
+    }
+  }
+
+  std::vector<Slot> slots_;
+  size_t slot_mask_ = 0;
+  std::vector<Entry> entries_;
+  std::vector<TValue> values_;
+  std::string pool_;
+};
+
+}  // namespace onnxruntime
@@ -19,6 +19,7 @@ limitations under the License.
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
 #include "core/common/cpuid_info.h"
+#include "core/common/profiler.h"
 #include "core/common/eigen_common_wrapper.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
@@ -242,6 +243,47 @@ std::string ThreadPoolProfiler::DumpChildThreadStat() {
 }
 #endif
 
+ThreadPoolTelemetry ThreadPoolTelemetry::Since(const ThreadPoolTelemetry& earlier) const {
+  ThreadPoolTelemetry delta = *this;
+  for (size_t i = 0; i < delta.tasks_executed.size() && i < earlier.tasks_executed.size(); ++i) {
+    delta.tasks_executed[i] -= earlier.tasks_executed[i];
+  }
+  delta.tasks_stolen -= earlier.tasks_stolen;
+  delta.spin_iterations -= earlier.spin_iterations;
+  delta.parks -= earlier.parks;
+  delta.unparks -= earlier.unparks;
+  delta.unpark_latency_ns -= earlier.unpark_latency_ns;
+  delta.parallel_loops -= earlier.parallel_loops;
+  delta.parallel_loop_ns -= earlier.parallel_loop_ns;
+  delta.parallel_loop_wait_ns -= earlier.parallel_loop_wait_ns;
+  return delta;
+}
+
+std::string ThreadPoolTelemetry::ToJson() const {
+  uint64_t total_tasks = 0;
+  std::stringstream tasks;
+  for (size_t i = 0; i < tasks_executed.size(); ++i) {
+    total_tasks += tasks_executed[i];
+    tasks << (i > 0 ? ", " : "") << tasks_executed[i];
+  }
+  std::stringstream ss;
+  ss << "{\"threads\": " << tasks_executed.size()
+     << ", \"tasks_executed\": " << total_tasks
+     << ", \"tasks_executed_per_thread\": [" << tasks.str() << "]"
+     << ", \"tasks_stolen\": " << tasks_stolen
+     << ", \"spin_iterations\": " << spin_iterations
+     << ", \"parks\": " << parks
+     << ", \"unparks\": " << unparks
+     << ", \"unpark_latency_ns\": " << unpark_latency_ns
+     << ", \"mean_unpark_latency_ns\": " << (unparks > 0 ? unpark_latency_ns / unparks : 0)
+     << ", \"parallel_loops\": " << parallel_loops
+     << ", \"parallel_loop_ns\": " << parallel_loop_ns
+     << ", \"parallel_loop_wait_ns\": " << parallel_loop_wait_ns
+     << ", \"load_imbalance\": "
+     << (parallel_loop_ns > 0 ? static_cast<double>(parallel_loop_wait_ns) / parallel_loop_ns : 0.0) << "}";
+  return ss.str();
+}
+
 // A sharded loop counter distributes loop iterations between a set of worker threads.  The iteration space of
 // the loop is divided (perhaps unevenly) between the shards.  Each thread has a home shard (perhaps not uniquely
 // to it), and it claims iterations via atomic operations on its home shard.  It then proceeds through the other
@@ -479,6 +521,14 @@ void ThreadPool::Schedule(std::function<void()> fn) {
   }
 }
 
+ThreadPoolTelemetry ThreadPool::GetTelemetry() const {
+  if (underlying_threadpool_) {
+    return underlying_threadpool_->GetTelemetry();
+  } else {
+    return {};
+  }
+}
+
 void ThreadPool::StartProfiling() {
   if (underlying_threadpool_) {
     underlying_threadpool_->StartProfiling();
@@ -517,6 +567,21 @@ ThreadPool::ParallelSection::~ParallelSection() {
 
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
   if (underlying_threadpool_) {
+    // record the share of the loop run by each thread on its lane of the trace, under the kernel that started it
+    const profiling::TraceScope* trace_scope = profiling::TraceScope::Current();
+    if (trace_scope != nullptr && trace_scope->GetProfiler().IsThreadPoolTraceEnabled()) {
+      fn = [this, trace_scope, fn = std::move(fn)](unsigned idx) {
+        auto& profiler = trace_scope->GetProfiler();
+        const std::string& parent = trace_scope->Parent();
+        profiling::TraceScope worker_scope(profiler, parent);
+        const int worker = CurrentThreadId();
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        fn(idx);
+        profiler.RecordThreadEvent(profiling::THREAD_POOL_EVENT, parent + "_parallel_work", start_time,
+                                   worker >= 0 ? MakeString("intra-op worker ", worker) : std::string(),
+                                   {{"parent", parent}, {"work_item", std::to_string(idx)}});
+      };
+    }
     if (current_parallel_section.has_value()) {
       underlying_threadpool_->RunInParallelSection(*current_parallel_section,
                                                    std::move(fn),
@@ -663,6 +728,14 @@ std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp) {
   }
 }
 
+ThreadPoolTelemetry ThreadPool::GetTelemetry(const concurrency::ThreadPool* tp) {
+  if (tp) {
+    return tp->GetTelemetry();
+  } else {
+    return {};
+  }
+}
+
 void ThreadPool::EnableSpinning() {
   if (extended_eigen_threadpool_) {
     extended_eigen_threadpool_->EnableSpinning();
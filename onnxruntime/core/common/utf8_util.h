@@ -3,11 +3,107 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+
 #include "core/common/common.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ORT_UTF8_UTIL_USE_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define ORT_UTF8_UTIL_USE_NEON
+#endif
+
 namespace onnxruntime {
 namespace utf8_util {
 
+/// <summary>
+/// Returns the number of leading bytes of s that are 7-bit ASCII.
+/// Checks 16 bytes at a time with SSE2/NEON where available, otherwise 8 bytes at a time.
+/// </summary>
+inline size_t ascii_prefix_length(const unsigned char* s, size_t len) {
+  size_t idx = 0;
+#if defined(ORT_UTF8_UTIL_USE_SSE2)
+  for (; idx + 16 <= len; idx += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + idx));
+    if (_mm_movemask_epi8(v) != 0) {
+      break;
+    }
+  }
+#elif defined(ORT_UTF8_UTIL_USE_NEON)
+  for (; idx + 16 <= len; idx += 16) {
+    if (vmaxvq_u8(vld1q_u8(s + idx)) >= 0x80u) {
+      break;
+    }
+  }
+#endif
+  for (; idx + 8 <= len; idx += 8) {
+    uint64_t word;
+    std::memcpy(&word, s + idx, sizeof(word));
+    if ((word & 0x8080808080808080ULL) != 0) {
+      break;
+    }
+  }
+  while (idx < len && s[idx] < 0x80u) {
+    ++idx;
+  }
+  return idx;
+}
+
+inline bool is_ascii(const unsigned char* s, size_t len) {
+  return ascii_prefix_length(s, len) == len;
+}
+
+namespace detail {
+// Flips the case of the bytes of src in [first, last] and leaves every other byte, including
+// non-ASCII ones, untouched. src and dest may be the same buffer.
+inline void ascii_flip_case_in_range(const char* src, size_t len, char* dest, char first, char last) {
+  size_t idx = 0;
+#if defined(ORT_UTF8_UTIL_USE_SSE2)
+  // Bytes >= 0x80 are negative as signed chars so they never fall into [first, last].
+  const __m128i lower_bound = _mm_set1_epi8(static_cast<char>(first - 1));
+  const __m128i upper_bound = _mm_set1_epi8(static_cast<char>(last + 1));
+  const __m128i case_bit = _mm_set1_epi8(0x20);
+  for (; idx + 16 <= len; idx += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + idx));
+    const __m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(v, lower_bound), _mm_cmplt_epi8(v, upper_bound));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + idx), _mm_xor_si128(v, _mm_and_si128(in_range, case_bit)));
+  }
+#elif defined(ORT_UTF8_UTIL_USE_NEON)
+  const uint8x16_t lower_bound = vdupq_n_u8(static_cast<uint8_t>(first));
+  const uint8x16_t upper_bound = vdupq_n_u8(static_cast<uint8_t>(last));
+  const uint8x16_t case_bit = vdupq_n_u8(0x20);
+  for (; idx + 16 <= len; idx += 16) {
+    const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(src + idx));
+    const uint8x16_t in_range = vandq_u8(vcgeq_u8(v, lower_bound), vcleq_u8(v, upper_bound));
+    vst1q_u8(reinterpret_cast<uint8_t*>(dest + idx), veorq_u8(v, vandq_u8(in_range, case_bit)));
+  }
+#endif
+  for (; idx < len; ++idx) {
+    const char ch = src[idx];
+    dest[idx] = (ch >= first && ch <= last) ? static_cast<char>(ch ^ 0x20) : ch;
+  }
+}
+}  // namespace detail
+
+/// <summary>
+/// Converts A-Z to a-z in src and writes the result to dest, which must hold len bytes.
+/// Bytes outside of A-Z, including UTF-8 multi-byte sequences, are copied as is.
+/// </summary>
+inline void ascii_to_lower(const char* src, size_t len, char* dest) {
+  detail::ascii_flip_case_in_range(src, len, dest, 'A', 'Z');
+}
+
+/// <summary>
+/// Converts a-z to A-Z in src and writes the result to dest, which must hold len bytes.
+/// Bytes outside of a-z, including UTF-8 multi-byte sequences, are copied as is.
+/// </summary>
+inline void ascii_to_upper(const char* src, size_t len, char* dest) {
+  detail::ascii_flip_case_in_range(src, len, dest, 'a', 'z');
+}
+
 /// <summary>
 /// Checks the extension bytes and returns a number of
 /// bytes in the UTF-8 character
@@ -40,6 +136,14 @@ inline bool utf8_bytes(unsigned char ch, size_t& len) {
 inline bool utf8_len(const unsigned char* s, size_t bytes, size_t& len) {
   size_t result = 0;
   while (bytes > 0) {
+    if (*s < 0x80u) {
+      // ASCII runs are one character per byte
+      const size_t ascii_bytes = ascii_prefix_length(s, bytes);
+      bytes -= ascii_bytes;
+      s += ascii_bytes;
+      result += ascii_bytes;
+      continue;
+    }
     size_t char_bytes = 0;
     bool valid = utf8_bytes(*s, char_bytes);
     if (!valid || bytes < char_bytes) {
@@ -57,6 +161,13 @@ inline bool utf8_validate(const unsigned char* s, size_t len, size_t& utf8_chars
   size_t utf8_len = 0;
   size_t idx = 0;
   while (idx < len) {
+    if (s[idx] < 0x80u) {
+      // ASCII runs are always valid
+      const size_t ascii_bytes = ascii_prefix_length(s + idx, len - idx);
+      idx += ascii_bytes;
+      utf8_len += ascii_bytes;
+      continue;
+    }
     size_t bytes = 0;
     auto ch = s[idx];
     if (utf8_bytes(ch, bytes)) {
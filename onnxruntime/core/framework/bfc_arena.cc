@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "core/common/profiler.h"
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
 #include <type_traits>
@@ -166,6 +167,11 @@ Status BFCArena::Extend(size_t rounded_bytes) {
     return extend_bytes;
   };
 
+  // extensions during a traced kernel are recorded in the thread pool trace of its session
+  const profiling::TraceScope* trace_scope = profiling::TraceScope::Current();
+  const TimePoint extend_start_time = trace_scope != nullptr ? std::chrono::high_resolution_clock::now()
+                                                             : TimePoint{};
+
   size_t bytes = get_extend_bytes(rounded_bytes);
   // Try allocating.
   void* mem_addr = safe_alloc(bytes);
@@ -214,6 +220,14 @@ Status BFCArena::Extend(size_t rounded_bytes) {
   region_manager_.AddAllocationRegion(mem_addr, bytes, stats_.num_arena_extensions);
   stats_.num_arena_extensions += 1;
 
+  if (trace_scope != nullptr && trace_scope->GetProfiler().IsThreadPoolTraceEnabled()) {
+    trace_scope->GetProfiler().RecordThreadEvent(profiling::MEMORY_EVENT, "BFCArena::Extend", extend_start_time, std::string(),
+                                                 {{"parent", trace_scope->Parent()},
+                                                  {"device", device_allocator_->Info().name},
+                                                  {"bytes", std::to_string(bytes)},
+                                                  {"requested_bytes", std::to_string(rounded_bytes)}});
+  }
+
   // Create one large chunk for the whole memory space that will
   // be chunked later.
   ChunkHandle h = AllocateChunk();
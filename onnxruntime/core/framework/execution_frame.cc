@@ -379,6 +379,10 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
   session_state.GetMemoryProfiler()->GetMemoryInfo().IncreaseIteration();
 #endif
 
+  if (auto* memory_profiler = session_state.GetRuntimeMemoryProfiler()) {
+    memory_recorder_ = memory_profiler->StartRun();
+  }
+
   // map the custom allocators to ort_value_idx entries
   if (!fetch_allocators.empty()) {
     custom_allocators_.reserve(fetch_allocators.size());
@@ -554,6 +558,10 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
                 shape);
+            if (memory_recorder_ && status.IsOK()) {
+              memory_recorder_->RecordAllocation(ort_value_index, ort_value, *GetAllocator(location),
+                                                 /*planned*/ true, /*output*/ false);
+            }
             return status;
           } else {
             // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
@@ -574,6 +582,8 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   // no memory pattern, or the pattern is not correct.
   if (!alloc) alloc = GetAllocator(location);
   ORT_ENFORCE(alloc && alloc.get() != nullptr, "Failed to get allocator for ", location.ToString());
+  // the tensor keeps the allocator alive after it is moved into it
+  IAllocator* allocator = alloc.get();
 
   Stream* current_stream = GetValueStream(ort_value_index);
   if (current_stream) {
@@ -603,6 +613,11 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
     TraceAllocate(ort_value_index, size);
   }
 
+  if (memory_recorder_) {
+    memory_recorder_->RecordAllocation(ort_value_index, ort_value, *allocator, /*planned*/ false,
+                                       per_alloc_plan.alloc_kind == AllocKind::kAllocateOutput);
+  }
+
   {
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     // This code block is not thread-safe.
@@ -13,6 +13,7 @@
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/runtime_memory_profiler.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/tensor.h"
 #include "core/graph/graph_viewer.h"
@@ -166,6 +167,9 @@ class ExecutionFrame final : public IExecutionFrame {
     return planner_.has_value();
   }
 
+  // Recorder of the allocations of this run, or nullptr if the session has no runtime memory profiler.
+  RuntimeMemoryProfiler::RunRecorder* GetMemoryRecorder() const { return memory_recorder_.get(); }
+
   // This function try retrieve the inferred shapes for the given NodeArg index.
   // If the retrival is sucessful, this function returns true and false otherwise.
   bool TryGetInferredShape(int index, TensorShape& shape) const override;
@@ -247,6 +251,9 @@ class ExecutionFrame final : public IExecutionFrame {
   // It is never updated after creation
   const InlinedHashMap<int, TensorShape>* inferred_shapes_{nullptr};
 
+  // Records the tensors allocated by this frame if the runtime memory profiler is enabled.
+  std::unique_ptr<RuntimeMemoryProfiler::RunRecorder> memory_recorder_;
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Size of virtual memory allocated before any kernel execution.
   // This field is not physical memory size.
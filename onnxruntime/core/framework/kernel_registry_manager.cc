@@ -104,6 +104,17 @@ Status KernelRegistryManager::SearchKernelRegistry(const Node& node,
   return Status(ONNXRUNTIME, NOT_IMPLEMENTED, create_error_message("Failed to find kernel for "));
 }
 
+bool KernelRegistryManager::HasCustomKernel(const Node& node) const {
+  // custom registries are searched first, so a kernel found in one of them is the kernel of the node
+  return std::any_of(custom_kernel_registries_.begin(), custom_kernel_registries_.end(),
+                     [&](const std::shared_ptr<KernelRegistry>& registry) {
+                       const KernelCreateInfo* kernel_create_info = nullptr;
+                       return registry->TryFindKernel(node, std::string(), GetKernelTypeStrResolver(),
+                                                      &kernel_create_info)
+                           .IsOK();
+                     });
+}
+
 bool KernelRegistryManager::HasImplementationOf(const KernelRegistryManager& r, const Node& node, const std::string& provider_type) {
   const auto kernel_registries = r.GetKernelRegistriesByProviderType(provider_type);
   return std::any_of(kernel_registries.begin(), kernel_registries.end(), [&](const KernelRegistry* kernel_registry) {
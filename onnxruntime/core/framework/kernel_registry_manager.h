@@ -70,6 +70,10 @@ class KernelRegistryManager {
   Status SearchKernelRegistry(const Node& node,
                               /*out*/ const KernelCreateInfo** kernel_create_info) const;
 
+  // Whether the kernel of the node comes from a registry added with RegisterKernelRegistry, e.g. a custom op kernel,
+  // rather than from the registry of its execution provider.
+  bool HasCustomKernel(const Node& node) const;
+
   /**
    * Whether this node can be run on this provider
    */
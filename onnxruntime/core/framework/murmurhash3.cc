@@ -15,6 +15,9 @@
 
 /* Modifications Copyright (c) Microsoft. */
 
+#include <algorithm>
+#include <limits>
+
 #include "core/framework/endian.h"
 
 //-----------------------------------------------------------------------------
@@ -346,4 +349,21 @@ void MurmurHash3::x86_128(const void* key, int len, uint32_t seed, void* out) {
   ((uint32_t*)out)[3] = h4;
 }
 
+//-----------------------------------------------------------------------------
+
+void MurmurHash3::x86_128_chain(const void* key, size_t len, uint32_t state[4]) {
+  const auto* bytes = static_cast<const uint8_t*>(key);
+  constexpr size_t max_chunk_size = static_cast<size_t>(std::numeric_limits<int>::max());
+  do {
+    const size_t chunk_size = std::min(len, max_chunk_size);
+    // the state followed by the hash of the chunk is hashed into the new state
+    uint32_t block[8];
+    std::copy_n(state, 4, block);
+    x86_128(bytes, static_cast<int>(chunk_size), 0, block + 4);
+    x86_128(block, static_cast<int>(sizeof(block)), 0, state);
+    bytes += chunk_size;
+    len -= chunk_size;
+  } while (len > 0);
+}
+
 }  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace onnxruntime {
@@ -12,5 +13,10 @@ struct MurmurHash3 {
 
   // generate 128-bit hash from input and write to 'out'.
   static void x86_128(const void* key, int len, uint32_t seed, void* out);
+
+  // add input of any length to the 128-bit hash 'state' of the inputs added before, starting from all zeros.
+  // the 128-bit hash of the input is chained with the whole state, so the result depends on every bit of it.
+  // this is not a cryptographic hash.
+  static void x86_128_chain(const void* key, size_t len, uint32_t state[4]);
 };
 }  // namespace onnxruntime
@@ -2,7 +2,12 @@
 // Licensed under the MIT License.
 
 #include "core/framework/prepacked_weights_container.h"
+
+#include <cstring>
+
 #include "core/framework/allocator_utils.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensorprotoutils.h"
 
 namespace onnxruntime {
 
@@ -49,4 +54,54 @@ size_t PrepackedWeightsContainer::GetNumberOfElements() const {
   return prepacked_weights_map_.size();
 }
 
+const OrtValue* PrepackedWeightsContainer::FindSharedInitializer(const std::string& key, const void* data,
+                                                                 size_t size) const {
+  auto [begin, end] = shared_initializers_.equal_range(key);
+  for (auto it = begin; it != end; ++it) {
+    const Tensor& tensor = it->second.Get<Tensor>();
+    if (tensor.SizeInBytes() == size && std::memcmp(tensor.DataRaw(), data, size) == 0) {
+      return &it->second;
+    }
+  }
+  return nullptr;
+}
+
+const OrtValue* PrepackedWeightsContainer::GetSharedInitializer(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                                                std::string& key) {
+  ORT_ENFORCE(utils::HasRawData(tensor_proto), "Only initializers with raw data can be shared.");
+  const std::string& raw_data = tensor_proto.raw_data();
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128_chain(raw_data.data(), raw_data.size(), hash);
+
+  key.clear();
+  key.reserve(sizeof(int32_t) + tensor_proto.dims_size() * sizeof(int64_t) + sizeof(hash));
+  const int32_t data_type = tensor_proto.data_type();
+  key.append(reinterpret_cast<const char*>(&data_type), sizeof(data_type));
+  for (int64_t dim : tensor_proto.dims()) {
+    key.append(reinterpret_cast<const char*>(&dim), sizeof(dim));
+  }
+  key.append(reinterpret_cast<const char*>(hash), sizeof(hash));
+
+  std::lock_guard<OrtMutex> lock(shared_initializers_mutex_);
+  return FindSharedInitializer(key, raw_data.data(), raw_data.size());
+}
+
+OrtValue PrepackedWeightsContainer::AddSharedInitializer(const std::string& key, const OrtValue& value) {
+  const Tensor& tensor = value.Get<Tensor>();
+  ORT_ENFORCE(tensor.Location().device.Type() == OrtDevice::CPU, "Only CPU initializers can be shared.");
+
+  std::lock_guard<OrtMutex> lock(shared_initializers_mutex_);
+  if (const OrtValue* existing = FindSharedInitializer(key, tensor.DataRaw(), tensor.SizeInBytes())) {
+    return *existing;
+  }
+  shared_initializers_.emplace(key, value);
+  return value;
+}
+
+size_t PrepackedWeightsContainer::GetNumberOfSharedInitializers() const {
+  std::lock_guard<OrtMutex> lock(shared_initializers_mutex_);
+  return shared_initializers_.size();
+}
+
 }  // namespace onnxruntime
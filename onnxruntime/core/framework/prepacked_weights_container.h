@@ -11,6 +11,8 @@
 #include "core/framework/buffer_deleter.h"
 
 #include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/graph/basic_types.h"
 #include "core/platform/ort_mutex.h"
 #include "prepacked_weights.h"
 
@@ -47,6 +49,21 @@ class PrepackedWeightsContainer final {
   // Returns the number of elements in the container
   size_t GetNumberOfElements() const;
 
+  // Initializers shared by the sessions using this container, enabled by the session config option
+  // "session.share_initializers_across_sessions". Identical initializers of the sessions are stored once.
+
+  // Returns the shared initializer with the same data type, shape and raw data as tensor_proto, or nullptr.
+  // Sets key to the key to add the initializer created from tensor_proto with if there is no match.
+  const OrtValue* GetSharedInitializer(const ONNX_NAMESPACE::TensorProto& tensor_proto, std::string& key);
+
+  // Adds a CPU initializer created from a TensorProto that GetSharedInitializer found no match for.
+  // Returns the initializer to use, which is an existing one if another session added an identical initializer
+  // since the lookup.
+  OrtValue AddSharedInitializer(const std::string& key, const OrtValue& value);
+
+  // Returns the number of shared initializers in the container
+  size_t GetNumberOfSharedInitializers() const;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsContainer);
 
   // Resource to be acquired by the method that is going to invoke calls to the kernels'
@@ -64,6 +81,16 @@ class PrepackedWeightsContainer final {
   // to PrePackedWeights instances.
   // The key is : op_type + "+" + hash_of_prepacked_buffers_in_the_PrepackedWeights_instance.
   std::unordered_map<std::string, PrePackedWeights> prepacked_weights_map_;
+
+ private:
+  // Returns the initializer in shared_initializers_ with the given key and data, or nullptr.
+  const OrtValue* FindSharedInitializer(const std::string& key, const void* data, size_t size) const;
+
+  // Guards shared_initializers_. Separate from mutex_ as it's used while sessions prepack their weights.
+  mutable OrtMutex shared_initializers_mutex_;
+
+  // The key is the data type, shape and hash of the data, so initializers with different data may share a key.
+  std::unordered_multimap<std::string, OrtValue> shared_initializers_;
 };
 
 }  // namespace onnxruntime
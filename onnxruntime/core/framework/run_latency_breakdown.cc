@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/run_latency_breakdown.h"
+
+#include <chrono>
+#include <sstream>
+
+namespace onnxruntime {
+
+namespace {
+int64_t ElapsedNs(const TimePoint& start_time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start_time)
+      .count();
+}
+}  // namespace
+
+void RunLatencyBreakdown::AddPhase(Phase phase, const TimePoint& start_time) {
+  phase_ns_[static_cast<size_t>(phase)].fetch_add(ElapsedNs(start_time), std::memory_order_relaxed);
+}
+
+void RunLatencyBreakdown::AddKernel(const std::string& provider, const std::string& op_type,
+                                    const TimePoint& start_time) {
+  if (op_type == "MemcpyFromHost" || op_type == "MemcpyToHost") {
+    AddPhase(Phase::kDataTransfer, start_time);
+    return;
+  }
+
+  const int64_t compute_ns = ElapsedNs(start_time);
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& partition = partitions_[provider];
+  ++partition.kernels;
+  partition.compute_ns += compute_ns;
+}
+
+std::string RunLatencyBreakdown::ToJson(const TimePoint& run_start_time) const {
+  const auto phase_ns = [this](Phase phase) {
+    return phase_ns_[static_cast<size_t>(phase)].load(std::memory_order_relaxed);
+  };
+
+  std::ostringstream out;
+  out << "{\"total_ns\": " << ElapsedNs(run_start_time)
+      << ", \"input_validation_ns\": " << phase_ns(Phase::kInputValidation)
+      << ", \"allocation_and_planning_ns\": " << phase_ns(Phase::kAllocationAndPlanning)
+      << ", \"data_transfer_ns\": " << phase_ns(Phase::kDataTransfer)
+      << ", \"output_copy_ns\": " << phase_ns(Phase::kOutputCopy);
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  int64_t compute_ns = 0;
+  for (const auto& partition : partitions_) {
+    compute_ns += partition.second.compute_ns;
+  }
+  out << ", \"kernel_compute_ns\": " << compute_ns << ", \"partitions\": [";
+  bool first = true;
+  for (const auto& [provider, partition] : partitions_) {
+    out << (first ? "" : ", ")
+        << "{\"provider\": \"" << provider << "\""
+        << ", \"kernels\": " << partition.kernels
+        << ", \"compute_ns\": " << partition.compute_ns << "}";
+    first = false;
+  }
+  out << "]}";
+  return out.str();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * Latency breakdown of a single Run, enabled with the run option "run.latency_breakdown".
+ * InferenceSession::Run passes it to utils::ExecuteGraph, so the executor and the copies of the feeds and fetches of
+ * the main graph of that run add their time to it. It isn't passed down to subgraphs, which are part of the kernel time
+ * of their parent node, nor to runs of other sessions started from within a kernel.
+ * The kernels of a run may execute on the inter-op thread pool, so adding to the breakdown is thread safe.
+ */
+class RunLatencyBreakdown {
+ public:
+  enum class Phase {
+    kInputValidation,        // validation of the names, types and shapes of the feeds and fetches
+    kAllocationAndPlanning,  // feeds/fetches manager, execution frame, and memory pattern of the run
+    kDataTransfer,           // copies of the feeds to the devices consuming them, and Memcpy nodes
+    kOutputCopy,             // copies of the fetches to the devices requested by the caller
+    kNumPhases
+  };
+
+  RunLatencyBreakdown() = default;
+
+  // Adds the time since start_time to a phase.
+  void AddPhase(Phase phase, const TimePoint& start_time);
+
+  // Adds the time since start_time to the kernel compute of the partition of an execution provider.
+  // Memcpy nodes copy with the DataTransferManager, so they are added to Phase::kDataTransfer instead.
+  void AddKernel(const std::string& provider, const std::string& op_type, const TimePoint& start_time);
+
+  /**
+   * Returns a JSON document with the total time of the run, the time of each phase, and per execution provider the
+   * number of kernels run and their compute time. Times are in nanoseconds. Kernels of parallel streams overlap, so
+   * the parts may add up to more than the total.
+   */
+  std::string ToJson(const TimePoint& run_start_time) const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunLatencyBreakdown);
+
+  struct Partition {
+    size_t kernels = 0;
+    int64_t compute_ns = 0;
+  };
+
+  std::array<std::atomic<int64_t>, static_cast<size_t>(Phase::kNumPhases)> phase_ns_{};
+  mutable OrtMutex mutex_;
+  std::map<std::string, Partition> partitions_;
+};
+
+}  // namespace onnxruntime
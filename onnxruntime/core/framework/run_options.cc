@@ -5,6 +5,7 @@
 #include "core/session/onnxruntime_c_api.h"
 #include "core/session/ort_apis.h"
 #include "core/framework/error_code_helper.h"
+#include "core/common/string_helper.h"
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(disable : 26409)
 #endif
@@ -46,6 +47,14 @@ ORT_API_STATUS_IMPL(OrtApis::RunOptionsGetRunTag, _In_ const OrtRunOptions* opti
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsGetLatencyBreakdown, _In_ const OrtRunOptions* options,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  *out = onnxruntime::StrDup(options->latency_breakdown.Get(), allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetTerminate, _Inout_ OrtRunOptions* options) {
   options->terminate = true;
   return nullptr;
@@ -0,0 +1,245 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/runtime_memory_profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+#include "core/common/json_string.h"
+#include "core/framework/allocator_stats.h"
+#include "core/framework/bfc_arena.h"
+#include "core/framework/session_state.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+namespace {
+BFCArena* AsArena(IAllocator* allocator) {
+  if (allocator != nullptr && allocator->Info().alloc_type == OrtArenaAllocator) {
+    return static_cast<BFCArena*>(allocator);
+  }
+  return nullptr;
+}
+
+// peak of the bytes of the live tensors of a device, and the index of the event that reached it
+struct DevicePeak {
+  size_t event = 0;
+  size_t bytes = 0;
+};
+
+std::map<OrtDevice, DevicePeak> FindPeaks(const std::vector<RuntimeMemoryProfiler::Allocation>& allocations,
+                                          const std::vector<RuntimeMemoryProfiler::Event>& events) {
+  std::map<OrtDevice, size_t> live_bytes;
+  std::map<OrtDevice, DevicePeak> peaks;
+  for (size_t i = 0; i < events.size(); ++i) {
+    const auto& allocation = allocations[events[i].allocation];
+    auto& bytes = live_bytes[allocation.device];
+    auto& peak = peaks.try_emplace(allocation.device, DevicePeak{i, 0}).first->second;
+    if (events[i].is_alloc) {
+      bytes += allocation.bytes;
+      if (bytes > peak.bytes) {
+        peak.event = i;
+        peak.bytes = bytes;
+      }
+    } else {
+      bytes -= allocation.bytes;
+    }
+  }
+  return peaks;
+}
+
+std::string NodeName(const GraphViewer& graph_viewer, NodeIndex node_index) {
+  const Node* node = node_index != RuntimeMemoryProfiler::kNoNode ? graph_viewer.GetNode(node_index) : nullptr;
+  if (node == nullptr) {
+    return "";
+  }
+  return node->Name().empty() ? MakeString(node->OpType(), "_", node->Index()) : node->Name();
+}
+}  // namespace
+
+RuntimeMemoryProfiler::RunRecorder::RunRecorder(RuntimeMemoryProfiler& profiler)
+    : profiler_(profiler), start_time_(std::chrono::steady_clock::now()) {
+}
+
+RuntimeMemoryProfiler::RunRecorder::~RunRecorder() {
+  profiler_.AddRun(Run{std::move(allocations_), std::move(events_)});
+}
+
+int64_t RuntimeMemoryProfiler::RunRecorder::ElapsedUs() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time_)
+      .count();
+}
+
+void RuntimeMemoryProfiler::RunRecorder::AddEvent(size_t allocation, bool is_alloc, IAllocator* allocator) {
+  Event event{allocation, is_alloc, -1, -1};
+  if (AsArena(allocator) != nullptr) {
+    AllocatorStats stats;
+    allocator->GetStats(&stats);
+    event.arena_in_use_bytes = stats.bytes_in_use;
+    event.arena_reserved_bytes = stats.total_allocated_bytes;
+  }
+  events_.push_back(event);
+}
+
+void RuntimeMemoryProfiler::RunRecorder::RecordAllocation(int ort_value_idx, const OrtValue& value,
+                                                          IAllocator& allocator, bool planned, bool output) {
+  const auto& tensor = value.Get<Tensor>();
+  Allocation allocation{};
+  allocation.ort_value_idx = ort_value_idx;
+  allocation.device = allocator.Info().device;
+  allocation.bytes = tensor.SizeInBytes();
+  allocation.planned = planned;
+  allocation.output = output;
+  allocation.free_time_us = -1;
+  allocation.freed_by = kNoNode;
+
+  BFCArena* arena = planned ? nullptr : AsArena(&allocator);
+  if (arena != nullptr && tensor.DataRaw() != nullptr) {
+    allocation.chunk_bytes = arena->AllocatedSize(tensor.DataRaw());
+    allocation.requested_bytes = arena->RequestedSize(tensor.DataRaw());
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  allocation.alloc_time_us = ElapsedUs();
+  const size_t index = allocations_.size();
+  allocations_.push_back(allocation);
+  live_[ort_value_idx] = {index, &allocator};
+  AddEvent(index, true, &allocator);
+}
+
+void RuntimeMemoryProfiler::RunRecorder::RecordFree(int ort_value_idx, NodeIndex released_by) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = live_.find(ort_value_idx);
+  // values that reuse or share the buffer of another value are not recorded
+  if (it == live_.end()) {
+    return;
+  }
+  auto& allocation = allocations_[it->second.first];
+  allocation.free_time_us = ElapsedUs();
+  allocation.freed_by = released_by;
+  AddEvent(it->second.first, false, it->second.second);
+  live_.erase(it);
+}
+
+void RuntimeMemoryProfiler::AddRun(Run run) {
+  for (const auto& device_peak : FindPeaks(run.allocations, run.events)) {
+    run.peak_bytes = std::max(run.peak_bytes, device_peak.second.bytes);
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  ++num_runs_;
+  if (!peak_run_.has_value() || run.peak_bytes > peak_run_->peak_bytes) {
+    peak_run_ = std::move(run);
+  }
+}
+
+std::string RuntimeMemoryProfiler::Report(const SessionState& session_state) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  std::ostringstream out;
+  out << "{\"runs\": " << num_runs_ << ",\n\"peak_run\": ";
+  if (!peak_run_.has_value()) {
+    out << "null}\n";
+    return out.str();
+  }
+
+  const auto& allocations = peak_run_->allocations;
+  const auto& events = peak_run_->events;
+  const auto& graph_viewer = session_state.GetGraphViewer();
+
+  std::vector<std::string> names(allocations.size());
+  std::vector<const Node*> producers(allocations.size());
+  for (size_t i = 0; i < allocations.size(); ++i) {
+    if (session_state.GetOrtValueNameIdxMap().GetName(allocations[i].ort_value_idx, names[i]).IsOK()) {
+      producers[i] = graph_viewer.GetProducerNode(names[i]);
+    }
+  }
+
+  out << "{\"tensors\": [";
+  for (size_t i = 0; i < allocations.size(); ++i) {
+    const auto& allocation = allocations[i];
+    const auto* producer = producers[i];
+    out << (i > 0 ? ",\n" : "\n")
+        << "{\"name\": " << utils::JsonString(names[i])
+        << ", \"node\": " << utils::JsonString(producer != nullptr ? NodeName(graph_viewer, producer->Index()) : "")
+        << ", \"op_type\": " << utils::JsonString(producer != nullptr ? producer->OpType() : "")
+        << ", \"device\": \"" << allocation.device.ToString() << "\""
+        << ", \"bytes\": " << allocation.bytes
+        << ", \"chunk_bytes\": " << allocation.chunk_bytes
+        << ", \"requested_bytes\": " << allocation.requested_bytes
+        << ", \"planned\": " << (allocation.planned ? "true" : "false")
+        << ", \"output\": " << (allocation.output ? "true" : "false")
+        << ", \"alloc_us\": " << allocation.alloc_time_us
+        << ", \"free_us\": " << allocation.free_time_us
+        << ", \"freed_by\": " << utils::JsonString(NodeName(graph_viewer, allocation.freed_by)) << "}";
+  }
+
+  out << "],\n\"timeline\": [";
+  std::map<OrtDevice, size_t> live_bytes;
+  for (size_t i = 0; i < events.size(); ++i) {
+    const auto& event = events[i];
+    const auto& allocation = allocations[event.allocation];
+    auto& bytes = live_bytes[allocation.device];
+    bytes = event.is_alloc ? bytes + allocation.bytes : bytes - allocation.bytes;
+    out << (i > 0 ? ",\n" : "\n")
+        << "{\"time_us\": " << (event.is_alloc ? allocation.alloc_time_us : allocation.free_time_us)
+        << ", \"event\": \"" << (event.is_alloc ? "alloc" : "free") << "\""
+        << ", \"tensor\": " << event.allocation
+        << ", \"live_bytes\": " << bytes
+        << ", \"arena_in_use_bytes\": " << event.arena_in_use_bytes
+        << ", \"arena_reserved_bytes\": " << event.arena_reserved_bytes << "}";
+  }
+
+  out << "],\n\"peaks\": [";
+  bool first_peak = true;
+  for (const auto& [device, peak] : FindPeaks(allocations, events)) {
+    // the tensors of the device that are live after the peak event
+    std::vector<bool> live(allocations.size(), false);
+    for (size_t i = 0; i <= peak.event; ++i) {
+      if (allocations[events[i].allocation].device == device) {
+        live[events[i].allocation] = events[i].is_alloc;
+      }
+    }
+    std::vector<size_t> peak_tensors;
+    size_t internal_fragmentation = 0;
+    for (size_t i = 0; i < allocations.size(); ++i) {
+      if (live[i]) {
+        peak_tensors.push_back(i);
+        internal_fragmentation += allocations[i].chunk_bytes - std::min(allocations[i].chunk_bytes,
+                                                                        allocations[i].requested_bytes);
+      }
+    }
+    std::stable_sort(peak_tensors.begin(), peak_tensors.end(),
+                     [&](size_t a, size_t b) { return allocations[a].bytes > allocations[b].bytes; });
+
+    const auto& peak_event = events[peak.event];
+    const int64_t external_fragmentation = peak_event.arena_reserved_bytes >= 0
+                                               ? peak_event.arena_reserved_bytes - peak_event.arena_in_use_bytes
+                                               : -1;
+    out << (first_peak ? "\n" : ",\n")
+        << "{\"device\": \"" << device.ToString() << "\""
+        << ", \"bytes\": " << peak.bytes
+        << ", \"time_us\": " << allocations[peak_event.allocation].alloc_time_us
+        << ", \"arena_in_use_bytes\": " << peak_event.arena_in_use_bytes
+        << ", \"arena_reserved_bytes\": " << peak_event.arena_reserved_bytes
+        << ", \"internal_fragmentation_bytes\": " << internal_fragmentation
+        << ", \"external_fragmentation_bytes\": " << external_fragmentation
+        << ", \"tensors\": [";
+    for (size_t i = 0; i < peak_tensors.size(); ++i) {
+      const auto& allocation = allocations[peak_tensors[i]];
+      out << (i > 0 ? ", " : "")
+          << "{\"tensor\": " << peak_tensors[i]
+          << ", \"name\": " << utils::JsonString(names[peak_tensors[i]])
+          << ", \"bytes\": " << allocation.bytes
+          << ", \"fraction\": " << (peak.bytes > 0 ? static_cast<double>(allocation.bytes) / peak.bytes : 0.0)
+          << "}";
+    }
+    out << "]}";
+    first_peak = false;
+  }
+  out << "]}}\n";
+  return out.str();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/graph/basic_types.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class SessionState;
+
+/**
+ * Memory profiler of the activations of a session, enabled at runtime with the session option
+ * "session.memory_profile_enable" unlike the MemoryInfo of ORT_MEMORY_PROFILE builds.
+ * Every execution frame records the allocations and frees of its tensors with the node that released them, their
+ * size, the size of their arena chunk, and the arena usage after each of them. The run with the highest peak is
+ * kept, and Report() turns it into a timeline and the tensors that make up the peak of every device.
+ */
+class RuntimeMemoryProfiler {
+ public:
+  static constexpr NodeIndex kNoNode = std::numeric_limits<NodeIndex>::max();
+
+  // A tensor allocated by the execution frame during a run.
+  struct Allocation {
+    int ort_value_idx;
+    OrtDevice device;
+    size_t bytes;
+    // size of the arena chunk holding the tensor and the size requested from the arena.
+    // 0 if the tensor is placed in the buffer of a memory pattern, or if the allocator is not an arena.
+    size_t chunk_bytes;
+    size_t requested_bytes;
+    // placed in the buffer of the cached memory pattern instead of allocated on its own
+    bool planned;
+    bool output;
+    int64_t alloc_time_us;
+    // -1 and kNoNode if the tensor is alive at the end of the run, e.g. a graph output
+    int64_t free_time_us;
+    NodeIndex freed_by;
+  };
+
+  struct Event {
+    size_t allocation;  // index in the allocations of the run
+    bool is_alloc;
+    // usage of the arena of the device after the event. -1 if the allocator of the device is not an arena.
+    int64_t arena_in_use_bytes;
+    int64_t arena_reserved_bytes;
+  };
+
+  /**
+   * Records the allocations of one run. The streams of a run may allocate in parallel, so it is thread safe.
+   * The run is added to the profiler when the recorder is destroyed with its execution frame.
+   */
+  class RunRecorder {
+   public:
+    explicit RunRecorder(RuntimeMemoryProfiler& profiler);
+    ~RunRecorder();
+
+    void RecordAllocation(int ort_value_idx, const OrtValue& value, IAllocator& allocator, bool planned,
+                          bool output);
+    // called after the value is released, so that the arena usage excludes its chunk
+    void RecordFree(int ort_value_idx, NodeIndex released_by);
+
+   private:
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunRecorder);
+
+    int64_t ElapsedUs() const;
+    void AddEvent(size_t allocation, bool is_alloc, IAllocator* allocator);
+
+    RuntimeMemoryProfiler& profiler_;
+    const std::chrono::steady_clock::time_point start_time_;
+    OrtMutex mutex_;
+    std::vector<Allocation> allocations_;
+    std::vector<Event> events_;
+    // live tensors by OrtValue index: index in allocations_ and the allocator the tensor came from
+    InlinedHashMap<int, std::pair<size_t, IAllocator*>> live_;
+  };
+
+  RuntimeMemoryProfiler() = default;
+
+  std::unique_ptr<RunRecorder> StartRun() { return std::make_unique<RunRecorder>(*this); }
+
+  /**
+   * Returns a JSON document with the number of runs profiled and, for the run with the highest peak, the lifetime of
+   * every tensor, the timeline of allocations and frees, and per device the tensors that are live at the peak with
+   * the internal and external fragmentation of the arena at that point.
+   */
+  std::string Report(const SessionState& session_state) const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RuntimeMemoryProfiler);
+
+  struct Run {
+    std::vector<Allocation> allocations;
+    std::vector<Event> events;
+    size_t peak_bytes = 0;
+  };
+
+  void AddRun(Run run);
+
+  mutable OrtMutex mutex_;
+  size_t num_runs_{0};
+  std::optional<Run> peak_run_;
+};
+
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/framework/sequential_executor.h"
 
 #include <chrono>
+#include <optional>
 #include <thread>
 #include <vector>
 #include <sstream>
@@ -14,6 +15,7 @@
 #include "core/framework/stream_execution_context.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/run_latency_breakdown.h"
 #include "core/framework/utils.h"
 
 #if defined DEBUG_NODE_INPUTS_OUTPUTS
@@ -154,8 +156,10 @@ std::string ComposeSeriesName(const GraphViewer& graph_viewer) {
 class SessionScope {
  public:
   friend class KernelScope;
-  SessionScope(const SessionState& session_state, const ExecutionFrame& frame)
-      : session_state_(session_state)
+  SessionScope(const SessionState& session_state, const ExecutionFrame& frame,
+               RunLatencyBreakdown* latency_breakdown = nullptr)
+      : session_state_(session_state),
+        latency_breakdown_(latency_breakdown)
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
         ,
         frame_(frame)
@@ -178,6 +182,7 @@ class SessionScope {
   {
     if (session_state_.Profiler().IsEnabled()) {
       session_start_ = session_state.Profiler().Start();
+      thread_pool_telemetry_start_ = concurrency::ThreadPool::GetTelemetry(session_state_.GetThreadPool());
     }
 
     auto& logger = session_state_.Logger();
@@ -225,7 +230,11 @@ class SessionScope {
 #endif
 
     if (session_state_.Profiler().IsEnabled()) {
-      session_state_.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", session_start_);
+      // includes the work of concurrent runs sharing the intra-op thread pool
+      const auto thread_pool_telemetry =
+          concurrency::ThreadPool::GetTelemetry(session_state_.GetThreadPool()).Since(thread_pool_telemetry_start_);
+      session_state_.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", session_start_,
+                                                      {{"thread_pool_telemetry", thread_pool_telemetry.ToJson()}});
     }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     auto& logger = session_state_.Logger();
@@ -249,7 +258,9 @@ class SessionScope {
 
  private:
   const SessionState& session_state_;
+  RunLatencyBreakdown* latency_breakdown_;
   TimePoint session_start_;
+  concurrency::ThreadPoolTelemetry thread_pool_telemetry_start_;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   const ExecutionFrame& frame_;
   // Whether memory profiler need create events and flush to file.
@@ -336,6 +347,8 @@ class KernelScope {
     node_compute_range_.Begin();
 #endif
 
+    sampling_node_stats_ = session_state_.GetSamplingProfilerNodeStats(kernel_.Node().Index());
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& node = kernel.Node();
       node_name_ = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
@@ -346,17 +359,38 @@ class KernelScope {
                                      sync_time_begin,
                                      {{"op_name", kernel_.KernelDef().OpName()}});
       concurrency::ThreadPool::StartProfiling(session_state_.GetThreadPool());
+      if (profiler.IsThreadPoolTraceEnabled()) {
+        trace_scope_.emplace(profiler, node_name_);
+      }
       VLOGS(session_state_.Logger(), 1) << "Computing kernel: " << node_name_;
       kernel_begin_time_ = session_state_.Profiler().Start();
       CalculateTotalInputSizes(&kernel_context, &kernel_,
                                input_activation_sizes_, input_parameter_sizes_,
                                node_name_, input_type_shape_);
     }
+
+    if (sampling_node_stats_ != nullptr) {
+      sampling_begin_time_ = std::chrono::high_resolution_clock::now();
+    }
+
+    if (session_scope_.latency_breakdown_ != nullptr) {
+      latency_begin_time_ = std::chrono::high_resolution_clock::now();
+    }
   }
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelScope);
 
   ~KernelScope() {
+    if (session_scope_.latency_breakdown_ != nullptr) {
+      session_scope_.latency_breakdown_->AddKernel(kernel_.KernelDef().Provider(), kernel_.KernelDef().OpName(),
+                                                   latency_begin_time_);
+    }
+
+    if (sampling_node_stats_ != nullptr) {
+      session_state_.Profiler().GetSamplingProfiler()->Record(*sampling_node_stats_, sampling_begin_time_,
+                                                              std::chrono::high_resolution_clock::now());
+    }
+
 #ifdef ENABLE_NVTX_PROFILE
     node_compute_range_.End();
 #endif
@@ -409,9 +443,14 @@ class KernelScope {
 
  private:
   TimePoint kernel_begin_time_;
+  profiling::SamplingProfiler::NodeStats* sampling_node_stats_{nullptr};
+  TimePoint sampling_begin_time_;
+  TimePoint latency_begin_time_;
   SessionScope& session_scope_;
   const SessionState& session_state_;
   std::string node_name_;
+  // parent of the thread pool work and arena extensions of the kernel in the thread pool trace
+  std::optional<profiling::TraceScope> trace_scope_;
   OpKernelContextInternal& kernel_context_;
   const OpKernel& kernel_;
 
@@ -531,7 +570,13 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 #endif
                                    const bool& terminate_flag,
                                    const bool only_execute_path_to_fetches,
-                                   bool single_thread_mode) {
+                                   bool single_thread_mode,
+                                   RunLatencyBreakdown* latency_breakdown) {
+  TimePoint planning_start;
+  if (latency_breakdown != nullptr) {
+    planning_start = std::chrono::high_resolution_clock::now();
+  }
+
   auto* execution_plan = session_state.GetExecutionPlan();
   VLOGS(logger, 0) << "Number of streams: " << execution_plan->execution_plan.size();
   int32_t valid_streams = 0;
@@ -574,7 +619,11 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
   ORT_UNUSED_PARAMETER(only_execute_path_to_fetches);
 #endif
 
-  SessionScope session_scope(session_state, ctx.GetExecutionFrame());
+  if (latency_breakdown != nullptr) {
+    latency_breakdown->AddPhase(RunLatencyBreakdown::Phase::kAllocationAndPlanning, planning_start);
+  }
+
+  SessionScope session_scope(session_state, ctx.GetExecutionFrame(), latency_breakdown);
 
   auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
 
@@ -604,9 +653,15 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
     }
 
     if (all_tensors) {
+      if (latency_breakdown != nullptr) {
+        planning_start = std::chrono::high_resolution_clock::now();
+      }
       MemoryPatternGroup mem_patterns;
       ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GeneratePatterns(mem_patterns));
       ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, std::move(mem_patterns)));
+      if (latency_breakdown != nullptr) {
+        latency_breakdown->AddPhase(RunLatencyBreakdown::Phase::kAllocationAndPlanning, planning_start);
+      }
     }
   }
 
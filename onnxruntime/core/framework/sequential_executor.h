@@ -23,6 +23,7 @@ namespace onnxruntime {
 
 class StreamExecutionContext;
 class DeviceStreamCollection;
+class RunLatencyBreakdown;
 class SessionScope;
 
 #ifdef ENABLE_TRAINING
@@ -46,7 +47,8 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 #endif
                                    const bool& terminate_flag,
                                    const bool only_execute_path_to_fetches,
-                                   bool single_thread_mode);
+                                   bool single_thread_mode,
+                                   RunLatencyBreakdown* latency_breakdown = nullptr);
 
 #ifdef ENABLE_TRAINING
 onnxruntime::Status PartialExecuteThePlan(const SessionState& session_state, gsl::span<const int> feed_mlvalue_idxs,
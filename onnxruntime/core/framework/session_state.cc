@@ -101,6 +101,11 @@ SessionState::SessionState(Graph& graph,
         allocators_->insert({alloc->Info().device, alloc});  // DONT overwrite existing key
       }
     }
+
+    // subgraphs are executed within a node of the main graph, so only the main graph has a memory profiler
+    if (sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableMemoryProfile, "0") == "1") {
+      runtime_memory_profiler_ = std::make_unique<RuntimeMemoryProfiler>();
+    }
   }
 }
 
@@ -213,7 +218,17 @@ const KernelCreateInfo& SessionState::GetNodeKernelCreateInfo(NodeIndex node_ind
   return *entry->second;
 }
 
-Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager) {
+// Kernels and PrePack calls that may run concurrently during session initialization.
+// Other execution providers may rely on being called from a single thread, control flow
+// kernels interact with the subgraph session states, and kernels from custom registries
+// (e.g. custom ops) make no thread safety guarantee.
+static bool CanInitializeConcurrently(const Node& node, const KernelRegistryManager& kernel_registry_manager) {
+  return node.GetExecutionProviderType() == kCpuExecutionProvider && !node.ContainsSubgraph() &&
+         !kernel_registry_manager.HasCustomKernel(node);
+}
+
+Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager,
+                                   concurrency::ThreadPool* thread_pool) {
   const auto& nodes = graph_viewer_->Nodes();
   if (!nodes.empty()) {
     size_t max_nodeid = 0;
@@ -222,7 +237,9 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
     }
     session_kernels_.clear();
     session_kernels_.resize(max_nodeid + 1);
-    for (const auto& node : nodes) {
+    initialize_concurrently_.assign(max_nodeid + 1, false);
+
+    auto create_kernel = [this, &kernel_registry_manager](const Node& node) -> Status {
       // construct and save the kernels
       const KernelCreateInfo& kci = GetNodeKernelCreateInfo(node.Index());
 
@@ -231,7 +248,28 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       const IExecutionProvider& exec_provider = *execution_providers_.Get(exec_provider_name);
 
       // assumes vector is already resize()'ed to the number of nodes in the graph
-      ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]));
+      return kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]);
+    };
+
+    InlinedVector<const Node*> concurrent_nodes;
+    for (const auto& node : nodes) {
+      if (thread_pool != nullptr && CanInitializeConcurrently(node, kernel_registry_manager)) {
+        initialize_concurrently_[node.Index()] = true;
+        concurrent_nodes.push_back(&node);
+      } else {
+        ORT_RETURN_IF_ERROR(create_kernel(node));
+      }
+    }
+
+    ORT_RETURN_IF_ERROR(session_state_utils::ParallelForWithStatus(
+        thread_pool, concurrent_nodes.size(), [&](size_t i) { return create_kernel(*concurrent_nodes[i]); }));
+
+    if (auto* sampling_profiler = profiler_.GetSamplingProfiler()) {
+      sampling_node_stats_.assign(max_nodeid + 1, nullptr);
+      for (const auto& node : nodes) {
+        std::string name = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
+        sampling_node_stats_[node.Index()] = sampling_profiler->AddNode(std::move(name), node.OpType());
+      }
     }
   }
   node_index_info_.emplace(*graph_viewer_, ort_value_name_idx_map_);
@@ -394,8 +432,100 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
   return ss_1.str();
 }
 
+Status SessionState::ParallelPrepackConstantInitializedTensors(
+    InlinedHashMap<std::string, size_t>& constant_initializers_use_count, concurrency::ThreadPool* thread_pool) {
+  struct PrePackInput {
+    int input_idx;
+    const std::string* input_name;
+    SessionState* owner;  // session state holding the initializer, may be an outer scope one
+    int ort_value_idx;
+    const Tensor* tensor;
+    bool is_packed;
+  };
+
+  struct KernelPrePack {
+    OpKernel* kernel;
+    AllocatorPtr allocator;
+    InlinedVector<PrePackInput> inputs;
+  };
+
+  // 1. find the constant initializers consumed by each kernel, searching outer scopes like the serial version
+  std::vector<KernelPrePack> serial_prepacks;
+  std::vector<KernelPrePack> concurrent_prepacks;
+  for (auto& node : GetGraphViewer().Nodes()) {
+    KernelPrePack prepack{GetMutableKernel(node.Index()), nullptr, {}};
+    int input_idx = 0;
+    for (auto& input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        const std::string& input_name = input_def->Name();
+        SessionState* st = this;
+        do {
+          int ort_value_idx;
+          if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+            auto entry = st->constant_initialized_tensors_.find(ort_value_idx);
+            if (entry != st->constant_initialized_tensors_.end()) {
+              prepack.inputs.push_back(
+                  PrePackInput{input_idx, &input_name, st, ort_value_idx, &entry->second.Get<Tensor>(), false});
+            }
+            if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+              break;
+            }
+          }
+          st = st->Parent();
+        } while (st);
+      }
+      input_idx++;
+    }
+
+    if (!prepack.inputs.empty()) {
+      prepack.allocator = GetAllocator(prepack.kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+      (initialize_concurrently_[node.Index()] ? concurrent_prepacks : serial_prepacks).push_back(std::move(prepack));
+    }
+  }
+
+  // 2. pre-pack. The inputs of one kernel are always handled by the same thread as PrePack updates the kernel.
+  auto prepack_kernel = [](KernelPrePack& prepack) -> Status {
+    for (auto& input : prepack.inputs) {
+      ORT_RETURN_IF_ERROR(prepack.kernel->PrePack(*input.tensor, input.input_idx,
+                                                  prepack.allocator,  // use allocator tied to this session
+                                                  input.is_packed,
+                                                  nullptr  // no caching required
+                                                  ));
+    }
+    return Status::OK();
+  };
+
+  for (auto& prepack : serial_prepacks) {
+    ORT_RETURN_IF_ERROR(prepack_kernel(prepack));
+  }
+  ORT_RETURN_IF_ERROR(session_state_utils::ParallelForWithStatus(
+      thread_pool, concurrent_prepacks.size(), [&](size_t i) { return prepack_kernel(concurrent_prepacks[i]); }));
+
+  // 3. release the constant initialized tensors that every consumer has pre-packed
+  for (auto* prepacks : {&serial_prepacks, &concurrent_prepacks}) {
+    for (const auto& prepack : *prepacks) {
+      for (const auto& input : prepack.inputs) {
+        if (!input.is_packed) {
+          continue;
+        }
+
+        ++number_of_prepacks_counter_;
+        const std::string& input_name = *input.input_name;
+        if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
+          // release the constant initialized tensor
+          input.owner->initialized_tensors_.erase(input.ort_value_idx);
+          input.owner->constant_initialized_tensors_.erase(input.ort_value_idx);
+        }
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
 Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
+                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                                       concurrency::ThreadPool* thread_pool) {
   auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
                                         bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
     for (auto& node : GetGraphViewer().Nodes()) {
@@ -417,7 +547,8 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
                 const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
 
                 auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
+                bool is_shared_initializer = (iter != initializers_to_share_map.end()) ||
+                                             st->shared_initializer_names_.count(input_name) > 0;
 
                 // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
                 if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
@@ -513,6 +644,10 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
 
   bool should_cache_prepacked_weights_for_shared_initializers = (prepacked_weights_container_ != nullptr);
 
+  if (!should_cache_prepacked_weights_for_shared_initializers && thread_pool != nullptr) {
+    return ParallelPrepackConstantInitializedTensors(constant_initializers_use_count, thread_pool);
+  }
+
   if (should_cache_prepacked_weights_for_shared_initializers) {
     // serialize calls to the method that looks up the container, calls UseCachedPrePackedWeight/PrePack
     // and writes pre-packed weights to the container
@@ -523,10 +658,25 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
   }
 }
 
-static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
-  int64_t key = 0;
+// The key is the exact shape signature of the inputs: the rank followed by the dims of each input.
+// It must not collide, as different input shapes (e.g. {2, 3} and {3, 2}) generally need different memory patterns.
+static std::string CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
+  size_t num_values = 0;
   for (const auto& input : tensor_inputs) {
-    for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+    num_values += 1 + input.Get<Tensor>().Shape().NumDimensions();
+  }
+
+  std::string key;
+  key.reserve(num_values * sizeof(int64_t));
+  auto append = [&key](int64_t value) {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  for (const auto& input : tensor_inputs) {
+    const auto dims = input.Get<Tensor>().Shape().GetDims();
+    append(static_cast<int64_t>(dims.size()));
+    for (auto dim : dims) {
+      append(dim);
+    }
   }
   return key;
 }
@@ -772,10 +922,11 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
     gsl::span<const int> feed_mlvalue_idxs,
     const InlinedHashMap<int, TensorShape>*& out_inferred_shapes) const {
   out_inferred_shapes = nullptr;
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  const std::string key = CalculateMemoryPatternsKey(tensor_inputs);
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
   auto it = mem_patterns_.find(key);
   if (it == mem_patterns_.end()) {
+    ++mem_pattern_cache_misses_;
 #ifdef ENABLE_TRAINING
     MemoryPatternGroup mem_patterns;
     InlinedHashMap<int, TensorShape> inferred_shapes;
@@ -792,6 +943,7 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
     return nullptr;
   }
 
+  ++mem_pattern_cache_hits_;
   auto patt_hit = shape_patterns_.find(key);
   if (patt_hit != shape_patterns_.cend()) {
     out_inferred_shapes = &patt_hit->second;
@@ -847,14 +999,20 @@ void SessionState::ResolveMemoryPatternFlag() {
 
 Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                                    MemoryPatternGroup mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  std::string key = CalculateMemoryPatternsKey(tensor_inputs);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
   // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+  mem_patterns_.emplace(std::move(key), std::move(mem_patterns));
   return Status::OK();
 }
 
+void SessionState::GetMemoryPatternCacheStats(uint64_t& hits, uint64_t& misses) const {
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  hits = mem_pattern_cache_hits_;
+  misses = mem_pattern_cache_misses_;
+}
+
 bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_; }
 
 bool SessionState::GetEnableMemoryReuse() const { return sess_options_.enable_mem_reuse; }
@@ -1420,6 +1578,11 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   // For inference it is enabled by default, but users can choose to disable it via session options.
   const bool disable_prepacking =
       session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisablePrepacking, "0") == "1";
+  // Loading initializers, creating kernels and pre-packing can use the intra-op thread pool.
+  concurrency::ThreadPool* initialization_thread_pool =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigParallelInitialization, "0") == "1"
+          ? thread_pool_
+          : nullptr;
   // Memory pattern tracer allocates all initializers on a single contiguous
   // buffer. This has the effect of reducing memory fragmentation.
   // Further more, in training scenarios NCCL kernels require initializers to be allocated
@@ -1473,6 +1636,27 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 #endif
 
+  // Times the initialization phases below when profiling is enabled
+  TimePoint phase_start;
+  auto start_phase = [this, &phase_start]() {
+    if (profiler_.IsEnabled()) {
+      phase_start = profiler_.Start();
+    }
+  };
+  auto end_phase = [this, &phase_start, parent_node](const std::string& phase_name) {
+    if (profiler_.IsEnabled()) {
+      profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, phase_name, phase_start,
+                                      {{"subgraph_of", parent_node ? parent_node->Name() : ""}});
+    }
+  };
+
+  // initializers are shared with the other sessions using the same container for pre-packed weights
+  const bool share_initializers =
+      prepacked_weights_container_ != nullptr &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShareInitializersAcrossSessions,
+                                                        "0") == "1";
+
+  start_phase();
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInitializedTensors(
           Env::Default(), graph_location, *graph_viewer_,
@@ -1486,7 +1670,10 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
             }
             return Status::OK();
           },
-          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func));
+          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func,
+          initialization_thread_pool, share_initializers ? prepacked_weights_container_ : nullptr,
+          &shared_initializer_names_));
+  end_phase("session_state_save_initialized_tensors");
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1500,11 +1687,16 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
-  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  start_phase();
+  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager, initialization_thread_pool));
+  end_phase("session_state_create_kernels");
 
   if (!disable_prepacking) {
+    start_phase();
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
-                                                          session_options.initializers_to_share_map));
+                                                          session_options.initializers_to_share_map,
+                                                          initialization_thread_pool));
+    end_phase("session_state_prepack");
   }
 
   ORT_RETURN_IF_ERROR(
@@ -24,6 +24,7 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/runtime_memory_profiler.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
@@ -203,6 +204,19 @@ class SessionState {
   */
   profiling::Profiler& Profiler() const noexcept { return profiler_; }
 
+  /**
+  Get the stats of a node in the sampling profiler, or nullptr if the sampling profiler is not enabled.
+  */
+  profiling::SamplingProfiler::NodeStats* GetSamplingProfilerNodeStats(NodeIndex node_index) const noexcept {
+    return node_index < sampling_node_stats_.size() ? sampling_node_stats_[node_index] : nullptr;
+  }
+
+  /**
+  Get the memory profiler enabled by the session option "session.memory_profile_enable", or nullptr if it is not
+  enabled. Only the main graph has one.
+  */
+  RuntimeMemoryProfiler* GetRuntimeMemoryProfiler() const noexcept { return runtime_memory_profiler_.get(); }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler* GetMemoryProfiler() const noexcept { return memory_profiler_; }
 
@@ -233,6 +247,12 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                        MemoryPatternGroup mem_patterns) const;
 
+  /**
+  Get the number of GetMemoryPatternGroup calls that found a cached memory pattern for the input shapes (hits)
+  and that did not (misses).
+  */
+  void GetMemoryPatternCacheStats(uint64_t& hits, uint64_t& misses) const;
+
   bool GetUseDeterministicCompute() const { return sess_options_.use_deterministic_compute; }
 
   /**
@@ -361,8 +381,9 @@ class SessionState {
   // Populate OrtValueNameIdxMap and create the graph viewer.
   void CreateGraphInfo();
 
-  // create kernels using info in kernel_create_info_map_
-  Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
+  // create kernels using info in kernel_create_info_map_.
+  // CPU kernels are created concurrently if thread_pool is not null.
+  Status CreateKernels(const KernelRegistryManager& custom_registry_manager, concurrency::ThreadPool* thread_pool);
 
   // remove TensorProto versions of initializers from Graph instance
   // (replaced byOrtValue instances in initialized_tensors_)
@@ -373,7 +394,15 @@ class SessionState {
    * The original constant initialized tensors will be removed to save memory.
    */
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
+                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                           concurrency::ThreadPool* thread_pool);
+
+  /**
+   * Same as PrepackConstantInitializedTensors without caching of pre-packed weights, but the PrePack calls of
+   * different CPU kernels run concurrently on thread_pool.
+   */
+  Status ParallelPrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
+                                                   concurrency::ThreadPool* thread_pool);
 
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
@@ -410,6 +439,8 @@ class SessionState {
 
   // cache of the constructed kernels to avoid spending construction time per executor
   std::vector<std::unique_ptr<OpKernel>> session_kernels_;
+  // whether the kernel of a node, by node index, is created and pre-packed concurrently with other kernels
+  std::vector<bool> initialize_concurrently_;
   Graph& graph_;
   std::optional<GraphViewer> graph_viewer_;  // GraphViewer for const access to Graph
 
@@ -477,6 +508,11 @@ class SessionState {
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
 
+  // stats of the nodes in the sampling profiler, by node index. empty if the sampling profiler is not enabled.
+  std::vector<profiling::SamplingProfiler::NodeStats*> sampling_node_stats_;
+
+  std::unique_ptr<RuntimeMemoryProfiler> runtime_memory_profiler_;
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler* memory_profiler_;
 #endif
@@ -486,16 +522,19 @@ class SessionState {
 
   // lock for the mem_patterns_
   mutable OrtMutex mem_patterns_lock_;
-  // cache for the generated mem_patterns. key is calculated based on input shapes.
+  // cache for the generated mem_patterns. key is the shape signature of the inputs.
   // must be a node based container as a pointer is cached.
-  mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
+  mutable NodeHashMap<std::string, MemoryPatternGroup> mem_patterns_;
   // This is mutable under mutex in training scenarios so execution frame would make a copy
   // of the value when created.
 #ifdef ENABLE_TRAINING
-  mutable NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
+  mutable NodeHashMap<std::string, InlinedHashMap<int, TensorShape>> shape_patterns_;
 #else
-  NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
+  NodeHashMap<std::string, InlinedHashMap<int, TensorShape>> shape_patterns_;
 #endif
+  // lookups of mem_patterns_. GUARDED_BY(mem_patterns_lock_)
+  mutable uint64_t mem_pattern_cache_hits_ = 0;
+  mutable uint64_t mem_pattern_cache_misses_ = 0;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -518,6 +557,10 @@ class SessionState {
   // prepacked_weights_container_ can be nullptr if no caching is required for prepacked weights
   PrepackedWeightsContainer* const prepacked_weights_container_{};
 
+  // Names of the initializers shared with other sessions through prepacked_weights_container_ when the
+  // "session.share_initializers_across_sessions" config option is set.
+  InlinedHashSet<std::string> shared_initializer_names_;
+
 #ifdef ENABLE_TRAINING
 // Needed for ORTTrainer. Should be removed along with ORTTrainer code
 #ifndef DISABLE_ABSEIL
@@ -18,6 +18,7 @@
 #include "core/framework/ort_value.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/prepacked_weights_container.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
@@ -26,6 +27,7 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -93,6 +95,23 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
                   "DeserializeTensorProto() takes either pre-allocated buffer or an allocator!");
   }
 
+  // NB: The file containing external data for the tensor is mmap'd. If the tensor will be used on CPU we
+  // utilize the mmap'd buffer directly by calling ExtDataTensorProtoToTensor, before any memory is allocated for it.
+  // Pages are only faulted in when a kernel first reads them, and the mapping is released together with the
+  // OrtValue, e.g. once all consumers have pre-packed the weight.
+  const OrtDevice& device = (m != nullptr) ? m->GetAllocInfo().device : alloc->Info().device;
+  if (device.Type() == OrtDevice::CPU && utils::HasExternalData(tensor_proto)) {
+    auto p_tensor = std::make_unique<Tensor>();
+    OrtCallback ext_data_deleter;
+    ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor, ext_data_deleter));
+
+    ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
+
+    MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
+    ort_value.Init(p_tensor.release(), ml_tensor_type, deleter);
+    return common::Status::OK();
+  }
+
   // Get shape and type of the tensor, and allocate the empty tensor
   TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
   const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
@@ -118,19 +137,6 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
 
   if (p_tensor->Location().device.Type() == OrtDevice::CPU) {
     // deserialize directly to CPU tensor
-    if (utils::HasExternalData(tensor_proto)) {
-      // NB: The file containing external data for the tensor is mmap'd. If the tensor will be used on CPU we can
-      // utilize the mmap'd buffer directly by calling ExtDataTensorProtoToTensor. If we called
-      // TensorProtoToTensor it would copy the data, causing unnecessary overhead
-      OrtCallback ext_data_deleter;
-      ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor, ext_data_deleter));
-
-      ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
-
-      MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
-      ort_value.Init(p_tensor.release(), ml_tensor_type, deleter);
-      return common::Status::OK();
-    }
     ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_tensor));
   } else {  // non-cpu tensor
     if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
@@ -187,8 +193,12 @@ common::Status SaveInitializedTensors(
     const logging::Logger& logger, const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func) {
+    const MemoryProfileFunction& memory_profile_func,
+    concurrency::ThreadPool* thread_pool,
+    PrepackedWeightsContainer* shared_initializers_container,
+    InlinedHashSet<std::string>* shared_initializer_names) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
+  ORT_ENFORCE(shared_initializers_container == nullptr || shared_initializer_names != nullptr);
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
   // Determine if an intializer was supplied by the user for the purpose of sharing and if it requires a cross-device
@@ -220,10 +230,23 @@ common::Status SaveInitializedTensors(
     return retval;
   };
 
+  // Constant CPU initializers with raw data can be shared with other sessions. Small ones are not worth hashing.
+  constexpr size_t kMinSharedInitializerBytes = 1024;
+  auto can_share_initializer = [&](int ort_value_index, const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+    return shared_initializers_container != nullptr &&
+           exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU &&
+           utils::HasRawData(tensor_proto) && tensor_proto.raw_data().size() >= kMinSharedInitializerBytes &&
+           graph.IsConstantInitializer(tensor_proto.name(), /* check_outer_scope */ false);
+  };
+
   // 1. first plan the memory
   const InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   InlinedHashMap<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
   InlinedHashSet<int> user_supplied_initializer_ids;  // set containing the ort value ids of all user supplied initializers
+  // initializers shared with other sessions that are already in the container
+  InlinedHashMap<int, OrtValue> initializers_from_container;
+  // initializers to share with other sessions, with their key in the container
+  InlinedHashMap<int, std::string> initializers_to_add_to_container;
 
   id_to_initialized_tensor.reserve(initialized_tensor_set.size());
   user_supplied_initializer_ids.reserve(initialized_tensor_set.size());
@@ -233,10 +256,23 @@ common::Status SaveInitializedTensors(
     ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(entry.first, ort_value_index));
     if (use_user_supplied_initializer(entry.first)) {
       user_supplied_initializer_ids.insert(ort_value_index);
+    } else if (can_share_initializer(ort_value_index, *entry.second)) {
+      std::string key;
+      if (const OrtValue* shared = shared_initializers_container->GetSharedInitializer(*entry.second, key)) {
+        initializers_from_container.emplace(ort_value_index, *shared);
+      } else {
+        initializers_to_add_to_container.emplace(ort_value_index, std::move(key));
+      }
     }
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
 
+  // shared initializers are not part of the weights buffer of this session
+  auto is_shared_initializer = [&](int ort_value_index) {
+    return initializers_from_container.count(ort_value_index) > 0 ||
+           initializers_to_add_to_container.count(ort_value_index) > 0;
+  };
+
   // tensors requiring a specific allocation order are traced first, to ensure they are allocated in order
   // NB1: vector with init allocation order may contain a subset of all tensors (or none at all)
   // NB2: only skip tracing and planning memory when data is external (i.e mmap) and on CPU.
@@ -246,7 +282,8 @@ common::Status SaveInitializedTensors(
     const auto entry = initialized_tensors_to_allocate.find(ort_value_index);
     ORT_ENFORCE(entry != initialized_tensors_to_allocate.end(),
                 "OrtValue index: ", ort_value_index, " from initializer_allocation_order not found among initialized tensors");
-    if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU)) {
+    if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU) &&
+        !is_shared_initializer(ort_value_index)) {
       // can not trace string tensor
       ORT_ENFORCE(entry->second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING, "Can not trace string tensor");
       ORT_RETURN_IF_ERROR(planner.Trace(entry->first, entry->second));
@@ -256,13 +293,18 @@ common::Status SaveInitializedTensors(
 
   for (const auto& entry : initialized_tensors_to_allocate) {
     // We don't want to trace shared initializers since their memory is provided by the user
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
+    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end() ||
+        is_shared_initializer(entry.first)) {
       continue;
     }
     if (entry.second->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
       // do not trace string tensor
       continue;
     }
+    // external data used on CPU is memory mapped in place so it needs no room in the weights buffer
+    if (utils::HasExternalData(*entry.second) && exec_plan.GetLocation(entry.first).Type() == OrtDevice::CPU) {
+      continue;
+    }
     ORT_RETURN_IF_ERROR(planner.Trace(entry.first, entry.second));
   }
   // 2. allocate weight buffer on different locations
@@ -283,6 +325,24 @@ common::Status SaveInitializedTensors(
   OrtCallback deleter{nullptr, nullptr};
 
   // 3. create weight tensors based on weights buffer
+  // The preallocated buffers are looked up on this thread as the planner is not thread safe.
+  // Initializers planned on CPU are then deserialized in parallel if a thread pool is provided, which also
+  // overlaps the reads of external data. Initializers for other devices are copied on this thread.
+  struct InitializerToSave {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    std::optional<MemBuffer> m;
+    AllocatorPtr alloc;
+    OrtValue ort_value;
+  };
+
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+
+  std::vector<InitializerToSave> initializers;
+  initializers.reserve(id_to_initialized_tensor.size());
+  InlinedVector<size_t> serial_deserialization;
+  InlinedVector<size_t> parallel_deserialization;
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
     const std::string& name = entry.second->name();
@@ -292,43 +352,80 @@ common::Status SaveInitializedTensors(
       continue;
     }
 
-    OrtValue ort_value;
+    auto& initializer = initializers.emplace_back();
+    initializer.ort_value_index = ort_value_index;
+    initializer.tensor_proto = entry.second;
 
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
-      ort_value = *(session_options.initializers_to_share_map.at(name));
+      initializer.ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
+    } else if (auto shared = initializers_from_container.find(ort_value_index);
+               shared != initializers_from_container.end()) {
+      initializer.ort_value = shared->second;
+      shared_initializer_names->insert(name);
+      LOGS(logger, INFO) << "Using initializer with name (" << name << ") shared with another session.";
     } else {
-      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
-
-      std::optional<MemBuffer> m;
-      AllocatorPtr alloc;
-      // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
-
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
-                                         default_cpu_alloc, ort_value, data_transfer_mgr,
-                                         use_device_allocator_for_initializers);
-      if (!st.IsOK()) {
-        std::ostringstream oss;
-        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-        return Status(st.Category(), st.Code(), oss.str());
+      if (initializers_to_add_to_container.count(ort_value_index) > 0) {
+        // allocated by the container so it can outlive this session
+        std::lock_guard<OrtMutex> lock(shared_initializers_container->mutex_);
+        initializer.alloc = shared_initializers_container->GetOrCreateAllocator(CPU);
+      } else {
+        // TODO: if the tensor need be copied, does it have enough room?
+        ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, initializer.m, initializer.alloc));
+      }
+      if (thread_pool != nullptr && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU) {
+        parallel_deserialization.push_back(initializers.size() - 1);
+      } else {
+        serial_deserialization.push_back(initializers.size() - 1);
       }
     }
+  }
+
+  auto deserialize = [&](InitializerToSave& initializer) -> Status {
+    const ONNX_NAMESPACE::TensorProto& tensor_proto = *initializer.tensor_proto;
+    Status st = DeserializeTensorProto(env, graph_loc, tensor_proto,
+                                       (initializer.m.has_value()) ? &*initializer.m : nullptr, initializer.alloc,
+                                       default_cpu_alloc, initializer.ort_value, data_transfer_mgr,
+                                       use_device_allocator_for_initializers);
+    if (!st.IsOK()) {
+      std::ostringstream oss;
+      oss << "Deserialize tensor " << tensor_proto.name() << " failed." << st.ErrorMessage();
+      return Status(st.Category(), st.Code(), oss.str());
+    }
+    return Status::OK();
+  };
+
+  ORT_RETURN_IF_ERROR(ParallelForWithStatus(thread_pool, parallel_deserialization.size(), [&](size_t i) {
+    return deserialize(initializers[parallel_deserialization[i]]);
+  }));
+  for (size_t i : serial_deserialization) {
+    ORT_RETURN_IF_ERROR(deserialize(initializers[i]));
+  }
+
+  // 4. hand the weights over in a deterministic order
+  for (auto& initializer : initializers) {
+    const int ort_value_index = initializer.ort_value_index;
+    const std::string& name = initializer.tensor_proto->name();
 
     // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
     // so we need to output this message prior to calling save_tensor_func
     VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << ort_value_index;
 
+    if (auto to_add = initializers_to_add_to_container.find(ort_value_index);
+        to_add != initializers_to_add_to_container.end()) {
+      initializer.ort_value = shared_initializers_container->AddSharedInitializer(to_add->second,
+                                                                                 initializer.ort_value);
+      shared_initializer_names->insert(name);
+    }
+
     // any outer scope value is shadowed by a local value and can't override it.
     // due to that check_outer_scope is false
     const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
 #if !defined(DISABLE_SPARSE_TENSORS)
     const bool sparse = graph.GetGraph().IsSparseInitializer(name);
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, sparse));
+    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, initializer.ort_value, deleter, constant, sparse));
 #else
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, false));
+    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, initializer.ort_value, deleter, constant, false));
 #endif
   }
 
@@ -336,6 +433,32 @@ common::Status SaveInitializedTensors(
   return common::Status::OK();
 }
 
+common::Status ParallelForWithStatus(concurrency::ThreadPool* thread_pool, size_t count,
+                                     const std::function<common::Status(size_t)>& fn) {
+  if (count == 0) {
+    return Status::OK();
+  }
+
+  std::vector<Status> statuses(count);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(count), [&statuses, &fn](std::ptrdiff_t i) {
+        Status& status = statuses[static_cast<size_t>(i)];
+        ORT_TRY {
+          status = fn(static_cast<size_t>(i));
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+          });
+        }
+      });
+
+  for (const auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+  return Status::OK();
+}
+
 template <typename T>  // T is container of const NodeArg* or NodeArg*
 static bool IsArgNameInInputsOutputs(const std::string& name,
                                      const T& graph_args) {
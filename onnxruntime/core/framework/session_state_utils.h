@@ -2,9 +2,11 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <functional>
 #include <map>
 
 #include "core/common/const_pointer_container.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/allocator.h"
 #include "core/framework/tensor.h"
 #include "core/framework/tensor_allocator.h"
@@ -16,6 +18,7 @@ namespace onnxruntime {
 class Env;
 class KernelRegistryManager;
 class Node;
+class PrepackedWeightsContainer;
 class SessionState;
 class GraphViewer;
 class OrtValueNameIdxMap;
@@ -29,11 +32,18 @@ namespace logging {
 class Logger;
 }
 
+namespace concurrency {
+class ThreadPool;
+}
+
 namespace session_state_utils {
 using SaveTensorFunction = std::function<Status(const std::string& name, int idx, const OrtValue& value,
                                                 const OrtCallback& d, bool constant, bool sparse)>;
 using MemoryProfileFunction = std::function<void(ITensorAllocator& planner)>;
 
+/// If shared_initializers_container is not null, constant CPU initializers are shared with the other sessions using
+/// the container: an identical initializer in the container is used instead of creating a new one, and new ones are
+/// allocated by and added to the container. The names of these initializers are added to shared_initializer_names.
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_memory_info,
@@ -44,7 +54,16 @@ common::Status SaveInitializedTensors(
     const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func);
+    const MemoryProfileFunction& memory_profile_func,
+    concurrency::ThreadPool* thread_pool,
+    PrepackedWeightsContainer* shared_initializers_container = nullptr,
+    InlinedHashSet<std::string>* shared_initializer_names = nullptr);
+
+/// Runs fn(i) for every i in [0, count). The calls are spread over thread_pool if it is not null.
+/// Exceptions thrown by fn are converted to a failed status.
+/// Returns the failed status with the lowest index, or OK.
+common::Status ParallelForWithStatus(concurrency::ThreadPool* thread_pool, size_t count,
+                                     const std::function<common::Status(size_t)>& fn);
 
 common::Status SaveInputOutputNamesToNodeMapping(const GraphViewer& graph,
                                                  SessionState& session_state,
@@ -167,8 +167,12 @@ void StreamExecutionContext::RecycleNodeInputs(onnxruntime::NodeIndex node_index
   auto* execution_plan = session_state_->GetExecutionPlan();
   for (auto idx : execution_plan->node_release_list[node_index]) {
     if (--release_plan_[idx] == 0) {
-      ORT_ENFORCE(frame_.ReleaseMLValue(static_cast<int>(execution_plan->release_actions[idx].value_index)).IsOK());
-      VLOGS(*logger_, 0) << "ort value " << execution_plan->release_actions[idx].value_index << " released";
+      const auto value_index = static_cast<int>(execution_plan->release_actions[idx].value_index);
+      ORT_ENFORCE(frame_.ReleaseMLValue(value_index).IsOK());
+      if (auto* memory_recorder = frame_.GetMemoryRecorder()) {
+        memory_recorder->RecordFree(value_index, node_index);
+      }
+      VLOGS(*logger_, 0) << "ort value " << value_index << " released";
     }
   }
 }
@@ -249,12 +253,25 @@ void ScheduleDownstream(StreamExecutionContext& ctx, size_t trigger, bool single
   auto* plan = ctx.GetSessionState().GetExecutionPlan();
   auto& downstream_map = plan->downstream_map;
   auto* tp = single_thread_mode ? nullptr : ctx.GetSessionState().GetInterOpThreadPool();
+  auto& profiler = ctx.GetSessionState().Profiler();
+  // the hand-off is recorded on the lane of the inter-op worker that picks it up, from the time it is scheduled
+  const bool trace_handoff = profiler.IsThreadPoolTraceEnabled();
   auto it = downstream_map.find(trigger);
   if (it != downstream_map.end()) {
     for (auto downstream : it->second) {
       // increase the task count before schedule down-stream
       ctx.AddTask();
-      concurrency::ThreadPool::Schedule(tp, [&ctx, downstream, &terminate_flag, &session_scope]() {
+      const TimePoint schedule_time = trace_handoff ? std::chrono::high_resolution_clock::now() : TimePoint{};
+      concurrency::ThreadPool::Schedule(tp, [&ctx, tp, trigger, downstream, trace_handoff, schedule_time,
+                                             &profiler, &terminate_flag, &session_scope]() {
+        if (trace_handoff) {
+          const int worker = tp != nullptr ? tp->CurrentThreadId() : -1;
+          profiler.RecordThreadEvent(profiling::THREAD_POOL_EVENT, "stream_handoff", schedule_time,
+                                     worker >= 0 ? MakeString("inter-op worker ", worker) : std::string(),
+                                     {{"trigger", std::to_string(trigger)},
+                                      {"stream", std::to_string(downstream.first)},
+                                      {"step", std::to_string(downstream.second)}});
+        }
         RunSince(downstream.first, ctx, session_scope, terminate_flag, downstream.second);
       });
     }
@@ -4,6 +4,7 @@
 #include "core/graph/graph.h"
 
 #include <cassert>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <numeric>
@@ -943,6 +944,7 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 
 void Node::AddAttributeProto(AttributeProto value) {
   utils::SetNodeAttribute(std::move(value), attributes_);
+  ++attributes_version_;
   if (graph_) {
     graph_->SetGraphResolveNeeded();
     graph_->SetGraphProtoSyncNeeded();
@@ -993,6 +995,7 @@ void Node::AddAttribute(std::string attr_name, GraphProto value) {
 bool Node::ClearAttribute(const std::string& attr_name) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  ++attributes_version_;
   return attributes_.erase(attr_name) > 0;
 }
 
@@ -1001,6 +1004,7 @@ bool Node::ClearAttribute(const std::string& attr_name) {
 int Node::PruneRemovableAttributes(gsl::span<const std::string> removable_attributes) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  ++attributes_version_;
   int n_removed = 0;
   for (const auto& name : removable_attributes) {
     n_removed += static_cast<int>(attributes_.erase(name));
@@ -3019,6 +3023,61 @@ common::Status Graph::TypeCheckInputsAndInitializers() {
   return Status::OK();
 }
 
+std::string Graph::GetNodeInferenceState(const Node& node) const {
+  // upper limit for the size of a constant input whose data is included. inferencing only reads the data of small
+  // inputs such as shapes and axes. the data of larger initializers can only change with ReplaceInitializedTensor.
+  constexpr size_t kMaxConstantInputBytes = 1024;
+
+  std::string state;
+  auto append = [&state](const void* data, size_t size) {
+    state.append(static_cast<const char*>(data), size);
+  };
+  auto append_pointer = [&append](const void* pointer) { append(&pointer, sizeof(pointer)); };
+  auto append_proto = [&state, &append](const google::protobuf::MessageLite* proto) {
+    const size_t offset = state.size();
+    uint64_t size = 0;
+    append(&size, sizeof(size));
+    if (proto != nullptr) {
+      proto->AppendToString(&state);
+      size = state.size() - offset - sizeof(size);
+      std::memcpy(&state[offset], &size, sizeof(size));
+    }
+  };
+
+  append_pointer(node.op_);
+  append(&node.since_version_, sizeof(node.since_version_));
+  append(&node.attributes_version_, sizeof(node.attributes_version_));
+
+  const auto& input_arg_count = node.InputArgCount();
+  const uint64_t num_input_arg_counts = input_arg_count.size();
+  append(&num_input_arg_counts, sizeof(num_input_arg_counts));
+  append(input_arg_count.data(), input_arg_count.size() * sizeof(int));
+
+  bool has_constant_input = false;
+  for (const NodeArg* input_def : node.InputDefs()) {
+    append_pointer(input_def);
+    append_proto(input_def->TypeAsProto());
+
+    const TensorProto* constant = input_def->Exists() ? GetConstantInitializer(input_def->Name(), true) : nullptr;
+    append_pointer(constant);
+    if (constant != nullptr) {
+      has_constant_input = true;
+      append_proto(constant->ByteSizeLong() <= kMaxConstantInputBytes ? constant : nullptr);
+    }
+  }
+
+  if (has_constant_input) {
+    append(&initializers_version_, sizeof(initializers_version_));
+  }
+
+  for (const NodeArg* output_def : node.OutputDefs()) {
+    append_pointer(output_def);
+    append_proto(output_def->TypeAsProto());
+  }
+
+  return state;
+}
+
 Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
   CheckerContext ctx;
   ctx.set_ir_version(gsl::narrow_cast<int>(IrVersion()));
@@ -3050,12 +3109,29 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     lsc.output_names.insert(std::string(input));
   }
 
+  // nodes with subgraphs are always inferred as that is what resolves the subgraphs.
+  // type overrides are applied to every node they are requested for.
+  const bool skip_unchanged_nodes = parent_node_ == nullptr && !options.override_types;
+
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
 
     const auto& node_name = node.Name();
 
+    const bool track_node_state = skip_unchanged_nodes && !node.ContainsSubgraph();
+    if (track_node_state && node.Op()) {
+      auto state_it = node_inference_states_.find(node_index);
+      if (state_it != node_inference_states_.end() && state_it->second == GetNodeInferenceState(node)) {
+        // the node and its inputs and outputs are unchanged since the last inference
+        for (const auto& output : node.OutputDefs()) {
+          lsc.output_names.insert(output->Name());
+        }
+
+        continue;
+      }
+    }
+
     if (!node.Op()) {
       {
         auto status = Status::OK();
@@ -3141,6 +3217,10 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
 
     NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
 
+    if (track_node_state) {
+      node_inference_states_[node_index] = GetNodeInferenceState(node);
+    }
+
     // Accumulate output names of the iterated Node
     for (const auto& output : node.OutputDefs()) {
       lsc.output_names.insert(output->Name());
@@ -3463,6 +3543,7 @@ Status Graph::ReplaceInitializedTensorImpl(ONNX_NAMESPACE::TensorProto new_initi
               "graph_proto_ is not in sync with name_to_initial_tensor_");
 
   **existing_entry = std::move(new_initializer);
+  ++initializers_version_;
 
   return Status::OK();
 }
@@ -4458,6 +4539,9 @@ bool Graph::ReleaseNode(NodeIndex index) {
   if (nodes_[index] != nullptr) {
     nodes_[index] = nullptr;
     --num_of_nodes_;
+#if !defined(ORT_MINIMAL_BUILD)
+    node_inference_states_.erase(index);
+#endif
     GraphProtoSyncNeeded(true);
     GraphResolveNeeded(true);
   }
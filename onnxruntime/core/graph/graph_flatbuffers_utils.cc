@@ -3,6 +3,9 @@
 
 #include "graph_flatbuffers_utils.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "core/common/flatbuffers.h"
 
 #include "core/common/narrow.h"
@@ -58,6 +61,8 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
       ORT_RETURN_IF_ERROR(external_writer(src_type, unpacked_tensor, offset));
       external_data_offset = onnxruntime::narrow<int64_t>(offset);  // offset in fb is int64_t so -1 can mark not in use
     } else {
+      // align the data so a loader can use it in place, as long as the buffer itself is aligned
+      builder.ForceVectorAlignment(unpacked_tensor.size(), sizeof(uint8_t), kInitializerDataAlignment);
       raw_data = builder.CreateVector(unpacked_tensor.data(), unpacked_tensor.size());
     }
   }
@@ -299,7 +304,15 @@ Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor, TensorProto& init
   } else {
     const auto* fbs_raw_data = fbs_tensor.raw_data();
     if (fbs_raw_data) {
-      if (load_options.can_use_flatbuffer_for_initializers && fbs_raw_data->size() > 127) {
+      // the data is only used in place if it is aligned for its element type. models saved before the data was
+      // aligned when writing, or loaded from an unaligned buffer, may not be.
+      const size_t num_elements = std::accumulate(fbs_dims->cbegin(), fbs_dims->cend(), SafeInt<size_t>(1),
+                                                  std::multiplies<>());
+      const size_t element_size = num_elements > 0 ? fbs_raw_data->size() / num_elements : 1;
+      const size_t required_alignment = std::clamp<size_t>(element_size, 1, 8);
+      const bool is_aligned = reinterpret_cast<uintptr_t>(fbs_raw_data->Data()) % required_alignment == 0;
+
+      if (load_options.can_use_flatbuffer_for_initializers && fbs_raw_data->size() > 127 && is_aligned) {
         initializer.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
 
         static_assert(sizeof(void*) <= sizeof(ExternalDataInfo::OFFSET_TYPE));
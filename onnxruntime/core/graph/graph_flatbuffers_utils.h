@@ -60,6 +60,13 @@ using ExternalDataReader = std::function<Status(uint64_t offset, gsl::span<uint8
 /// </remarks>
 constexpr uint32_t kMinimumSizeForExternalData = 64;
 
+/// <summary>
+/// Alignment of initializer data in an ORT format flatbuffer, relative to the start of the buffer.
+/// </summary>
+/// <remarks>matches the alignment of CPU allocations so initializers used in place perform the same as copies.
+/// </remarks>
+constexpr size_t kInitializerDataAlignment = 64;
+
 /// <summary>
 /// Save an initializer to an ORT format flatbuffer.
 /// </summary>
@@ -1,7 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <optional>
 #include "core/common/logging/logging.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
@@ -15,6 +18,8 @@
 #pragma warning(disable : 4800)
 #endif
 #include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -23,6 +28,7 @@
 #include "core/common/gsl.h"
 
 #include "core/platform/env.h"
+#include "core/platform/path_lib.h"
 
 #if !defined(ORT_MINIMAL_BUILD)
 #include "core/graph/schema_registry.h"
@@ -357,6 +363,25 @@ const ModelMetaData& Model::MetaData() const noexcept {
   return model_metadata_;
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+void Model::SetMetaDataProperty(const std::string& key, std::optional<std::string> value) {
+  // model_proto_ holds a copy of the metadata which must stay in sync
+  auto& props = *model_proto_.mutable_metadata_props();
+  props.erase(std::remove_if(props.begin(), props.end(),
+                             [&key](const StringStringEntryProto& prop) { return prop.key() == key; }),
+              props.end());
+  if (!value.has_value()) {
+    model_metadata_.erase(key);
+    return;
+  }
+
+  const gsl::not_null<StringStringEntryProto*> prop{model_proto_.add_metadata_props()};
+  prop->set_key(key);
+  prop->set_value(*value);
+  model_metadata_[key] = std::move(*value);
+}
+#endif
+
 Graph& Model::MainGraph() noexcept {
   return *graph_;
 }
@@ -686,6 +711,199 @@ using ::google::protobuf::io::CodedInputStream;
 using ::google::protobuf::io::FileInputStream;
 using ::google::protobuf::io::ZeroCopyInputStream;
 
+namespace {
+using ::google::protobuf::internal::WireFormatLite;
+using ::google::protobuf::io::CodedOutputStream;
+using ::google::protobuf::io::StringOutputStream;
+
+Status ProtobufParsingFailed() {
+  return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Protobuf parsing failed.");
+}
+
+// Copies the fields of the message being read from input to output. handle_field is called first for every field
+// and sets 'handled' if it consumed the field value itself; all other fields are copied unchanged.
+template <typename HandleField>
+Status CopyMessageFields(CodedInputStream& input, std::string& output, HandleField&& handle_field) {
+  StringOutputStream output_stream(&output);
+  CodedOutputStream coded_output(&output_stream);
+  for (uint32_t tag = input.ReadTag(); tag != 0; tag = input.ReadTag()) {
+    bool handled = false;
+    ORT_RETURN_IF_ERROR(handle_field(tag, coded_output, handled));
+    if (!handled) {
+      if (!WireFormatLite::SkipField(&input, tag, &coded_output)) {
+        return ProtobufParsingFailed();
+      }
+    }
+  }
+  return input.ConsumedEntireMessage() && !coded_output.HadError() ? Status::OK() : ProtobufParsingFailed();
+}
+
+// Copies the length delimited value of a message field using copy_message to copy the fields of the message.
+template <typename CopyMessage>
+Status CopyMessageField(CodedInputStream& input, uint32_t tag, CodedOutputStream& output, CopyMessage&& copy_message) {
+  uint32_t length = 0;
+  if (!input.ReadVarint32(&length) || length > static_cast<uint32_t>(std::numeric_limits<int>::max())) {
+    return ProtobufParsingFailed();
+  }
+  const auto limit = input.PushLimit(static_cast<int>(length));
+  std::string message;
+  ORT_RETURN_IF_ERROR(copy_message(input, message));
+  input.PopLimit(limit);
+
+  output.WriteTag(tag);
+  output.WriteVarint32(static_cast<uint32_t>(message.size()));
+  output.WriteString(message);
+  return Status::OK();
+}
+
+bool IsMessageField(uint32_t tag, int field_number) {
+  return WireFormatLite::GetTagFieldNumber(tag) == field_number &&
+         WireFormatLite::GetTagWireType(tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+}
+
+// Reads a serialized ModelProto, leaving out the raw data of large initializers in the main graph. The bytes are
+// skipped in the input, and the initializers are rewritten to refer to them in the model file as external data.
+class InPlaceInitializerReader {
+ public:
+  InPlaceInitializerReader(std::string model_file_name, size_t min_size)
+      : model_file_name_(std::move(model_file_name)), min_size_(min_size) {}
+
+  Status CopyModel(CodedInputStream& input, std::string& output) const {
+    return CopyMessageFields(input, output, [&](uint32_t tag, CodedOutputStream& coded_output, bool& handled) {
+      if (!IsMessageField(tag, ModelProto::kGraphFieldNumber)) {
+        return Status::OK();
+      }
+      handled = true;
+      return CopyMessageField(input, tag, coded_output, [this](CodedInputStream& graph_input, std::string& graph) {
+        return CopyGraph(graph_input, graph);
+      });
+    });
+  }
+
+ private:
+  Status CopyGraph(CodedInputStream& input, std::string& output) const {
+    return CopyMessageFields(input, output, [&](uint32_t tag, CodedOutputStream& coded_output, bool& handled) {
+      if (!IsMessageField(tag, GraphProto::kInitializerFieldNumber)) {
+        return Status::OK();
+      }
+      handled = true;
+      return CopyMessageField(input, tag, coded_output, [this](CodedInputStream& tensor_input, std::string& tensor) {
+        return CopyTensor(tensor_input, tensor);
+      });
+    });
+  }
+
+  Status CopyTensor(CodedInputStream& input, std::string& output) const {
+    // offset and length of raw data that was skipped. a later raw_data field replaces an earlier one.
+    std::optional<std::pair<int, uint32_t>> skipped_raw_data;
+    // the skipped raw data if its offset may not be aligned for the element type, which is only known once the
+    // whole tensor is read.
+    std::string maybe_unaligned_raw_data;
+    bool has_external_data = false;
+
+    ORT_RETURN_IF_ERROR(CopyMessageFields(input, output, [&](uint32_t tag, CodedOutputStream& coded_output,
+                                                             bool& handled) {
+      if (WireFormatLite::GetTagFieldNumber(tag) == TensorProto::kExternalDataFieldNumber) {
+        has_external_data = true;
+      }
+      if (!IsMessageField(tag, TensorProto::kRawDataFieldNumber)) {
+        return Status::OK();
+      }
+      handled = true;
+
+      uint32_t length = 0;
+      if (!input.ReadVarint32(&length) || length > static_cast<uint32_t>(std::numeric_limits<int>::max())) {
+        return ProtobufParsingFailed();
+      }
+      maybe_unaligned_raw_data.clear();
+      if (length < min_size_) {
+        std::string raw_data;
+        if (!input.ReadString(&raw_data, static_cast<int>(length))) {
+          return ProtobufParsingFailed();
+        }
+        coded_output.WriteTag(tag);
+        coded_output.WriteVarint32(length);
+        coded_output.WriteString(raw_data);
+        skipped_raw_data.reset();
+      } else {
+        skipped_raw_data.emplace(input.CurrentPosition(), length);
+        const bool skipped = skipped_raw_data->first % kMaxElementAlignment == 0
+                                 ? input.Skip(static_cast<int>(length))
+                                 : input.ReadString(&maybe_unaligned_raw_data, static_cast<int>(length));
+        if (!skipped) {
+          return ProtobufParsingFailed();
+        }
+      }
+      return Status::OK();
+    }));
+
+    if (skipped_raw_data.has_value()) {
+      ORT_RETURN_IF(has_external_data, "Initializer has both raw data and external data. The model is invalid.");
+
+      // appending the serialized fields merges them into the tensor
+      if (!maybe_unaligned_raw_data.empty() &&
+          skipped_raw_data->first % RequiredAlignment(output, skipped_raw_data->second) != 0) {
+        // external data is used in place, so data that is not aligned for its elements is kept in the tensor
+        TensorProto raw_data;
+        raw_data.set_raw_data(std::move(maybe_unaligned_raw_data));
+        output += raw_data.SerializeAsString();
+        return Status::OK();
+      }
+
+      TensorProto external_data;
+      external_data.set_data_location(TensorProto_DataLocation_EXTERNAL);
+      auto add_entry = [&external_data](const char* key, std::string value) {
+        auto* entry = external_data.add_external_data();
+        entry->set_key(key);
+        entry->set_value(std::move(value));
+      };
+      add_entry("location", model_file_name_);
+      add_entry("offset", std::to_string(skipped_raw_data->first));
+      add_entry("length", std::to_string(skipped_raw_data->second));
+      output += external_data.SerializeAsString();
+    }
+
+    return Status::OK();
+  }
+
+  // Raw data at an offset that is a multiple of this is aligned for any element type.
+  static constexpr int kMaxElementAlignment = 8;
+
+  // The alignment required by the elements of a serialized tensor without its raw data, from its dims and the
+  // length of the raw data.
+  static int RequiredAlignment(const std::string& tensor_without_raw_data, uint32_t raw_data_length) {
+    TensorProto tensor;
+    if (!tensor.ParseFromString(tensor_without_raw_data)) {
+      return kMaxElementAlignment;
+    }
+    uint64_t num_elements = 1;
+    for (const auto dim : tensor.dims()) {
+      if (dim <= 0) {
+        return 1;
+      }
+      num_elements *= static_cast<uint64_t>(dim);
+    }
+    const uint64_t element_size = raw_data_length / num_elements;
+    return static_cast<int>(std::clamp<uint64_t>(element_size, 1, kMaxElementAlignment));
+  }
+
+  const std::string model_file_name_;
+  const size_t min_size_;
+};
+
+Status LoadWithInPlaceInitializers(int fd, const PathString& model_path, size_t min_size,
+                                   /*out*/ ModelProto& model_proto) {
+  FileInputStream file_input(fd);
+  std::string model;
+  {
+    CodedInputStream input(&file_input);
+    InPlaceInitializerReader reader(ToUTF8String(GetLastComponent(model_path)), min_size);
+    ORT_RETURN_IF_ERROR(reader.CopyModel(input, model));
+  }
+  return file_input.GetErrno() == 0 && model_proto.ParseFromString(model) ? Status::OK() : ProtobufParsingFailed();
+}
+}  // namespace
+
 Status Model::Load(int fd, ONNX_NAMESPACE::ModelProto& model_proto) {
   if (fd < 0) {
     return Status(ONNXRUNTIME, INVALID_ARGUMENT, "<p_fd> less than 0.");
@@ -730,7 +948,12 @@ Status Model::Load(int fd, const PathString& model_path, std::shared_ptr<Model>&
                    const ModelOptions& options) {
   ModelProto model_proto;
 
-  ORT_RETURN_IF_ERROR(Load(fd, model_proto));
+  if (options.in_place_initializer_min_size > 0 && !model_path.empty()) {
+    ORT_RETURN_IF_ERROR(LoadWithInPlaceInitializers(fd, model_path, options.in_place_initializer_min_size,
+                                                    model_proto));
+  } else {
+    ORT_RETURN_IF_ERROR(Load(fd, model_proto));
+  }
 
   p_model = std::make_shared<Model>(std::move(model_proto), model_path, local_registries, logger, options);
 
@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include <memory>
 #include <climits>
+#include <optional>
 #include <string>
 
 #include "core/common/flatbuffers.h"
@@ -36,6 +37,11 @@ struct ModelOptions {
   // be returned.
   bool strict_shape_type_inference;
 
+  // If non-zero and the model is loaded from a file, the raw data of main graph initializers of at least this many
+  // bytes is not read into the ModelProto. Those initializers refer to their bytes in the model file as external
+  // data instead, so they can be memory mapped when the session is initialized.
+  size_t in_place_initializer_min_size = 0;
+
   ModelOptions(bool allow_released_opsets_only, bool strict_shape_type_inference)
       : allow_released_opsets_only(allow_released_opsets_only),
         strict_shape_type_inference(strict_shape_type_inference) {}
@@ -173,6 +179,11 @@ class Model {
 
   const ModelMetaData& MetaData() const noexcept;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Sets the value of a metadata property of the model, or removes the property if value is std::nullopt.
+  void SetMetaDataProperty(const std::string& key, std::optional<std::string> value);
+#endif
+
   // Gets the path from which the model was loaded, if any.
   const Path& ModelPath() const noexcept { return model_path_; }
 
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "core/optimizer/scaler_linear_fusion.h"
+#include "core/framework/op_node_proto_helper.h"
+#include "core/graph/graph_utils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Number of rows in the coefficients of the linear model, or 0 if the node can't be fused.
+size_t GetLinearModelTargets(const Node& node, const std::vector<float>& intercepts) {
+  if (node.OpType() == "LinearClassifier") {
+    // LinearClassifier derives the class count from the intercepts.
+    return intercepts.size();
+  }
+
+  const auto& attributes = node.GetAttributes();
+  const auto targets = attributes.find("targets");
+  if (targets == attributes.end() || targets->second.i() <= 0) {
+    return 0;
+  }
+  return static_cast<size_t>(targets->second.i());
+}
+
+}  // namespace
+
+bool ScalerLinearFusion::SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger& logger) const {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Scaler", {1}, kMLDomain) ||
+      node.GetOutputEdgesCount() != 1 ||
+      !graph_utils::CanRemoveNode(graph, node, logger)) {
+    return false;
+  }
+
+  // The linear models cast their input to float, so only a float Scaler input keeps the numerics unchanged.
+  const auto* input_type = node.InputDefs()[0]->TypeAsProto();
+  if (input_type == nullptr || !input_type->tensor_type().has_elem_type() ||
+      input_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  const auto& next_node = *node.OutputNodesBegin();
+  if (!(graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "LinearClassifier", {1}, kMLDomain) ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "LinearRegressor", {1}, kMLDomain)) ||
+      // Make sure the two nodes do not span execution providers.
+      next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+    return false;
+  }
+
+  return true;
+}
+
+Status ScalerLinearFusion::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect,
+                                 const logging::Logger& /*logger*/) const {
+  auto& linear_node = *graph.GetNode(node.OutputNodesBegin()->Index());
+
+  ProtoHelperNodeContext scaler_helper_ctx(node);
+  OpNodeProtoHelper<ProtoHelperNodeContext> scaler_helper(&scaler_helper_ctx);
+  ProtoHelperNodeContext linear_helper_ctx(linear_node);
+  OpNodeProtoHelper<ProtoHelperNodeContext> linear_helper(&linear_helper_ctx);
+
+  const std::vector<float> scale = scaler_helper.GetAttrsOrDefault<float>("scale");
+  const std::vector<float> offset = scaler_helper.GetAttrsOrDefault<float>("offset");
+  std::vector<float> coefficients = linear_helper.GetAttrsOrDefault<float>("coefficients");
+  std::vector<float> intercepts = linear_helper.GetAttrsOrDefault<float>("intercepts");
+
+  const size_t num_targets = GetLinearModelTargets(linear_node, intercepts);
+  if (scale.empty() || scale.size() != offset.size() ||
+      num_targets == 0 || coefficients.empty() || coefficients.size() % num_targets != 0) {
+    return Status::OK();
+  }
+
+  const size_t num_features = coefficients.size() / num_targets;
+  if (scale.size() != 1 && scale.size() != num_features) {
+    return Status::OK();
+  }
+
+  // LinearRegressor ignores intercepts unless there is one per target.
+  if (intercepts.size() != num_targets) {
+    if (linear_node.OpType() != "LinearRegressor") {
+      return Status::OK();
+    }
+    intercepts.assign(num_targets, 0.f);
+  }
+
+  for (size_t target = 0; target < num_targets; ++target) {
+    float* target_coefficients = coefficients.data() + target * num_features;
+    double folded_offset = 0.0;
+    for (size_t feature = 0; feature < num_features; ++feature) {
+      const size_t idx = scale.size() == 1 ? 0 : feature;
+      target_coefficients[feature] *= scale[idx];
+      folded_offset += static_cast<double>(target_coefficients[feature]) * offset[idx];
+    }
+    intercepts[target] -= static_cast<float>(folded_offset);
+  }
+
+  linear_node.ClearAttribute("coefficients");
+  linear_node.AddAttribute("coefficients", coefficients);
+  linear_node.ClearAttribute("intercepts");
+  linear_node.AddAttribute("intercepts", intercepts);
+
+  // The linear model now consumes the Scaler input directly.
+  if (graph_utils::RemoveNode(graph, node)) {
+    rule_effect = RewriteRuleEffect::kRemovedCurrentNode;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/rewrite_rule.h"
+
+namespace onnxruntime {
+/**
+@Class ScalerLinearFusion
+
+Rewrite rule that folds a Scaler node into the LinearClassifier or LinearRegressor
+node consuming its output.
+
+Scaler computes (x - offset) * scale per feature, so for a linear model with
+coefficients W and intercepts b the pair is equivalent to a single linear model with
+  W' = W * diag(scale)
+  b' = b - W' * offset
+which removes one full read and write of the feature tensor per inference.
+
+It is attempted to be triggered only on nodes with op type "Scaler".
+*/
+class ScalerLinearFusion : public RewriteRule {
+ public:
+  ScalerLinearFusion() noexcept : RewriteRule("ScalerLinearFusion") {}
+
+  std::vector<std::string> TargetOpTypes() const noexcept override {
+    return {"Scaler"};
+  }
+
+ private:
+  bool SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger& logger) const override;
+
+  Status Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
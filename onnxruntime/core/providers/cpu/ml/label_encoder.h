@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/common/string_lookup_table.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/ml/ml_common.h"
 #include "core/framework/tensorprotoutils.h"
@@ -30,7 +31,7 @@ class LabelEncoder final : public OpKernel {
     for (size_t i = 0; i < num_entries; ++i) {
       const std::string& str = string_classes[i];
 
-      string_to_int_map_[str] = i;
+      string_to_int_map_.InsertOrAssign(str, i);
       int_to_string_map_[i] = str;
     }
   }
@@ -38,13 +39,43 @@ class LabelEncoder final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
+  StringLookupTable<int64_t> string_to_int_map_;
   std::unordered_map<int64_t, std::string> int_to_string_map_;
 
   std::string default_string_;
   int64_t default_int_;
 };
 
+// String keys are looked up in a flat StringLookupTable, other key types use the given hash map.
+template <typename TKey, typename TValue, typename TMap>
+using LabelEncoderMap = std::conditional_t<std::is_same_v<TKey, std::string>, StringLookupTable<TValue>, TMap>;
+
+template <typename TKey, typename TValue, typename TMap>
+void LabelEncoderMapAdd(TMap& map, const TKey& key, const TValue& value) {
+  if constexpr (std::is_same_v<TKey, std::string>) {
+    map.Emplace(key, value);
+  } else {
+    map.emplace(key, value);
+  }
+}
+
+template <typename TKey, typename TValue, typename TMap>
+void LabelEncoderMapLookup(const TMap& map, gsl::span<const TKey> input, gsl::span<TValue> output,
+                           const TValue& default_value) {
+  if constexpr (std::is_same_v<TKey, std::string>) {
+    map.FindAll(input.data(), input.size(), output.data(), default_value);
+  } else {
+    auto input_iter = input.begin();
+    auto output_iter = output.begin();
+    while (input_iter != input.end()) {
+      const auto found = map.find(*input_iter);
+      *output_iter = found == map.end() ? default_value : found->second;
+      ++output_iter;
+      ++input_iter;
+    }
+  }
+}
+
 template <typename TKey, typename TValue>
 class LabelEncoder_2 final : public OpKernel {
  public:
@@ -64,7 +95,7 @@ class LabelEncoder_2 final : public OpKernel {
                 " attributes in LabelEncoder ", "(name: ", info.node().Name(), ") must have the same length. ",
                 "However, the number of key is ", num_keys, " and the number of ", "values is ", num_values, ".");
     map_.reserve(num_keys);
-    for (size_t i = 0; i < num_keys; ++i) map_.emplace(keys[i], values[i]);
+    for (size_t i = 0; i < num_keys; ++i) LabelEncoderMapAdd(map_, keys[i], values[i]);
   }
 
   Status Compute(OpKernelContext* context) const override {
@@ -74,14 +105,7 @@ class LabelEncoder_2 final : public OpKernel {
 
     auto input = X->template DataAsSpan<TKey>();
     auto output = Y->template MutableDataAsSpan<TValue>();
-    auto input_iter = input.begin();
-    auto output_iter = output.begin();
-    while (input_iter != input.end()) {
-      const auto found = map_.find(*input_iter);
-      *output_iter = found == map_.end() ? default_value_ : found->second;
-      ++output_iter;
-      ++input_iter;
-    }
+    LabelEncoderMapLookup(map_, input, output, default_value_);
     return Status::OK();
   }
 
@@ -94,7 +118,7 @@ class LabelEncoder_2 final : public OpKernel {
   // A collection of key-value pairs. Each (a_key, a_value) pair
   // means that the "a_key" in the input would be mapped to "a_value".
   // If map_ doesn't contain "a_key", we use default_value_ as its output.
-  InlinedHashMap<TKey, TValue> map_;
+  LabelEncoderMap<TKey, TValue, InlinedHashMap<TKey, TValue>> map_;
   TValue default_value_;
   // ONNX attribute name to load keys.
   std::string key_field_name_;
@@ -203,7 +227,7 @@ class LabelEncoder_4 final : public OpKernel {
     auto values = GetAttribute<TValue>(kernel_info, value_field_name_, "values_tensor");
     ORT_ENFORCE(keys.size() == values.size(), "Keys and values must have the same length.");
     for (size_t i = 0; i < keys.size(); ++i) {
-      map_.emplace(keys[i], values[i]);
+      LabelEncoderMapAdd(map_, keys[i], values[i]);
     }
   }
   Status Compute(OpKernelContext* context) const override {
@@ -213,20 +237,13 @@ class LabelEncoder_4 final : public OpKernel {
 
     auto input = X->template DataAsSpan<TKey>();
     auto output = Y->template MutableDataAsSpan<TValue>();
-    auto input_iter = input.begin();
-    auto output_iter = output.begin();
-    while (input_iter != input.end()) {
-      const auto found = map_.find(*input_iter);
-      *output_iter = found == map_.end() ? default_value_ : found->second;
-      ++output_iter;
-      ++input_iter;
-    }
+    LabelEncoderMapLookup(map_, input, output, default_value_);
     return Status::OK();
   }
 
  private:
   void InitializeAttrFields(const OpKernelInfo& kernel_info);
-  HashMap<TKey, TValue, NaNHash<TKey>, NaNEqual<TKey>> map_;
+  LabelEncoderMap<TKey, TValue, HashMap<TKey, TValue, NaNHash<TKey>, NaNEqual<TKey>>> map_;
   TValue default_value_;
   std::string key_field_name_;
   std::string value_field_name_;
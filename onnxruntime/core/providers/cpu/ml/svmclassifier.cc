@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/ml/svmclassifier.h"
 #include "core/platform/threadpool.h"
+#include "core/util/math.h"
 // TODO: fix the warnings
 #if defined(_MSC_VER) && !defined(__clang__)
 // Chance of arithmetic overflow could be reduced
@@ -63,6 +64,23 @@ SVMClassifier::SVMClassifier(const OpKernelInfo& info)
   if (vector_count_ > 0) {
     feature_count_ = support_vectors_.size() / vector_count_;  // length of each support vector
     mode_ = SVM_TYPE::SVM_SVC;
+    prepare_rbf_kernel(support_vectors_, vector_count_, feature_count_);
+
+    // coefficients of the support vectors of each class for the one-vs-one GEMM, in double and packed per class.
+    // Class c holds a [class_count_ - 1, vectors_per_class_[c]] block at (class_count_ - 1) * starting_vector_[c].
+    const ptrdiff_t coefficient_rows = class_count_ - 1;
+    if (coefficient_rows > 0 && coefficients_.size() >= SafeInt<size_t>(coefficient_rows) * vector_count_) {
+      class_coefficients_.resize(SafeInt<size_t>(coefficient_rows) * vector_count_);
+      for (size_t c = 0; c < vectors_per_class_.size(); ++c) {
+        const ptrdiff_t start_index = narrow<ptrdiff_t>(starting_vector_[c]);
+        const ptrdiff_t class_support_count = narrow<ptrdiff_t>(vectors_per_class_[c]);
+        double* block = class_coefficients_.data() + coefficient_rows * start_index;
+        for (ptrdiff_t row = 0; row < coefficient_rows; ++row) {
+          const float* coefficients = coefficients_.data() + row * vector_count_ + start_index;
+          std::copy(coefficients, coefficients + class_support_count, block + row * class_support_count);
+        }
+      }
+    }
   } else {
     feature_count_ = coefficients_.size() / class_count_;  // liblinear mode
     mode_ = SVM_TYPE::SVM_LINEAR;
@@ -247,58 +265,78 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
     batched_kernel_dot<float>(x_data, support_vectors_, num_batches, vector_count_, feature_count_, 0.f, kernels_span,
                               threadpool);
 
+    // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
+    // per class.
+    // coefficients: [num_classes - 1, vector_count_]
+    //
+    // e.g. say you have 3 classes, with 3 x 3 coefficients
+    //
+    // AA AB AC
+    // BA BB BC
+    // CA CB CC
+    //
+    // you can remove the diagonal line of items comparing a class with itself leaving one less row.
+    //
+    // BA AB AC
+    // CA CB BC
+    //
+    // for each class there is a coefficient per support vector, and a class has one or more support vectors.
+    //
+    // Combine the scores for the two combinations for two classes with their coefficient.
+    // e.g. AB combines with BA.
+    // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
+    //
+    // Rather than doing those dot products one pair at a time, do one GEMM per class c between the kernels of
+    // its support vectors and every coefficient row:
+    //   class_sums[c] = kernels[:, c's vectors] * coefficients[:, c's vectors]^T  -> [num_batches, num_classes - 1]
+    // The score for the pair (i, j) is then class_sums[i][n, j - 1] + class_sums[j][n, i] + rho.
+    // The sums are accumulated in double like the pairwise dot products were, as the sign of a score decides a vote
+    // and scores close to 0 must not flip.
+    const ptrdiff_t coefficient_rows = class_count_ - 1;
+    const size_t class_sums_size = SafeInt<size_t>(num_batches) * coefficient_rows;
+    std::vector<double> class_sums_data(SafeInt<size_t>(class_count_) * class_sums_size, 0.);
+
+    if (!class_coefficients_.empty()) {
+      std::vector<double> class_kernels;
+      for (size_t c = 0; c < vectors_per_class_.size() && c < static_cast<size_t>(class_count_); ++c) {
+        const ptrdiff_t class_support_count = narrow<ptrdiff_t>(vectors_per_class_[c]);
+        if (class_support_count == 0) {
+          continue;
+        }
+
+        // pack the kernels of the support vectors of the class, the double GEMM needs contiguous matrices
+        const ptrdiff_t start_index = narrow<ptrdiff_t>(starting_vector_[c]);
+        class_kernels.resize(SafeInt<size_t>(num_batches) * class_support_count);
+        for (ptrdiff_t n = 0; n < num_batches; ++n) {
+          const float* cur_kernels = kernels_data.data() + n * vector_count_ + start_index;
+          std::copy(cur_kernels, cur_kernels + class_support_count,
+                    class_kernels.begin() + n * class_support_count);
+        }
+
+        math::Gemm<double, concurrency::ThreadPool>(CblasNoTrans, CblasTrans,
+                                                    num_batches, coefficient_rows, class_support_count,
+                                                    1.,
+                                                    class_kernels.data(),
+                                                    class_coefficients_.data() + coefficient_rows * start_index,
+                                                    0.,
+                                                    class_sums_data.data() + c * class_sums_size,
+                                                    threadpool);
+      }
+    }
+
     for (int64_t n = 0; n < num_batches; n++) {
-      // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
-      // per class.
-      // coefficients: [num_classes - 1, vector_count_]
-      //
-      // e.g. say you have 3 classes, with 3 x 3 coefficients
-      //
-      // AA AB AC
-      // BA BB BC
-      // CA CB CC
-      //
-      // you can remove the diagonal line of items comparing a class with itself leaving one less row.
-      //
-      // BA AB AC
-      // CA CB BC
-      //
-      // for each class there is a coefficient per support vector, and a class has one or more support vectors.
-      //
-      // Combine the scores for the two combinations for two classes with their coefficient.
-      // e.g. AB combines with BA.
-      // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
-
-      auto cur_kernels = kernels_span.subspan(n * SafeInt<size_t>(vector_count_), onnxruntime::narrow<size_t>(vector_count_));
       auto cur_scores = classifier_scores.subspan(n * SafeInt<size_t>(num_slots_per_iteration), onnxruntime::narrow<size_t>(num_classifiers));
       auto cur_votes = votes_span.subspan(n * SafeInt<size_t>(class_count_), onnxruntime::narrow<size_t>(class_count_));
       auto scores_iter = cur_scores.begin();
 
       size_t classifier_idx = 0;
       for (int64_t i = 0; i < class_count_ - 1; i++) {
-        int64_t start_index_i = starting_vector_[onnxruntime::narrow<size_t>(i)];  // start of support vectors for class i
-        int64_t class_i_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(i)];
-        int64_t i_coeff_row_offset = vector_count_ * i;
+        const double* class_i_sums = class_sums_data.data() + i * class_sums_size + n * coefficient_rows;
 
         for (int64_t j = i + 1; j < class_count_; j++) {
-          int64_t start_index_j = starting_vector_[onnxruntime::narrow<size_t>(j)];  // start of support vectors for class j
-          int64_t class_j_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(j)];
-          int64_t j_coeff_row_offset = vector_count_ * (j - 1);
-
-          double sum = 0;
-
-          const float* val1 = &(coefficients_[j_coeff_row_offset + SafeInt<size_t>(start_index_i)]);
-          const float* val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_i)]);
-          for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          val1 = &(coefficients_[i_coeff_row_offset + SafeInt<size_t>(start_index_j)]);
-          val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_j)]);
-
-          for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
+          const double* class_j_sums = class_sums_data.data() + j * class_sums_size + n * coefficient_rows;
 
-          sum += rho_[classifier_idx++];
+          double sum = class_i_sums[j - 1] + class_j_sums[i] + rho_[classifier_idx++];
 
           *scores_iter++ = static_cast<float>(sum);
           ++(cur_votes[onnxruntime::narrow<size_t>(sum > 0 ? i : j)]);
@@ -30,6 +30,42 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
+  // Precompute the centered support vectors and their squared norms so the RBF kernel can be evaluated with a GEMM
+  // using ||x - s||^2 = ||x||^2 + ||s||^2 - 2 * x.s
+  // Both x and s are shifted by the mean support vector first, which keeps the norms small relative to the
+  // distances and limits the cancellation error of that expansion.
+  void prepare_rbf_kernel(gsl::span<const float> support_vectors, ptrdiff_t vector_count, ptrdiff_t feature_count) {
+    if (kernel_type_ != KERNEL::RBF || vector_count <= 0 || feature_count <= 0) {
+      return;
+    }
+
+    const size_t n = narrow<size_t>(vector_count);
+    const size_t k = narrow<size_t>(feature_count);
+    ORT_ENFORCE(support_vectors.size() >= n * k, "support_vectors has fewer than n_supports * feature count values");
+
+    rbf_center_.assign(k, 0.f);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < k; ++j) {
+        rbf_center_[j] += support_vectors[i * k + j];
+      }
+    }
+    for (auto& value : rbf_center_) {
+      value /= static_cast<float>(n);
+    }
+
+    rbf_centered_support_vectors_.resize(n * k);
+    rbf_support_vector_norms_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+      float norm = 0.f;
+      for (size_t j = 0; j < k; ++j) {
+        const float value = support_vectors[i * k + j] - rbf_center_[j];
+        rbf_centered_support_vectors_[i * k + j] = value;
+        norm += value * value;
+      }
+      rbf_support_vector_norms_[i] = norm;
+    }
+  }
+
   template <typename T>
   void batched_kernel_dot(const gsl::span<const T> a, const gsl::span<const T> b,
                           ptrdiff_t m, ptrdiff_t n, ptrdiff_t k,
@@ -38,7 +74,10 @@ class SVMCommon {
                           concurrency::ThreadPool* threadpool) const {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
-    if (kernel_type_ == KERNEL::RBF) {
+    if (kernel_type_ == KERNEL::RBF && rbf_support_vector_norms_.size() == size_t(n) &&
+        rbf_center_.size() == size_t(k)) {
+      batched_rbf_kernel_gemm(a, b, m, n, k, out, threadpool);
+    } else if (kernel_type_ == KERNEL::RBF) {
       T* cur_out = out.data();
       const T* cur_batch = a.data();
 
@@ -96,15 +135,73 @@ class SVMCommon {
   }
 
  private:
+  template <typename T>
+  void batched_rbf_kernel_gemm(const gsl::span<const T> a, const gsl::span<const T> b,
+                               ptrdiff_t m, ptrdiff_t n, ptrdiff_t k,
+                               const gsl::span<T> out,
+                               concurrency::ThreadPool* threadpool) const {
+    static_assert(std::is_same_v<T, float>, "RBF GEMM path only supports float");
+
+    // Distances smaller than this fraction of ||x||^2 + ||s||^2 lose too many bits to cancellation
+    // and are recomputed directly.
+    constexpr float kCancellationRatio = 1e-2f;
+
+    std::vector<float> centered_x(a.size());
+    std::vector<float> x_norms(narrow<size_t>(m));
+    for (ptrdiff_t i = 0; i < m; ++i) {
+      float norm = 0.f;
+      for (ptrdiff_t j = 0; j < k; ++j) {
+        const float value = a[i * k + j] - rbf_center_[j];
+        centered_x[i * k + j] = value;
+        norm += value * value;
+      }
+      x_norms[i] = norm;
+    }
+
+    // out = -2 * X.S^T
+    onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                      m, n, k,
+                                      -2.f, centered_x.data(), rbf_centered_support_vectors_.data(), 0.f,
+                                      nullptr, nullptr,
+                                      out.data(),
+                                      threadpool);
+
+    for (ptrdiff_t i = 0; i < m; ++i) {
+      T* cur_out = out.data() + i * n;
+      for (ptrdiff_t j = 0; j < n; ++j) {
+        const float norms = x_norms[i] + rbf_support_vector_norms_[j];
+        float sum = cur_out[j] + norms;
+        if (sum < kCancellationRatio * norms) {
+          const T* cur_input = a.data() + i * k;
+          const T* cur_support_vector = b.data() + j * k;
+          sum = 0.f;
+          for (ptrdiff_t feature = 0; feature < k; ++feature) {
+            T val = cur_input[feature] - cur_support_vector[feature];
+            sum += val * val;
+          }
+        }
+        cur_out[j] = -gamma_ * sum;
+      }
+    }
+
+    MlasComputeExp(out.data(), out.data(), out.size());
+  }
+
   KERNEL kernel_type_;
   float gamma_{0.f};
   float coef0_{0.f};
   float degree_{0.f};
+
+  // set by prepare_rbf_kernel
+  std::vector<float> rbf_center_;
+  std::vector<float> rbf_centered_support_vectors_;
+  std::vector<float> rbf_support_vector_norms_;
 };
 
 class SVMClassifier final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
   using SVMCommon::get_kernel_type;
+  using SVMCommon::prepare_rbf_kernel;
   using SVMCommon::set_kernel_type;
 
  public:
@@ -125,6 +222,7 @@ class SVMClassifier final : public OpKernel, private SVMCommon {
   std::vector<float> proba_;
   std::vector<float> probb_;
   std::vector<float> coefficients_;
+  std::vector<double> class_coefficients_;  // coefficients_ packed per class for the one-vs-one GEMM
   std::vector<float> support_vectors_;
   std::vector<int64_t> classlabels_ints_;
   std::vector<std::string> classlabels_strings_;
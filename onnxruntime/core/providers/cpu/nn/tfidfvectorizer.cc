@@ -4,11 +4,14 @@
 #include "tfidfvectorizer.h"
 #include "core/common/common.h"
 #include "core/common/inlined_containers.h"
+#include "core/common/string_lookup_table.h"
 #include <core/common/safeint.h>
 #include "core/framework/tensor.h"
 #include "core/platform/threadpool.h"
 
-#include <functional>
+#include <algorithm>
+#include <limits>
+#include <map>
 #include <string_view>
 
 namespace onnxruntime {
@@ -25,69 +28,139 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 namespace ngram_details {
 
-// NgrampPart implements a Trie like structure
-// for a unigram (1) it would insert into a root map with a valid id.
-// for (1,2,3) node 2 would be a child of 1 but have id == 0
-// because (1,2) does not exists. Node 3 would have a valid id.
-template <class T>
-struct NgramPart;
-
-template <>
-struct NgramPart<int64_t>;
-
-template <>
-struct NgramPart<std::string>;
-
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
-
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = InlinedHashMap<int64_t, std::unique_ptr<NgramPartInt>>;
-
-#ifndef DISABLE_ABSEIL
-using StrMap = absl::flat_hash_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                   std::hash<std::string>, std::equal_to<std::string>>;
-#else
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
-#endif
-
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
+// NgramAutomaton holds all n-grams of the pool in an Aho-Corasick automaton stored in flat arrays.
+//
+// The nodes form a trie over the n-gram items: for a unigram (1) the root has a child with a valid id,
+// for (1,2,3) node 2 is a child of 1 but has id == 0 because (1,2) does not exist, and node 3 has a valid id.
+// On top of the trie every node keeps a failure link (the node of its longest proper suffix that is in the trie)
+// and an output link (the nearest node on the failure chain that ends an n-gram). That lets a single left to
+// right scan over a sequence report every pool n-gram occurrence, instead of restarting a trie walk at every
+// start position.
+//
+// The children of a node are a contiguous, sorted slice of edge_tokens_/edge_targets_ searched with a binary
+// search. The root usually has one child per vocabulary entry, so it also gets a hash map.
+// String pools are interned into int64 token ids first, so the same automaton serves both pool types.
+class NgramAutomaton {
+ public:
+  static constexpr uint32_t kRoot = 0;
+
+  struct Node {
+    size_t ngram_id = 0;  // 0 - means no n-gram ends here
+    uint32_t depth = 0;
+    uint32_t fail = kRoot;
+    uint32_t output = kRoot;  // nearest node on the failure chain with ngram_id != 0, kRoot if none
+    uint32_t first_edge = 0;
+    uint32_t num_edges = 0;
+  };
 
-template <>
-struct NgramPart<std::string> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
+  bool empty() const { return nodes_.size() <= 1; }
+
+  // Adds ngrams consecutive n-grams of ngram_size items starting at first. Returns next ngram_id.
+  template <class ForwardIter>
+  size_t Add(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id) {
+    if (build_children_.empty()) {
+      build_children_.emplace_back();
+      nodes_.emplace_back();
+    }
+
+    for (; ngrams > 0; --ngrams) {
+      uint32_t node = kRoot;
+      for (size_t n = 1; n <= ngram_size; ++n, ++first) {
+        const int64_t token = *first;
+        auto hit = build_children_[node].find(token);
+        if (hit == build_children_[node].end()) {
+          ORT_ENFORCE(nodes_.size() < std::numeric_limits<uint32_t>::max(), "Too many n-gram items in the pool");
+          const auto child = static_cast<uint32_t>(nodes_.size());
+          nodes_.emplace_back();
+          nodes_.back().depth = static_cast<uint32_t>(n);
+          build_children_.emplace_back();
+          hit = build_children_[node].emplace(token, child).first;
+        }
+        node = hit->second;
+      }
+      ORT_ENFORCE(nodes_[node].ngram_id == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
+      nodes_[node].ngram_id = ngram_id;
+      ++ngram_id;
+    }
+    return ngram_id;
+  }
+
+  // Flattens the trie built by Add and computes the failure and output links.
+  void Finalize() {
+    if (nodes_.empty()) {
+      return;
+    }
+
+    for (uint32_t node = 0; node < nodes_.size(); ++node) {
+      nodes_[node].first_edge = static_cast<uint32_t>(edge_tokens_.size());
+      nodes_[node].num_edges = static_cast<uint32_t>(build_children_[node].size());
+      for (const auto& child : build_children_[node]) {  // std::map iterates in token order
+        edge_tokens_.push_back(child.first);
+        edge_targets_.push_back(child.second);
+      }
+    }
+    root_children_.reserve(build_children_[kRoot].size());
+    for (const auto& child : build_children_[kRoot]) {
+      root_children_.emplace(child.first, child.second);
+    }
+    build_children_.clear();
+    build_children_.shrink_to_fit();
+
+    // Breadth first so that the failure target of a node is always complete before the node itself.
+    std::vector<uint32_t> queue;
+    queue.reserve(nodes_.size());
+    queue.push_back(kRoot);
+    for (size_t head = 0; head < queue.size(); ++head) {
+      const uint32_t parent = queue[head];
+      const Node& parent_node = nodes_[parent];
+      for (uint32_t e = parent_node.first_edge; e < parent_node.first_edge + parent_node.num_edges; ++e) {
+        const uint32_t child = edge_targets_[e];
+        uint32_t fail = kRoot;
+        if (parent != kRoot) {
+          fail = Next(parent_node.fail, edge_tokens_[e]);
+        }
+        nodes_[child].fail = fail;
+        nodes_[child].output = nodes_[fail].ngram_id != 0 ? fail : nodes_[fail].output;
+        queue.push_back(child);
+      }
+    }
+  }
+
+  const Node& GetNode(uint32_t node) const { return nodes_[node]; }
 
-// Returns next ngram_id
-template <class K, class ForwardIter, class Map>
-inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
-  for (; ngrams > 0; --ngrams) {
-    size_t n = 1;
-    Map* m = &c;
+  // Follows the goto function from node on token, taking failure links when there is no matching child.
+  uint32_t Next(uint32_t node, int64_t token) const {
     while (true) {
-      auto p = m->emplace(*first, std::make_unique<NgramPart<K>>(0));
-      ++first;
-      if (n == ngram_size) {
-        ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
-        p.first->second->id_ = ngram_id;
-        ++ngram_id;
-        break;
+      const uint32_t child = FindChild(node, token);
+      if (child != kRoot || node == kRoot) {
+        return child;
       }
-      ++n;
-      m = &p.first->second->leafs_;
+      node = nodes_[node].fail;
     }
   }
-  return ngram_id;
-}
+
+ private:
+  // Returns kRoot if there is no such child. The root is never a child so it can be used as the sentinel.
+  uint32_t FindChild(uint32_t node, int64_t token) const {
+    if (node == kRoot) {
+      auto hit = root_children_.find(token);
+      return hit == root_children_.end() ? kRoot : hit->second;
+    }
+    const Node& n = nodes_[node];
+    const auto first = edge_tokens_.begin() + n.first_edge;
+    const auto last = first + n.num_edges;
+    const auto hit = std::lower_bound(first, last, token);
+    return (hit == last || *hit != token) ? kRoot : edge_targets_[n.first_edge + (hit - first)];
+  }
+
+  std::vector<Node> nodes_;
+  std::vector<int64_t> edge_tokens_;
+  std::vector<uint32_t> edge_targets_;
+  InlinedHashMap<int64_t, uint32_t> root_children_;
+
+  // Only used while n-grams are added
+  std::vector<std::map<int64_t, uint32_t>> build_children_;
+};
 
 }  // namespace ngram_details
 }  // namespace onnxruntime
@@ -96,10 +169,6 @@ using namespace onnxruntime::ngram_details;
 
 namespace onnxruntime {
 
-inline const void* AdvanceElementPtr(const void* p, size_t elements, size_t element_size) {
-  return reinterpret_cast<const uint8_t*>(p) + elements * element_size;
-}
-
 // The weighting criteria.
 // "TF"(term frequency),
 //    the counts are propagated to output
@@ -134,11 +203,12 @@ struct TfIdfVectorizer::Impl {
   gsl::span<const int64_t> ngram_indexes_;
   gsl::span<const float> weights_;
 
-  // This map contains references to pool_string_ entries
-  // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
-  IntMap int64_map_;
+  // Token ids of the distinct pool_strings entries. Input strings
+  // are translated into these ids before they are scanned.
+  StringLookupTable<int64_t> pool_string_ids_;
+  // Contains the pool_int64s entries, or the pool_strings entries as token ids
+  NgramAutomaton automaton_;
+  bool pool_is_string_ = false;
 
   size_t output_size_ = 0;
 
@@ -153,6 +223,75 @@ struct TfIdfVectorizer::Impl {
     assert(ngram_id < ngram_indexes_.size());
     return SafeInt<size_t>(ngram_indexes_[ngram_id]);
   }
+
+  // A scan lane is one pass of the automaton over the items of a row that are skip_distance apart,
+  // starting at offset. Lanes are independent so they can run on different threads.
+  struct Lane {
+    size_t skip_distance;
+    size_t offset;
+    uint32_t min_ngram_size;
+  };
+
+  // Unigrams are not affected by the skip distance so they are only counted in the first lane.
+  // For skip distances > 1 only n-grams of at least 2 items are counted.
+  InlinedVector<Lane> MakeLanes() const {
+    InlinedVector<Lane> lanes;
+    const auto min_gram_length = narrow<uint32_t>(min_gram_length_);
+    lanes.push_back(Lane{1, 0, min_gram_length});
+    if (max_gram_length_ > 1) {
+      const auto max_skip_distance = narrow<size_t>(max_skip_count_) + 1;
+      for (size_t skip_distance = 2; skip_distance <= max_skip_distance; ++skip_distance) {
+        for (size_t offset = 0; offset < skip_distance; ++offset) {
+          lanes.push_back(Lane{skip_distance, offset, std::max<uint32_t>(min_gram_length, 2)});
+        }
+      }
+    }
+    return lanes;
+  }
+
+  // Adds the occurrences of every pool n-gram found by the lane to counts.
+  template <typename T>
+  void CountLane(const T* row, size_t row_size, const Lane& lane, gsl::span<float> counts) const {
+    uint32_t state = NgramAutomaton::kRoot;
+    for (size_t pos = lane.offset; pos < row_size; pos += lane.skip_distance) {
+      state = automaton_.Next(state, static_cast<int64_t>(row[pos]));
+      // depth only decreases along the output links
+      for (uint32_t node = automaton_.GetNode(state).ngram_id != 0 ? state : automaton_.GetNode(state).output;
+           node != NgramAutomaton::kRoot && automaton_.GetNode(node).depth >= lane.min_ngram_size;
+           node = automaton_.GetNode(node).output) {
+        counts[OutputIdToIncrement(automaton_.GetNode(node).ngram_id)] += 1.0f;
+      }
+    }
+  }
+
+  // Converts n-gram counts into the output values for the weighting criteria.
+  // weights are indexed by output index. ngram_indexes may leave gaps so an output index can be past the
+  // end of weights: such outputs keep a weight of 1 as when no weights are given. Only the outputs of
+  // n-grams found in the row are weighted, the others stay 0.
+  void ApplyWeights(gsl::span<float> row_output) const {
+    const auto weight = [this](size_t i) { return i < weights_.size() ? weights_[i] : 1.0f; };
+    switch (weighting_criteria_) {
+      case kTF:
+        break;
+      case kIDF:
+        for (size_t i = 0; i < row_output.size(); ++i) {
+          if (row_output[i] > 0.0f) {
+            row_output[i] = weight(i);
+          }
+        }
+        break;
+      case kTFIDF:
+        for (size_t i = 0; i < row_output.size(); ++i) {
+          if (row_output[i] > 0.0f) {
+            row_output[i] *= weight(i);
+          }
+        }
+        break;
+      case kNone:  // fall-through
+      default:
+        assert(false);
+    }
+  }
 };
 
 TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), impl_(std::make_unique<Impl>()) {
@@ -221,6 +360,13 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
     ORT_ENFORCE(status.IsOK() && !pool_int64s.empty(), "non-empty pool_int64s is required if pool_strings not provided");
   }
 
+  std::vector<int64_t> pool_string_tokens;
+  pool_string_tokens.reserve(pool_strings.size());
+  for (const std::string& str : pool_strings) {
+    impl_->pool_string_ids_.Emplace(str, static_cast<int64_t>(impl_->pool_string_ids_.size()));
+    pool_string_tokens.push_back(*impl_->pool_string_ids_.Find(str));
+  }
+
   // Iterator via the pool. Insert 1 item for 1-grams, 2 items for 2-grams, etc.
   const auto total_items = (pool_strings.empty()) ? pool_int64s.size() : pool_strings.size();
   size_t ngram_id = 1;  // start with 1, 0 - means no n-gram
@@ -241,9 +387,9 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
         if (pool_strings.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
+          ngram_id = impl_->automaton_.Add(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id);
         } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+          ngram_id = impl_->automaton_.Add(pool_string_tokens.begin() + start_idx, ngrams, ngram_size, ngram_id);
         }
       } else {
         ngram_id += ngrams;
@@ -251,82 +397,12 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
     }
     ++ngram_size;
   }
+  impl_->automaton_.Finalize();
+  impl_->pool_is_string_ = !pool_strings.empty();
 }
 
 TfIdfVectorizer::~TfIdfVectorizer() = default;
 
-void TfIdfVectorizer::ComputeImpl(const void* x_data_raw, size_t elem_size, ptrdiff_t row_num, size_t row_size,
-                                  bool is_input_string, gsl::span<float> output_data,
-                                  std::function<void(size_t, gsl::span<float>&)>& fn_weight) const {
-  const void* const row_begin = AdvanceElementPtr(x_data_raw, row_num * row_size, elem_size);
-  const void* const row_end = AdvanceElementPtr(row_begin, row_size, elem_size);
-
-  const auto& impl = *impl_;
-  const auto max_gram_length = impl.max_gram_length_;
-  const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
-  auto start_ngram_size = impl.min_gram_length_;
-  size_t output_idx;
-
-  for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = row_begin;
-    auto const ngram_row_end = row_end;
-
-    while (ngram_start < ngram_row_end) {
-      // We went far enough so no n-grams of any size can be gathered
-      auto at_least_this = AdvanceElementPtr(ngram_start, SafeInt<size_t>(skip_distance) * (start_ngram_size - 1), elem_size);
-      if (at_least_this >= ngram_row_end) {
-        break;
-      }
-
-      auto ngram_item = ngram_start;
-      if (is_input_string) {
-        const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
-        for (auto ngram_size = 1;
-             !str_map->empty() &&
-             ngram_size <= max_gram_length &&
-             str_item < ngram_row_end;
-             ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            output_idx = impl.OutputIdToIncrement(hit->second->id_);
-            fn_weight(output_idx, output_data);
-          }
-          str_map = &hit->second->leafs_;
-        }
-      } else {
-        const IntMap* int_map = &impl.int64_map_;
-        for (auto ngram_size = 1;
-             !int_map->empty() &&
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
-          int64_t val = (elem_size == 4) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            output_idx = impl.OutputIdToIncrement(hit->second->id_);
-            fn_weight(output_idx, output_data);
-          }
-          int_map = &hit->second->leafs_;
-        }
-      }
-      // Sliding window shift
-      ngram_start = AdvanceElementPtr(ngram_start, 1, elem_size);
-    }
-    // We count UniGrams only once since they are not affected
-    // by skip distance
-    if (start_ngram_size == 1 && ++start_ngram_size > max_gram_length) {
-      break;
-    }
-  }
-}
-
 Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   auto X = ctx->Input<Tensor>(0);
   auto& input_shape = X->Shape();
@@ -372,9 +448,7 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   auto output_data = Y->MutableData<float>();
   const bool is_input_string = X->IsDataTypeString();
 
-  if (total_items == 0 ||
-      (is_input_string && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+  if (total_items == 0 || impl.automaton_.empty() || is_input_string != impl.pool_is_string_) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
@@ -384,48 +458,71 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  auto x_data_raw = ctx->Input<Tensor>(0)->DataRaw();
-  const auto elem_size = X->DataType()->Size();
-  int32_t num_batches = std::min<int32_t>(concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()) * 2, num_rows);
-
-  const auto& w = impl.weights_;
-  std::function<void(size_t, gsl::span<float>&)> fn_weight;
-
-  switch (impl.weighting_criteria_) {
-    case kTF:
-      fn_weight = [](size_t i, gsl::span<float>& out) { out[i] += 1.0f; };
-      break;
-    case kIDF:
-      if (!w.empty()) {
-        fn_weight = [&w](size_t i, gsl::span<float>& out) { out[i] = w[i]; };
-      } else {
-        fn_weight = [](size_t i, gsl::span<float>& out) { out[i] = 1.0f; };
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const auto lanes = impl.MakeLanes();
+  const size_t output_size = impl.output_size_;
+
+  // Counts the n-grams of the given lanes of a row into counts.
+  auto count_row = [&impl, &lanes, X, is_input_string, C](ptrdiff_t row_num, size_t first_lane, size_t end_lane,
+                                                          gsl::span<float> counts) {
+    const size_t row_offset = SafeInt<size_t>(row_num) * C;
+    if (is_input_string) {
+      // String rows are translated into pool token ids once, with a batched lookup.
+      // Strings that are not in the pool become -1 which never matches an n-gram item.
+      InlinedVector<int64_t> row_tokens(C);
+      impl.pool_string_ids_.FindAll(X->Data<std::string>() + row_offset, C, row_tokens.data(), int64_t{-1});
+      for (size_t lane = first_lane; lane < end_lane; ++lane) {
+        impl.CountLane(row_tokens.data(), C, lanes[lane], counts);
       }
-      break;
-    case kTFIDF:
-      if (!w.empty()) {
-        fn_weight = [&w](size_t i, gsl::span<float>& out) { out[i] += w[i]; };
-      } else {
-        fn_weight = [](size_t i, gsl::span<float>& out) { out[i] += 1.0f; };
+    } else if (X->IsDataType<int32_t>()) {
+      for (size_t lane = first_lane; lane < end_lane; ++lane) {
+        impl.CountLane(X->Data<int32_t>() + row_offset, C, lanes[lane], counts);
+      }
+    } else {
+      for (size_t lane = first_lane; lane < end_lane; ++lane) {
+        impl.CountLane(X->Data<int64_t>() + row_offset, C, lanes[lane], counts);
       }
-      break;
-    case kNone:  // fall-through
-    default:
-      assert(false);
-  }
-
-  std::function<void(ptrdiff_t)> fn = [this, C, output_data, x_data_raw, elem_size,
-                                       is_input_string, num_batches, num_rows, &fn_weight](ptrdiff_t batch_num) {
-    // Frequency holder allocate [B..output_size_] and init all to zero.
-    auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_batches, static_cast<size_t>(num_rows));
-    for (auto row_num = work.start; row_num < work.end; ++row_num) {
-      auto out = gsl::span<float>(output_data + row_num * this->impl_->output_size_, this->impl_->output_size_);
-      std::fill(out.begin(), out.end(), 0.0f);
-      ComputeImpl(x_data_raw, elem_size, row_num, C, is_input_string, out, fn_weight);
     }
   };
 
-  concurrency::ThreadPool::TrySimpleParallelFor(ctx->GetOperatorThreadPool(), num_batches, std::move(fn));
+  const int32_t degree_of_parallelism = concurrency::ThreadPool::DegreeOfParallelism(tp);
+  if (num_rows >= degree_of_parallelism || lanes.size() == 1) {
+    // Enough rows to keep every thread busy: each row is scanned by one thread and counted in place.
+    const int32_t num_batches = std::min<int32_t>(degree_of_parallelism * 2, num_rows);
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_batches, [&](ptrdiff_t batch_num) {
+      auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_batches, static_cast<size_t>(num_rows));
+      for (auto row_num = work.start; row_num < work.end; ++row_num) {
+        auto out = gsl::span<float>(output_data + row_num * output_size, output_size);
+        std::fill(out.begin(), out.end(), 0.0f);
+        count_row(row_num, 0, lanes.size(), out);
+        impl.ApplyWeights(out);
+      }
+    });
+  } else {
+    // Few long rows, e.g. a single document: split the lanes of each row across threads,
+    // each with its own count buffer, and sum the buffers afterwards.
+    const auto num_batches = static_cast<ptrdiff_t>(std::min<size_t>(degree_of_parallelism, lanes.size()));
+    std::vector<float> batch_counts(SafeInt<size_t>(num_batches) * output_size);
+    for (ptrdiff_t row_num = 0; row_num < num_rows; ++row_num) {
+      std::fill(batch_counts.begin(), batch_counts.end(), 0.0f);
+      concurrency::ThreadPool::TrySimpleParallelFor(tp, num_batches, [&](ptrdiff_t batch_num) {
+        auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_batches, lanes.size());
+        count_row(row_num, work.start, work.end,
+                  gsl::span<float>(batch_counts.data() + batch_num * output_size, output_size));
+      });
+
+      auto out = gsl::span<float>(output_data + row_num * output_size, output_size);
+      std::copy_n(batch_counts.begin(), output_size, out.begin());
+      for (ptrdiff_t batch_num = 1; batch_num < num_batches; ++batch_num) {
+        const float* counts = batch_counts.data() + batch_num * output_size;
+        for (size_t i = 0; i < output_size; ++i) {
+          out[i] += counts[i];
+        }
+      }
+      impl.ApplyWeights(out);
+    }
+  }
+
   return Status::OK();
 }
 
@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace string_batching {
+
+// Splits the strings into batches of at least kMinBatchBytes of text with at most one batch per thread.
+inline ptrdiff_t ComputeNumBatches(concurrency::ThreadPool* tp, gsl::span<const std::string> input_span) {
+  constexpr size_t kMinBatchBytes = 16 * 1024;
+  size_t total_bytes = 0;
+  for (const auto& s : input_span) {
+    total_bytes += s.size();
+  }
+  const auto max_batches = static_cast<ptrdiff_t>(std::min(input_span.size(), total_bytes / kMinBatchBytes));
+  return std::max<ptrdiff_t>(1, std::min<ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp), max_batches));
+}
+
+// The status of the first batch that failed, or OK.
+inline Status FirstError(gsl::span<const Status> statuses) {
+  for (const auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+  return Status::OK();
+}
+
+}  // namespace string_batching
+}  // namespace onnxruntime
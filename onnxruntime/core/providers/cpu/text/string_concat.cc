@@ -53,7 +53,10 @@ Status StringConcat::Compute(OpKernelContext* context) const {
                                                 output_iter++;
                                               }
                                             }};
-  UntypedBroadcastTwo(*context, broadcast_funcs);
+  // Each output element costs a string allocation plus the copies, so the work is split
+  // across threads like other element-wise ops.
+  constexpr double kStringConcatUnitCost = 16.0;
+  UntypedBroadcastTwo(*context, broadcast_funcs, kStringConcatUnitCost);
   return Status::OK();
 }
 
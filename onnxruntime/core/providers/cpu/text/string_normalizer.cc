@@ -3,7 +3,10 @@
 
 #include "string_normalizer.h"
 #include "core/common/common.h"
+#include "core/common/utf8_util.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/text/string_batching.h"
 // Used below HAS_DEPRECATED_DECLARATIONS
 #include "onnxruntime_config.h"
 
@@ -14,6 +17,7 @@
 #include <codecvt>
 #include <locale>
 #include <functional>
+#include <optional>
 
 #if defined(__GNUC__)
 // Allow deprecated-declarations warning - std::codecvt_utf8 is deprecatedd
@@ -435,9 +439,113 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS and not Apple
 #endif
 
 #endif  // _MSC_VER
+
+bool IsAscii(const std::string& s) {
+  return utf8_util::is_ascii(reinterpret_cast<const unsigned char*>(s.data()), s.size());
+}
+
+void ChangeCaseAscii(StringNormalizer::CaseAction caseaction, const std::string& src, std::string& dest) {
+  assert(caseaction != StringNormalizer::NONE);
+  dest.resize(src.size());
+  if (caseaction == StringNormalizer::LOWER) {
+    utf8_util::ascii_to_lower(src.data(), src.size(), dest.data());
+  } else {
+    utf8_util::ascii_to_upper(src.data(), src.size(), dest.data());
+  }
+}
+
+// Returns true if the locale maps every ASCII character the same way the plain ASCII case
+// conversion does, so ASCII strings can skip the round trip through wchar_t.
+// This is not the case e.g. for Turkish locales where 'i' is upper cased to U+0130.
+bool AsciiCaseFollowsLocale(const Locale& locale) {
+  constexpr size_t kAsciiCount = 128;
+  std::string ascii(kAsciiCount, '\0');
+  for (size_t i = 0; i < kAsciiCount; ++i) {
+    ascii[i] = static_cast<char>(i);
+  }
+
+  for (auto caseaction : {StringNormalizer::LOWER, StringNormalizer::UPPER}) {
+    std::wstring wide(ascii.begin(), ascii.end());
+    locale.ChangeCase(caseaction, wide);
+    std::string converted;
+    ChangeCaseAscii(caseaction, ascii, converted);
+    for (size_t i = 0; i < kAsciiCount; ++i) {
+      if (wide[i] != static_cast<wchar_t>(converted[i])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Per thread case conversion state. The locale is only created once a string
+// that can not take the ASCII path is seen.
+class CaseConverter {
+ public:
+  CaseConverter(const std::string& locale_name, bool ascii_fast_path)
+      : locale_name_(locale_name), ascii_fast_path_(ascii_fast_path) {}
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CaseConverter);
+
+  Status ChangeCase(StringNormalizer::CaseAction caseaction, const std::string& s, std::string& dest) {
+    if (ascii_fast_path_ && IsAscii(s)) {
+      ChangeCaseAscii(caseaction, s, dest);
+      return Status::OK();
+    }
+
+    ORT_RETURN_IF_ERROR(ToWideChar(s, wchar_buffer_));
+    GetLocale().ChangeCase(caseaction, wchar_buffer_);
+    size_t utf8_buffer_len = converter_.ComputeRequiredSizeToUtf8(wchar_buffer_);
+    dest.resize(utf8_buffer_len);
+    return converter_.ConvertToUtf8(wchar_buffer_, dest);
+  }
+
+  // Changes the case of s for comparison with wide stop words. The result stays valid
+  // until the next call.
+  Status ChangeCaseWide(StringNormalizer::CaseAction caseaction, const std::string& s, const std::wstring*& result) {
+    if (ascii_fast_path_ && IsAscii(s)) {
+      ChangeCaseAscii(caseaction, s, char_buffer_);
+      wchar_buffer_.assign(char_buffer_.begin(), char_buffer_.end());
+    } else {
+      ORT_RETURN_IF_ERROR(ToWideChar(s, wchar_buffer_));
+      GetLocale().ChangeCase(caseaction, wchar_buffer_);
+    }
+    result = &wchar_buffer_;
+    return Status::OK();
+  }
+
+  // Checks that s can be converted, which is the UTF-8 validation the other paths perform as a side effect.
+  Status Validate(const std::string& s) {
+    size_t wchars = 0;
+    return IsAscii(s) ? Status::OK() : converter_.ComputeRequiredSizeToWideChar(s, wchars);
+  }
+
+ private:
+  Status ToWideChar(const std::string& s, std::wstring& wstr) {
+    size_t wchars = 0;
+    ORT_RETURN_IF_ERROR(converter_.ComputeRequiredSizeToWideChar(s, wchars));
+    wstr.resize(wchars);
+    return converter_.ConvertToWideChar(s, wstr);
+  }
+
+  const Locale& GetLocale() {
+    if (!locale_.has_value()) {
+      locale_.emplace(locale_name_);
+    }
+    return *locale_;
+  }
+
+  const std::string& locale_name_;
+  const bool ascii_fast_path_;
+  std::optional<Locale> locale_;
+  Utf8Converter converter_;
+  std::wstring wchar_buffer_;
+  std::string char_buffer_;
+};
 }  // namespace string_normalizer
 
 using namespace string_normalizer;
+using namespace string_batching;
 
 StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info) {
   int64_t iscasesensitive = 0;
@@ -461,25 +569,30 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info) {
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
 
   std::vector<std::string> stop_words = info.GetAttrsOrDefault<std::string>("stopwords");
+  if (case_change_action_ != NONE || (!is_case_sensitive_ && !stop_words.empty())) {
+    Locale locale(locale_name_);
+    ascii_case_follows_locale_ = AsciiCaseFollowsLocale(locale);
+  }
+
   if (is_case_sensitive_) {
     stopwords_.reserve(stop_words.size());
     for (std::string& s : stop_words) {
       stopwords_.insert(std::move(s));
     }
   } else {
-    Locale locale(locale_name_);
-    Utf8Converter converter;
+    CaseConverter converter(locale_name_, ascii_case_follows_locale_);
     wstopwords_.reserve(stop_words.size());
-    for (std::string& s : stop_words) {
-      std::wstring wstr = converter.from_bytes(s);
-      locale.ChangeCase(compare_caseaction_, wstr);
-      wstopwords_.insert(std::move(wstr));
+    for (const std::string& s : stop_words) {
+      const std::wstring* wstr = nullptr;
+      ORT_THROW_IF_ERROR(converter.ChangeCaseWide(compare_caseaction_, s, wstr));
+      wstopwords_.insert(*wstr);
     }
   }
 }
 
 Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   using namespace string_normalizer;
+using namespace string_batching;
 
   auto X = ctx->Input<Tensor>(0);
   auto input_dims = X->Shape().GetDims();
@@ -505,10 +618,10 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
                   "Input dimensions are either[C > 0] or [1][C > 0] allowed");
   }
 
+  const bool filter = is_case_sensitive_ ? !stopwords_.empty() : !wstopwords_.empty();
+
   // Special case, no filtering and no case change
-  if (case_change_action_ == NONE &&
-      ((is_case_sensitive_ && stopwords_.empty()) ||
-       (!is_case_sensitive_ && wstopwords_.empty()))) {
+  if (case_change_action_ == NONE && !filter) {
     output_shape.push_back(C);
     auto output_tensor = ctx->Output(0, output_shape);
     auto const output_data = output_tensor->MutableData<std::string>();
@@ -516,121 +629,69 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  // We need to know the result dimension, and for that we need to filter
-  // the words first. If comparison mode is case sensitive, we just go ahead
-  // and compare with the original strings. Otherwise, we need to convert the string
-  // to widechar, lowercase it and then compare. Case-insensitive comparison is complicated
-  // for UTF-8 and requires additional dependency.
-
-  Locale locale(locale_name_);
-  Utf8Converter converter;
-
-  // Compute the largest widestring buffer needed.
-  size_t max_wide_buffer_len = 0;
-  for (const auto& s : input_span) {
-    size_t wchars = 0;
-    // Checks for invalid UTF-8 characters on Windows
-    ORT_RETURN_IF_ERROR(converter.ComputeRequiredSizeToWideChar(s, wchars));
-    max_wide_buffer_len = std::max(max_wide_buffer_len, wchars);
-  }
-
-  // Reuse reserved space
-  std::wstring wchar_buffer;
-  wchar_buffer.reserve(max_wide_buffer_len);
+  // Strings are processed in parallel batches, each with its own conversion buffers.
+  // ASCII strings are case converted directly when the locale agrees with the ASCII mapping.
+  // Everything else is converted to wchar_t, case changed with the locale and converted back.
+  // Case-insensitive comparison is complicated for UTF-8 and would otherwise require an
+  // additional dependency such as ICU.
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const ptrdiff_t num_batches = ComputeNumBatches(tp, input_span);
+  InlinedVector<Status> batch_status(static_cast<size_t>(num_batches));
+
+  InlinedVector<size_t> filtered_strings_indices;
+  if (filter) {
+    InlinedVector<uint8_t> keep(input_span.size(), 0);
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_batches, [&](ptrdiff_t batch_num) {
+      auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_batches,
+                                                         static_cast<ptrdiff_t>(input_span.size()));
+      CaseConverter converter(locale_name_, ascii_case_follows_locale_);
+      Status& status = batch_status[static_cast<size_t>(batch_num)];
+      for (auto i = static_cast<size_t>(work.start); i < static_cast<size_t>(work.end) && status.IsOK(); ++i) {
+        const std::string& s = input_span[i];
+        if (is_case_sensitive_) {
+          status = converter.Validate(s);
+          keep[i] = stopwords_.count(s) == 0;
+        } else {
+          const std::wstring* wstr = nullptr;
+          status = converter.ChangeCaseWide(compare_caseaction_, s, wstr);
+          keep[i] = status.IsOK() && wstopwords_.count(*wstr) == 0;
+        }
+      }
+    });
+    ORT_RETURN_IF_ERROR(FirstError(batch_status));
 
-  // Output everything and change case as required
-  auto output_no_filtering = [&](const TensorShape& output_shape) {
-    auto output_tensor = ctx->Output(0, output_shape);
-    auto const output_data = output_tensor->MutableData<std::string>();
+    filtered_strings_indices.reserve(input_span.size());
     for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-      const std::string& s = input_span[i];
-      wchar_buffer.resize(max_wide_buffer_len);
-      ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-      locale.ChangeCase(case_change_action_, wchar_buffer);
-
-      auto& dest = output_data[i];
-      size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
-      dest.resize(utf8_buffer_len);
-      ORT_RETURN_IF_ERROR(converter.ConvertToUtf8(wchar_buffer, dest));
-    }
-    return Status::OK();
-  };
-
-  auto output_filtered = [&](const TensorShape& output_shape, gsl::span<const size_t> filtered_indices) {
-    auto output_tensor = ctx->Output(0, output_shape);
-    auto output_data = output_tensor->MutableData<std::string>();
-    for (size_t i : filtered_indices) {
-      const std::string& s = input_span[i];
-      if (case_change_action_ != NONE) {
-        wchar_buffer.resize(max_wide_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(case_change_action_, wchar_buffer);
-
-        auto& dest = *output_data++;
-        size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
-        dest.resize(utf8_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToUtf8(wchar_buffer, dest));
-      } else {
-        *output_data++ = s;
+      if (keep[i]) {
+        filtered_strings_indices.push_back(i);
       }
     }
-    return Status::OK();
-  };
-
-  Status status;
 
-  if (is_case_sensitive_) {
-    if (stopwords_.empty()) {
-      assert(case_change_action_ != NONE);
-      output_shape.push_back(C);
-      status = output_no_filtering(output_shape);
-    } else {
-      // we need to filter
-      InlinedVector<size_t> filtered_strings_indices;
-      filtered_strings_indices.reserve(input_span.size());
+    // According to the spec, if all strings are filtered out
+    // the output must have a shape of {1} with a single empty string.
+    output_shape.push_back(std::max<int64_t>(1, narrow<int64_t>(filtered_strings_indices.size())));
+  } else {
+    output_shape.push_back(C);
+  }
 
-      for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-        const std::string& s = input_span[i];
-        if (stopwords_.count(s) == 0) {
-          filtered_strings_indices.push_back(i);
-        }
-      }
+  auto output_tensor = ctx->Output(0, output_shape);
+  auto const output_data = output_tensor->MutableData<std::string>();
+  const size_t output_count = filter ? filtered_strings_indices.size() : input_span.size();
 
-      // According to the spec, if all strings are filtered out
-      // the output must have a shape of {1} with a single empty string.
-      const int64_t filtered_count = std::max<int64_t>(1, narrow<int64_t>(filtered_strings_indices.size()));
-      output_shape.push_back(filtered_count);
-      status = output_filtered(output_shape, filtered_strings_indices);
-    }
-  } else {
-    if (wstopwords_.empty()) {
-      assert(case_change_action_ != NONE);
-      output_shape.push_back(C);
-      status = output_no_filtering(output_shape);
-    } else {
-      // Case insensitive filtering is performed by converting the input strings
-      // to compare_caseaction_. For that we convert to wchar_t UNICODE.
-      // Otherwise, we need to pull ICU library on all platforms.
-      InlinedVector<size_t> filtered_strings_indices;
-      filtered_strings_indices.reserve(input_span.size());
-      for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-        const std::string& s = input_span[i];
-        wchar_buffer.resize(max_wide_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(compare_caseaction_, wchar_buffer);
-        if (wstopwords_.count(wchar_buffer) == 0) {
-          filtered_strings_indices.push_back(i);
-        }
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_batches, [&](ptrdiff_t batch_num) {
+    auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_batches, static_cast<ptrdiff_t>(output_count));
+    CaseConverter converter(locale_name_, ascii_case_follows_locale_);
+    Status& status = batch_status[static_cast<size_t>(batch_num)];
+    for (auto i = static_cast<size_t>(work.start); i < static_cast<size_t>(work.end) && status.IsOK(); ++i) {
+      const std::string& s = input_span[filter ? filtered_strings_indices[i] : i];
+      if (case_change_action_ != NONE) {
+        status = converter.ChangeCase(case_change_action_, s, output_data[i]);
+      } else {
+        output_data[i] = s;
       }
-
-      // According to the spec, if all strings are filtered out
-      // the output must have a shape of {1} with a single empty string.
-      const int64_t filtered_count = std::max<int64_t>(1, narrow<int64_t>(filtered_strings_indices.size()));
-      output_shape.push_back(filtered_count);
-      status = output_filtered(output_shape, filtered_strings_indices);
     }
-  }
+  });
 
-  return status;
+  return FirstError(batch_status);
 }
 }  // namespace onnxruntime
@@ -31,6 +31,8 @@ class StringNormalizer : public OpKernel {
   // used for case-insensitive compare
   CaseAction compare_caseaction_{LOWER};
   std::string locale_name_;
+  // True if the locale changes the case of ASCII characters like the C locale does
+  bool ascii_case_follows_locale_{false};
   // Either if these are populated but not both
   InlinedHashSet<std::string> stopwords_;
   InlinedHashSet<std::wstring> wstopwords_;
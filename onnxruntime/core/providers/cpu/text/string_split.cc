@@ -6,6 +6,7 @@
 #include <limits>
 #include <string>
 #include "core/common/common.h"
+#include "core/platform/threadpool.h"
 namespace onnxruntime {
 
 ONNX_CPU_OPERATOR_KERNEL(StringSplit, 20,
@@ -36,7 +37,7 @@ void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t
         out.push_back(str.substr(pos, next_pos - pos + 1));
         break;
       } else {
-        auto next_pos = str.find_first_of(" ", pos);
+        auto next_pos = str.find(' ', pos);
         out.push_back(str.substr(pos, next_pos - pos));
         pos = str.find_first_not_of(" ", next_pos);
       }
@@ -64,22 +65,31 @@ StringSplit::StringSplit(const OpKernelInfo& info) : OpKernel(info) {
 Status StringSplit::Compute(OpKernelContext* context) const {
   const Tensor* input = context->Input<Tensor>(0);
   auto input_data = input->template DataAsSpan<std::string>();
+  const auto input_count = static_cast<std::ptrdiff_t>(input_data.size());
 
   // Set up number of tokens output
   auto num_tokens_data = context->Output(1, input->Shape())->template MutableDataAsSpan<int64_t>();
-  auto num_tokens_iter = num_tokens_data.begin();
-
-  InlinedVector<InlinedVector<std::string_view>> input_slices;
-  input_slices.reserve(input_data.size());
-  size_t last_dim = 0;
 
+  // Rows are split in parallel. The cost of a row is proportional to its length.
+  size_t total_length = 0;
   for (const auto& s : input_data) {
-    auto& substrs = input_slices.emplace_back();
-    ComputeSubstrings(s, delimiter_, maxsplit_, substrs);
-    auto substr_count = substrs.size();
-    last_dim = std::max(last_dim, substr_count);
-    *num_tokens_iter = static_cast<int64_t>(substr_count);
-    ++num_tokens_iter;
+    total_length += s.size();
+  }
+  const double average_length = input_data.empty() ? 0. : static_cast<double>(total_length) / input_data.size();
+  const TensorOpCost cost{average_length, 0., average_length};
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+
+  std::vector<InlinedVector<std::string_view>> input_slices(input_data.size());
+  concurrency::ThreadPool::TryParallelFor(tp, input_count, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (auto i = static_cast<size_t>(first), end = static_cast<size_t>(last); i < end; ++i) {
+      ComputeSubstrings(input_data[i], delimiter_, maxsplit_, input_slices[i]);
+      num_tokens_data[i] = static_cast<int64_t>(input_slices[i].size());
+    }
+  });
+
+  size_t last_dim = 0;
+  for (const auto& substrs : input_slices) {
+    last_dim = std::max(last_dim, substrs.size());
   }
 
   // Set up splits output
@@ -87,11 +97,17 @@ Status StringSplit::Compute(OpKernelContext* context) const {
   splits_shape.push_back(last_dim);
 
   auto splits_data = context->Output(0, splits_shape)->template MutableDataAsSpan<std::string>();
-  auto slices_iter = input_slices.begin();
-  for (auto output_splits_iter = splits_data.begin(); output_splits_iter != splits_data.end(); output_splits_iter += last_dim, ++slices_iter) {
-    std::copy(slices_iter->begin(), slices_iter->end(), output_splits_iter);
+  if (last_dim == 0) {
+    return Status::OK();
   }
 
+  const TensorOpCost copy_cost{average_length, average_length, average_length};
+  concurrency::ThreadPool::TryParallelFor(tp, input_count, copy_cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (auto i = static_cast<size_t>(first), end = static_cast<size_t>(last); i < end; ++i) {
+      std::copy(input_slices[i].begin(), input_slices[i].end(), splits_data.begin() + static_cast<std::ptrdiff_t>(i * last_dim));
+    }
+  });
+
   return Status::OK();
 }
 
@@ -4,6 +4,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <list>
@@ -15,6 +16,7 @@
 #include "core/common/logging/isink.h"
 #include "core/common/logging/logging.h"
 #include "core/common/parse_string.h"
+#include "core/common/perf_event_profiler.h"
 #include "core/common/path_string.h"
 #include "core/common/string_utils.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
@@ -34,6 +36,7 @@
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/run_latency_breakdown.h"
 #include "core/framework/transform_layout_functions.h"
 #include "core/framework/utils.h"
 #include "core/graph/graph_viewer.h"
@@ -71,6 +74,7 @@
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/optimized_model_cache.h"
 #include "core/util/protobuf_parsing_utils.h"
 #include "core/util/thread_utils.h"
 
@@ -570,9 +574,23 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   }
 
   session_profiler_.Initialize(session_logger_);
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfileHardwareCounters, "0") == "1") {
+    // added before profiling starts so that the counters are opened for the threads of the session thread pools
+    session_profiler_.AddEpProfilers(std::make_unique<profiling::PerfEventProfiler>());
+  }
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfileThreadPoolTrace, "0") == "1") {
+    session_profiler_.EnableThreadPoolTrace();
+  }
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
   }
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableSamplingProfiler, "0") == "1") {
+    const auto ring_buffer_size = ParseStringWithClassicLocale<size_t>(session_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigSamplingProfilerRingBufferSize, "4096"));
+    const auto sample_interval = ParseStringWithClassicLocale<uint32_t>(session_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigSamplingProfilerSampleInterval, "64"));
+    session_profiler_.EnableSampling(ring_buffer_size, sample_interval);
+  }
 
   telemetry_ = {};
 }
@@ -704,6 +722,9 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  // fail the queued RunAsync requests and wait for the running ones before anything is torn down
+  run_async_scheduler_.reset();
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -984,9 +1005,15 @@ common::Status InferenceSession::LoadOnnxModel(const PathString& model_uri) {
 #endif
     const bool strict_shape_type_inference = session_options_.config_options.GetConfigOrDefault(
                                                  kOrtSessionOptionsConfigStrictShapeTypeInference, "0") == "1";
+    ModelOptions model_options(true, strict_shape_type_inference);
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale<size_t>(
+                          session_options_.config_options.GetConfigOrDefault(
+                              kOrtSessionOptionsConfigInPlaceInitializerMinSizeInBytes, "0"),
+                          model_options.in_place_initializer_min_size),
+                      "Invalid value for ", kOrtSessionOptionsConfigInPlaceInitializerMinSizeInBytes);
+    ORT_RETURN_IF_ERROR(HashModelForOptimizedModelCache(model_location_));
     return onnxruntime::Model::Load(model_location_, model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
-                                    *session_logger_,
-                                    ModelOptions(true, strict_shape_type_inference));
+                                    *session_logger_, model_options);
   };
 
   common::Status st = LoadWithLoader(loader, "model_loading_uri");
@@ -1070,6 +1097,7 @@ common::Status InferenceSession::Load(const void* model_data, int model_data_len
 
     const bool strict_shape_type_inference = session_options_.config_options.GetConfigOrDefault(
                                                  kOrtSessionOptionsConfigStrictShapeTypeInference, "0") == "1";
+    ORT_RETURN_IF_ERROR(HashModelForOptimizedModelCache(model_data, static_cast<size_t>(model_data_len)));
     return onnxruntime::Model::Load(std::move(model_proto), PathString(), model,
                                     HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_,
                                     ModelOptions(true, strict_shape_type_inference));
@@ -1335,12 +1363,23 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
 }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+// Reads the ORT format model file into bytes_data_holder, or maps it into memory if map_file is true.
+// Initializers may refer to the bytes of a mapped file directly, so the mapping must live as long as the session.
 static Status LoadOrtModelBytes(const PathString& model_uri,
                                 gsl::span<const uint8_t>& bytes,
-                                std::vector<uint8_t>& bytes_data_holder) {
+                                std::vector<uint8_t>& bytes_data_holder,
+                                bool map_file,
+                                Env::MappedMemoryPtr& mapped_bytes) {
   size_t num_bytes = 0;
   ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_uri.c_str(), num_bytes));
 
+  if (map_file && num_bytes > 0 &&
+      Env::Default().MapFileIntoMemory(model_uri.c_str(), 0, num_bytes, mapped_bytes).IsOK()) {
+    bytes = gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(mapped_bytes.get()), num_bytes);
+    return Status::OK();
+  }
+
+  // fall back to reading the file if it can't be mapped
   bytes_data_holder.resize(num_bytes);
 
   std::ifstream bytes_stream(model_uri, std::ifstream::in | std::ifstream::binary);
@@ -1361,8 +1400,10 @@ Status InferenceSession::LoadOrtModel(const PathString& model_uri) {
   return LoadOrtModelWithLoader(
       [&]() {
         model_location_ = model_uri;
-        ORT_RETURN_IF_ERROR(
-            LoadOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+        ORT_RETURN_IF_ERROR(LoadOrtModelBytes(model_location_, ort_format_model_bytes_,
+                                              ort_format_model_bytes_data_holder_,
+                                              UseOrtModelBytesForInitializers(),
+                                              ort_format_model_mapped_bytes_));
         return Status::OK();
       });
 }
@@ -1407,6 +1448,15 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
 
   ORT_RETURN_IF_ERROR(load_ort_format_model_bytes());
 
+  return CreateModelFromOrtFormatBytes();
+}
+
+bool InferenceSession::UseOrtModelBytesForInitializers() const {
+  return session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers,
+                                                            "0") == "1";
+}
+
+Status InferenceSession::CreateModelFromOrtFormatBytes() {
   // Verify the ort_format_model_bytes_ is a valid InferenceSessionBuffer before we access the data
   flatbuffers::Verifier verifier(ort_format_model_bytes_.data(), ort_format_model_bytes_.size());
   ORT_RETURN_IF_NOT(fbs::VerifyInferenceSessionBuffer(verifier), "ORT model verification failed.");
@@ -1466,15 +1516,12 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
   const auto* fbs_model = fbs_session->model();
   ORT_RETURN_IF(nullptr == fbs_model, "Missing Model. Invalid ORT format model.");
 
-  // if we're using the bytes directly because kOrtSessionOptionsConfigUseORTModelBytesDirectly was set and the user
-  // provided an existing buffer of bytes when creating the InferenceSession, ort_format_model_bytes_data_holder_
-  // will be empty.
+  // ort_format_model_bytes_data_holder_ is empty if we're using bytes the user provided when creating the
+  // InferenceSession because kOrtSessionOptionsConfigUseORTModelBytesDirectly was set, or bytes of a mapped file.
   // if that is the case we also allow creating initializers that directly use those bytes.
-  const auto& config_options = session_options_.config_options;
   using_ort_model_bytes_for_initializers_ =
       load_options.can_use_flatbuffer_for_initializers =
-          ort_format_model_bytes_data_holder_.empty() &&
-          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "0") == "1";
+          ort_format_model_bytes_data_holder_.empty() && UseOrtModelBytesForInitializers();
 
   // need to go from unique_ptr to shared_ptr when moving into model_
   std::unique_ptr<Model> tmp_model;
@@ -1514,6 +1561,123 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
   return Status::OK();
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+Status InferenceSession::HashModelForOptimizedModelCache(const void* model_data, size_t model_data_len) {
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigOptimizedModelCacheDir, "").empty()) {
+    return Status::OK();
+  }
+
+  optimized_model_cache::KeyBuilder key_builder;
+  key_builder.Add(model_data, model_data_len);
+  optimized_model_cache_model_hash_ = key_builder.GetKey();
+  return Status::OK();
+}
+
+Status InferenceSession::HashModelForOptimizedModelCache(const PathString& model_uri) {
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigOptimizedModelCacheDir, "").empty()) {
+    return Status::OK();
+  }
+
+  optimized_model_cache::KeyBuilder key_builder;
+  ORT_RETURN_IF_ERROR(key_builder.AddFileContents(model_uri));
+  optimized_model_cache_model_hash_ = key_builder.GetKey();
+  return Status::OK();
+}
+
+Status InferenceSession::LookUpOptimizedModelCache(PathString& entry_path, std::string& key) {
+  entry_path.clear();
+  key.clear();
+
+  const std::string cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigOptimizedModelCacheDir, "");
+  if (cache_dir.empty()) {
+    return Status::OK();
+  }
+
+  const char* not_cacheable_reason = nullptr;
+  if (optimized_model_cache_model_hash_.empty()) {
+    not_cacheable_reason = "the model was not loaded from a file path or a byte array";
+  } else if (!session_options_.optimized_model_filepath.empty()) {
+    not_cacheable_reason = "the optimized model is saved to optimized_model_filepath";
+  } else if (HasLocalSchema()) {
+    not_cacheable_reason = "the session has custom op schemas";
+  }
+#if !defined(DISABLE_EXTERNAL_INITIALIZERS)
+  else if (!session_options_.external_initializers.empty() ||
+           !session_options_.external_initializer_files_mmap.empty()) {
+    not_cacheable_reason = "external initializers are provided via session options";
+  }
+#endif
+
+  optimized_model_cache::KeyBuilder key_builder;
+  if (not_cacheable_reason == nullptr) {
+    key_builder.Add(ORT_VERSION);
+    key_builder.Add(optimized_model_cache_model_hash_);
+
+    // the model file itself is already covered by the model hash
+    InlinedHashSet<PathString> hashed_files{model_location_};
+    bool cacheable = true;
+    ORT_RETURN_IF_ERROR(key_builder.AddExternalData(model_->MainGraph(), model_location_, hashed_files, cacheable));
+    if (!cacheable) {
+      not_cacheable_reason = "initializers refer to memory provided by the user";
+    }
+  }
+
+  if (not_cacheable_reason != nullptr) {
+    LOGS(*session_logger_, INFO) << "The optimized model cache is not used as " << not_cacheable_reason << ".";
+    return Status::OK();
+  }
+
+  key_builder.AddSessionOptions(session_options_, optimizers_to_disable_);
+  key_builder.AddExecutionProviders(execution_providers_);
+  key_builder.AddCpuFeatures();
+  key = key_builder.GetKey();
+  entry_path = optimized_model_cache::GetEntryPath(ToPathString(cache_dir), key);
+
+  size_t entry_size = 0;
+  if (!Env::Default().GetFileLength(entry_path.c_str(), entry_size).IsOK()) {
+    LOGS(*session_logger_, INFO) << "No optimized model cache entry " << ToUTF8String(entry_path);
+    return Status::OK();
+  }
+
+  // keep the ONNX model so we can fall back to it if the entry can't be loaded
+  std::shared_ptr<Model> onnx_model = model_;
+  Status status = LoadOrtModelBytes(entry_path, ort_format_model_bytes_, ort_format_model_bytes_data_holder_,
+                                    UseOrtModelBytesForInitializers(), ort_format_model_mapped_bytes_);
+  if (status.IsOK()) {
+    status = CreateModelFromOrtFormatBytes();
+  }
+
+  if (status.IsOK()) {
+    const auto& metadata = model_->MetaData();
+    const auto entry_key = metadata.find(optimized_model_cache::kKeyMetadataProperty);
+    if (entry_key == metadata.end() || entry_key->second != key) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The entry was created for a different key.");
+    } else {
+      // the property is not part of the user's model
+      model_->SetMetaDataProperty(optimized_model_cache::kKeyMetadataProperty, std::nullopt);
+      status = SaveModelMetadata(*model_);
+    }
+  }
+
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Ignoring optimized model cache entry " << ToUTF8String(entry_path)
+                                    << " that failed to load: " << status.ErrorMessage();
+    ort_format_model_bytes_ = gsl::span<const uint8_t>();
+    std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+    ort_format_model_mapped_bytes_.reset();
+    if (model_ != onnx_model) {
+      model_ = std::move(onnx_model);
+      ORT_RETURN_IF_ERROR(SaveModelMetadata(*model_));
+    }
+    return Status::OK();
+  }
+
+  LOGS(*session_logger_, INFO) << "Loaded optimized model from cache entry " << ToUTF8String(entry_path);
+  return Status::OK();
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 bool InferenceSession::IsInitialized() const {
   std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
   return is_inited_;
@@ -1677,9 +1841,8 @@ common::Status InferenceSession::Initialize() {
     }
 
     // Verify that there are no external initializers in the graph if external data is disabled.
-    onnxruntime::Graph& graph = model_->MainGraph();
 #ifdef DISABLE_EXTERNAL_INITIALIZERS
-    const InitializedTensorSet& initializers = graph.GetAllInitializedTensors();
+    const InitializedTensorSet& initializers = model_->MainGraph().GetAllInitializedTensors();
     for (const auto& it : initializers) {
       if (utils::HasExternalData(*it.second)) {
         return common::Status(common::ONNXRUNTIME, common::FAIL,
@@ -1701,6 +1864,17 @@ common::Status InferenceSession::Initialize() {
     // re-acquire mutex
     std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // a cache hit replaces model_ with the optimized ORT format model, which is then loaded like any other ORT
+    // format model below rather than being optimized again
+    PathString optimized_model_cache_entry_path;
+    std::string optimized_model_cache_key;
+    ORT_RETURN_IF_ERROR_SESSIONID_(LookUpOptimizedModelCache(optimized_model_cache_entry_path,
+                                                             optimized_model_cache_key));
+#endif
+
+    onnxruntime::Graph& graph = model_->MainGraph();
+
 #if !defined(DISABLE_EXTERNAL_INITIALIZERS) && !defined(ORT_MINIMAL_BUILD)
     if (!session_options_.external_initializers.empty()) {
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.InjectExternalInitializedTensors(session_options_.external_initializers));
@@ -1996,6 +2170,35 @@ common::Status InferenceSession::Initialize() {
 
       // Update temporary copies of metadata, input- and output definitions to the same state as the resolved graph
       ORT_RETURN_IF_ERROR_SESSIONID_(SaveModelMetadata(*model_));
+
+      // add the optimized graph to the cache before the session state takes over the initializers.
+      // failing to do so only costs the optimization time of the next session so it is not an error.
+      if (!optimized_model_cache_entry_path.empty()) {
+        Status cache_status = Status::OK();
+        for (const auto& node : graph.Nodes()) {
+          if (node.NodeType() == Node::Type::Fused) {
+            cache_status = ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "The graph contains compiled nodes.");
+            break;
+          }
+        }
+
+        if (cache_status.IsOK()) {
+          model_->SetMetaDataProperty(optimized_model_cache::kKeyMetadataProperty, optimized_model_cache_key);
+          cache_status = optimized_model_cache::WriteEntry(optimized_model_cache_entry_path,
+                                                           [this](const PathString& file_path) {
+                                                             return SaveToOrtFormat(file_path);
+                                                           });
+          model_->SetMetaDataProperty(optimized_model_cache::kKeyMetadataProperty, std::nullopt);
+        }
+
+        if (cache_status.IsOK()) {
+          LOGS(*session_logger_, INFO) << "Added optimized model cache entry "
+                                       << ToUTF8String(optimized_model_cache_entry_path);
+        } else {
+          LOGS(*session_logger_, WARNING) << "Failed to add the optimized model to the cache: "
+                                          << cache_status.ErrorMessage();
+        }
+      }
 #else   // !defined(ORT_MINIMAL_BUILD)
       ORT_RETURN_IF_ERROR_SESSIONID_(
           ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -2073,6 +2276,7 @@ common::Status InferenceSession::Initialize() {
     if (!using_ort_model_bytes_for_initializers_) {
       ort_format_model_bytes_ = gsl::span<const uint8_t>();
       std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+      ort_format_model_mapped_bytes_.reset();
     }
 
     // once the model is saved, we may remove unnecessary attributes for inference
@@ -2117,6 +2321,10 @@ common::Status InferenceSession::Initialize() {
     }
   }
 
+  if (status.IsOK()) {
+    WarmUpFromSessionOptions();
+  }
+
   return status;
 }
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -2462,6 +2670,14 @@ Status InferenceSession::Run(const RunOptions& run_options,
     tp = session_profiler_.Start();
   }
 
+  // breakdown of the latency of this run, returned in the run options
+  std::optional<RunLatencyBreakdown> latency_breakdown;
+  TimePoint run_start_time;
+  if (run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigEnableLatencyBreakdown, "0") == "1") {
+    run_start_time = std::chrono::high_resolution_clock::now();
+    latency_breakdown.emplace();
+  }
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   TraceLoggingActivity<telemetry_provider_handle> ortrun_activity;
   ortrun_activity.SetRelatedActivity(session_activity);
@@ -2511,8 +2727,15 @@ Status InferenceSession::Run(const RunOptions& run_options,
       // log evaluation start to trace logging provider
       env.GetTelemetryProvider().LogEvaluationStart();
 
+      TimePoint phase_start;
+      if (latency_breakdown.has_value()) {
+        phase_start = std::chrono::high_resolution_clock::now();
+      }
       ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
       ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+      if (latency_breakdown.has_value()) {
+        latency_breakdown->AddPhase(RunLatencyBreakdown::Phase::kInputValidation, phase_start);
+      }
 
       // shrink certain default memory arenas if the user has requested for it
       const std::string& shrink_memory_arenas =
@@ -2522,6 +2745,9 @@ Status InferenceSession::Run(const RunOptions& run_options,
         ORT_RETURN_IF_ERROR_SESSIONID_(ValidateAndParseShrinkArenaString(shrink_memory_arenas, arenas_to_shrink));
       }
 
+      if (latency_breakdown.has_value()) {
+        phase_start = std::chrono::high_resolution_clock::now();
+      }
       FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
       FeedsFetchesManager feeds_fetches_manager{std::move(info)};
 
@@ -2534,6 +2760,9 @@ Status InferenceSession::Run(const RunOptions& run_options,
           fetch_info[i].target_device = fetch_device_info[i];
         }
       }
+      if (latency_breakdown.has_value()) {
+        latency_breakdown->AddPhase(RunLatencyBreakdown::Phase::kAllocationAndPlanning, phase_start);
+      }
 
       if (!run_options.run_tag.empty()) {
         LOGS(*session_logger_, INFO) << "Running with tag: " << run_options.run_tag;
@@ -2589,7 +2818,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
 #ifdef ORT_ENABLE_STREAM
                                      device_stream_collection_holder,
 #endif
-                                     run_logger);
+                                     run_logger,
+                                     latency_breakdown.has_value() ? &*latency_breakdown : nullptr);
       }
 
       // info all execution providers InferenceSession:Run ended
@@ -2642,9 +2872,19 @@ Status InferenceSession::Run(const RunOptions& run_options,
   // log evaluation stop to trace logging provider
   env.GetTelemetryProvider().LogEvaluationStop();
 
+  if (latency_breakdown.has_value()) {
+    run_options.latency_breakdown.Set(latency_breakdown->ToJson(run_start_time));
+  }
+
   // send out profiling events (optional)
   if (session_profiler_.IsEnabled()) {
-    session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_run", tp);
+    // cumulative lookups of the memory patterns cached per input shape signature
+    uint64_t shape_cache_hits = 0;
+    uint64_t shape_cache_misses = 0;
+    session_state_->GetMemoryPatternCacheStats(shape_cache_hits, shape_cache_misses);
+    session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_run", tp,
+                                            {{"shape_cache_hits", std::to_string(shape_cache_hits)},
+                                             {"shape_cache_misses", std::to_string(shape_cache_misses)}});
   }
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   TraceLoggingWriteStop(ortrun_activity, "OrtRun");
@@ -2736,6 +2976,34 @@ Status InferenceSession::Run(const RunOptions& run_options,
   return Status::OK();
 }
 
+common::Status InferenceSession::GetRunAsyncScheduler(RunAsyncScheduler*& scheduler) {
+  std::lock_guard<onnxruntime::OrtMutex> l(run_async_scheduler_mutex_);
+  if (!run_async_scheduler_) {
+    const auto& config_options = session_options_.config_options;
+
+    // by default as many requests run at once as the intra-op thread pool has threads
+    size_t max_in_flight = static_cast<size_t>(
+        std::max(1, concurrency::ThreadPool::DegreeOfParallelism(GetIntraOpThreadPoolToUse())));
+    std::string config_value;
+    if (config_options.TryGetConfigEntry(kOrtSessionOptionsConfigRunAsyncMaxInFlight, config_value)) {
+      ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(config_value, max_in_flight) && max_in_flight > 0,
+                        "Invalid value for ", kOrtSessionOptionsConfigRunAsyncMaxInFlight, ": ", config_value,
+                        ". A positive integer is required.");
+    }
+
+    size_t max_queue_size = 0;
+    if (config_options.TryGetConfigEntry(kOrtSessionOptionsConfigRunAsyncMaxQueueSize, config_value)) {
+      ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(config_value, max_queue_size),
+                        "Invalid value for ", kOrtSessionOptionsConfigRunAsyncMaxQueueSize, ": ", config_value);
+    }
+
+    run_async_scheduler_ = std::make_unique<RunAsyncScheduler>(max_in_flight, max_queue_size);
+  }
+
+  scheduler = run_async_scheduler_.get();
+  return Status::OK();
+}
+
 common::Status InferenceSession::RunAsync(const RunOptions* run_options,
                                           gsl::span<const char* const> feed_names,
                                           gsl::span<const OrtValue* const> feeds,
@@ -2743,33 +3011,36 @@ common::Status InferenceSession::RunAsync(const RunOptions* run_options,
                                           gsl::span<OrtValue*> fetches,
                                           RunAsyncCallbackFn callback,
                                           void* user_data) {
-  size_t num_fetches = fetch_names.size();
-  auto* tp = GetIntraOpThreadPoolToUse();
-  if (!tp || concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "intra op thread pool must have at least one thread for RunAsync");
-  }
-  std::function<void()> run_fn = [=]() {
-    Status status = Status::OK();
-    ORT_TRY {
-      if (run_options) {
-        status = Run(*run_options, feed_names, feeds, fetch_names, fetches);
-      } else {
-        RunOptions default_run_options;
-        status = Run(default_run_options, feed_names, feeds, fetch_names, fetches);
-      }
-    }
-    ORT_CATCH(const std::exception& ex) {
-      ORT_HANDLE_EXCEPTION([&]() {
-        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
-      });
+  RunAsyncScheduler* scheduler = nullptr;
+  ORT_RETURN_IF_ERROR(GetRunAsyncScheduler(scheduler));
+
+  RunAsyncScheduler::Request request;
+  request.run_options = run_options;
+  if (run_options) {
+    std::string config_value;
+    if (run_options->config_options.TryGetConfigEntry(kOrtRunOptionsConfigRunAsyncPriority, config_value)) {
+      ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(config_value, request.priority),
+                        "Invalid value for ", kOrtRunOptionsConfigRunAsyncPriority, ": ", config_value);
     }
-    ORT_CATCH(...) {
-      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "unknown exception");
+
+    if (run_options->config_options.TryGetConfigEntry(kOrtRunOptionsConfigRunAsyncDeadlineMs, config_value)) {
+      int64_t deadline_ms = 0;
+      ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(config_value, deadline_ms) && deadline_ms > 0,
+                        "Invalid value for ", kOrtRunOptionsConfigRunAsyncDeadlineMs, ": ", config_value,
+                        ". A positive integer is required.");
+      request.deadline = RunAsyncScheduler::Clock::now() + std::chrono::milliseconds(deadline_ms);
     }
+  }
+
+  const size_t num_fetches = fetch_names.size();
+  request.run_fn = [this, feed_names, feeds, fetch_names, fetches](const RunOptions& request_run_options) {
+    return Run(request_run_options, feed_names, feeds, fetch_names, fetches);
+  };
+  request.done_fn = [callback, user_data, fetches, num_fetches](Status status) {
     callback(user_data, fetches.data(), status.IsOK() ? num_fetches : 0, ToOrtStatus(status));
-  };  // run_fn
-  concurrency::ThreadPool::Schedule(tp, run_fn);
-  return Status::OK();
+  };
+
+  return scheduler->Submit(std::move(request));
 }
 
 common::Status InferenceSession::Run(const NameMLValMap& feeds, gsl::span<const std::string> output_names,
@@ -2869,6 +3140,136 @@ common::Status InferenceSession::Run(IOBinding& io_binding) {
   return Run(run_options, io_binding);
 }
 
+namespace {
+// Parses the value of kOrtSessionOptionsConfigWarmUpInputShapes, e.g. "a:1x3x224x224,b:1;a:4x3x224x224,b:4"
+Status ParseWarmUpInputShapes(std::string_view value, std::vector<InlinedHashMap<std::string, TensorShape>>& sets) {
+  for (const auto shape_set : utils::SplitString(value, ";")) {
+    auto& input_shapes = sets.emplace_back();
+    for (const auto input_shape : utils::SplitString(shape_set, ",")) {
+      const auto separator = input_shape.rfind(':');
+      ORT_RETURN_IF(separator == std::string_view::npos || separator == 0,
+                    "Invalid input shape '", input_shape, "' in ", kOrtSessionOptionsConfigWarmUpInputShapes,
+                    ". Expected name:dims.");
+      TensorShapeVector dims;
+      for (const auto dim : utils::SplitString(input_shape.substr(separator + 1), "x")) {
+        int64_t dim_value = 0;
+        ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(dim, dim_value) && dim_value >= 0,
+                          "Invalid dimension '", dim, "' in ", kOrtSessionOptionsConfigWarmUpInputShapes, ".");
+        dims.push_back(dim_value);
+      }
+      input_shapes.insert_or_assign(std::string{input_shape.substr(0, separator)}, TensorShape(dims));
+    }
+  }
+  return Status::OK();
+}
+}  // namespace
+
+common::Status InferenceSession::WarmUp(const RunOptions& run_options,
+                                        gsl::span<const InlinedHashMap<std::string, TensorShape>> input_shapes,
+                                        std::chrono::microseconds* duration) {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      LOGS(*session_logger_, ERROR) << "Session was not initialized";
+      return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+    }
+  }
+
+  TimePoint tp;
+  if (session_profiler_.IsEnabled()) {
+    tp = session_profiler_.Start();
+  }
+  const auto start = std::chrono::steady_clock::now();
+
+  const Graph& graph = model_->MainGraph();
+  InlinedVector<std::string> output_names;
+  output_names.reserve(graph.GetOutputs().size());
+  for (const auto* output : graph.GetOutputs()) {
+    output_names.push_back(output->Name());
+  }
+
+  // the inputs are allocated outside of the session's arenas so they don't count towards their size
+  const AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+  const InlinedHashMap<std::string, TensorShape> default_shapes;
+  const size_t num_sets = std::max<size_t>(input_shapes.size(), 1);
+  for (size_t set_idx = 0; set_idx < num_sets; ++set_idx) {
+    const auto& shapes = input_shapes.empty() ? default_shapes : input_shapes[set_idx];
+
+    for (const auto& entry : shapes) {
+      const auto& inputs = graph.GetInputs();
+      ORT_RETURN_IF(std::none_of(inputs.begin(), inputs.end(),
+                                 [&entry](const NodeArg* input) { return input->Name() == entry.first; }),
+                    "Warm-up input shape given for '", entry.first, "' which is not a required input of the model.");
+    }
+
+    InlinedVector<std::string> feed_names;
+    InlinedVector<OrtValue> feeds;
+    for (const auto* input : graph.GetInputs()) {
+      const auto* type = input->TypeAsProto();
+      ORT_RETURN_IF_NOT(type != nullptr && utils::HasTensorType(*type),
+                        "Warm-up only supports tensor inputs. Input '", input->Name(), "' is not a tensor.");
+
+      TensorShape shape;
+      if (auto hint = shapes.find(input->Name()); hint != shapes.end()) {
+        shape = hint->second;
+      } else {
+        const auto* shape_proto = input->Shape();
+        ORT_RETURN_IF(shape_proto == nullptr, "Input '", input->Name(),
+                      "' has an unknown rank. Its shape must be given to warm up the session.");
+        TensorShapeVector dims;
+        for (const auto& dim : shape_proto->dim()) {
+          dims.push_back(utils::HasDimValue(dim) ? dim.dim_value() : 1);
+        }
+        shape = TensorShape(dims);
+      }
+
+      const auto* element_type = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())->GetElementType();
+      OrtValue& feed = feeds.emplace_back();
+      Tensor::InitOrtValue(element_type, shape, cpu_allocator, feed);
+      Tensor& tensor = *feed.GetMutable<Tensor>();
+      if (!tensor.IsDataTypeString()) {
+        memset(tensor.MutableDataRaw(), 0, tensor.SizeInBytes());
+      }
+      feed_names.push_back(input->Name());
+    }
+
+    // the second run allocates the memory pattern created by the first one
+    const int num_runs = session_options_.enable_mem_pattern ? 2 : 1;
+    for (int run = 0; run < num_runs; ++run) {
+      std::vector<OrtValue> fetches;
+      ORT_RETURN_IF_ERROR_SESSIONID_(Run(run_options, feed_names, feeds, output_names, &fetches));
+    }
+  }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  if (duration != nullptr) {
+    *duration = elapsed;
+  }
+  if (session_profiler_.IsEnabled()) {
+    session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_warm_up", tp);
+  }
+  LOGS(*session_logger_, INFO) << "Session warmed up with " << num_sets << " set(s) of input shapes in "
+                               << elapsed.count() << " us.";
+  return Status::OK();
+}
+
+void InferenceSession::WarmUpFromSessionOptions() {
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigWarmUp, "0") != "1") {
+    return;
+  }
+
+  std::vector<InlinedHashMap<std::string, TensorShape>> input_shapes;
+  Status status = ParseWarmUpInputShapes(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigWarmUpInputShapes, ""),
+      input_shapes);
+  if (status.IsOK()) {
+    status = WarmUp(RunOptions(), input_shapes);
+  }
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Failed to warm up the session: " << status.ErrorMessage();
+  }
+}
+
 template <typename T>
 void InferenceSession::StartProfiling(const std::basic_string<T>& file_prefix) {
   std::basic_ostringstream<T> ss;
@@ -2907,6 +3308,31 @@ const profiling::Profiler& InferenceSession::GetProfiling() const {
   return session_profiler_;
 }
 
+common::Status InferenceSession::GetProfilingSnapshot(std::string& snapshot) const {
+  const auto* sampling_profiler = session_profiler_.GetSamplingProfiler();
+  ORT_RETURN_IF(sampling_profiler == nullptr, "The sampling profiler is not enabled. Set the session option ",
+                kOrtSessionOptionsConfigEnableSamplingProfiler, " to \"1\" to enable it.");
+  snapshot = sampling_profiler->Snapshot();
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetMemoryProfile(std::string& report) const {
+  ORT_RETURN_IF(session_state_ == nullptr, "The session is not initialized.");
+  const auto* memory_profiler = session_state_->GetRuntimeMemoryProfiler();
+  ORT_RETURN_IF(memory_profiler == nullptr, "The memory profiler is not enabled. Set the session option ",
+                kOrtSessionOptionsConfigEnableMemoryProfile, " to \"1\" to enable it.");
+  report = memory_profiler->Report(*session_state_);
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetThreadPoolTelemetry(std::string& telemetry) const {
+  ORT_RETURN_IF(session_state_ == nullptr, "The session is not initialized.");
+  telemetry = MakeString(
+      "{\"intra_op\": ", concurrency::ThreadPool::GetTelemetry(GetIntraOpThreadPoolToUse()).ToJson(),
+      ",\n\"inter_op\": ", concurrency::ThreadPool::GetTelemetry(GetInterOpThreadPoolToUse()).ToJson(), "}\n");
+  return Status::OK();
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 std::vector<TuningResults> InferenceSession::GetTuningResults() const {
   std::vector<TuningResults> ret;
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <optional>
 #include <string>
@@ -27,7 +28,9 @@
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/platform/env.h"
 #include "core/platform/ort_mutex.h"
+#include "core/session/run_async_scheduler.h"
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
 #endif
@@ -379,6 +382,22 @@ class InferenceSession {
   [[nodiscard]] virtual common::Status Run(const RunOptions& run_options, IOBinding& io_binding);
   [[nodiscard]] common::Status Run(IOBinding& io_binding);
 
+  /**
+   * Runs the model with synthetic zero filled inputs so that the first requests don't pay for the lazy work done by
+   * the first Run: growing the arenas, creating the memory patterns, searching tunable ops and page faults on the
+   * weights. With memory patterns enabled each set of input shapes is run twice, so the arenas are extended by the
+   * allocation of the pattern that the first run created.
+   * This API is thread-safe.
+   * @param run_options options of the warm-up runs.
+   * @param input_shapes sets of input shapes to warm up with. Symbolic dims of inputs that are not in a set are 1.
+   *        If empty, a single set with all symbolic dims set to 1 is used.
+   * @param duration optional. set to how long the warm-up took.
+   * @return OK if success.
+   */
+  [[nodiscard]] common::Status WarmUp(const RunOptions& run_options,
+                                      gsl::span<const InlinedHashMap<std::string, TensorShape>> input_shapes,
+                                      std::chrono::microseconds* duration = nullptr);
+
 #ifdef ENABLE_TRAINING
   /**
    * Partially run a pre-loaded and pre-intialized model.
@@ -485,6 +504,32 @@ class InferenceSession {
     */
   const profiling::Profiler& GetProfiling() const;
 
+  /**
+   * Get a snapshot of the always-on sampling profiler enabled by the session option
+   * "session.sampling_profiler_enable" without stopping it.
+   * @param snapshot set to a JSON document with the latency percentiles per op type and per node, and the sampled
+   *        kernel events.
+   * @return OK if success, or an error if the sampling profiler is not enabled.
+   */
+  [[nodiscard]] common::Status GetProfilingSnapshot(std::string& snapshot) const;
+
+  /**
+   * Get the report of the memory profiler enabled by the session option "session.memory_profile_enable".
+   * @param report set to a JSON document with, for the run with the highest peak, the lifetime of every activation
+   *        tensor, the timeline of allocations and frees, and the tensors and arena fragmentation at the peak of
+   *        every device.
+   * @return OK if success, or an error if the memory profiler is not enabled.
+   */
+  [[nodiscard]] common::Status GetMemoryProfile(std::string& report) const;
+
+  /**
+   * Get the counters of the thread pools used by the session, per-session or global. They are always on and count
+   * since the pools were created, so pools shared between sessions include the work of every session.
+   * @param telemetry set to a JSON document with the counters of the intra-op and inter-op thread pools.
+   * @return OK if success, or an error if the session is not initialized.
+   */
+  [[nodiscard]] common::Status GetThreadPoolTelemetry(std::string& telemetry) const;
+
 #if !defined(ORT_MINIMAL_BUILD)
   /**
    * Get the TuningResults of TunableOp for every execution providers.
@@ -613,6 +658,12 @@ class InferenceSession {
 
   [[nodiscard]] common::Status SaveModelMetadata(const onnxruntime::Model& model);
 
+  // Creates the RunAsync scheduler from the session options on first use.
+  [[nodiscard]] common::Status GetRunAsyncScheduler(RunAsyncScheduler*& scheduler);
+
+  // Warms up the session at the end of Initialize() if enabled in the session options.
+  void WarmUpFromSessionOptions();
+
 #if !defined(ORT_MINIMAL_BUILD)
 
   [[nodiscard]] common::Status LoadOnnxModel(const PathString& model_uri);
@@ -622,6 +673,15 @@ class InferenceSession {
   }
 
   common::Status SaveToOrtFormat(const PathString& filepath) const;
+
+  // Computes the optimized model cache key for this session and replaces the loaded ONNX model with the cached
+  // ORT format model if an entry exists for the key, so that the session is initialized from the ORT format bytes
+  // without optimizing the graph again. entry_path and key are left empty if the cache can't be used for this session.
+  [[nodiscard]] common::Status LookUpOptimizedModelCache(PathString& entry_path, std::string& key);
+
+  // Hashes the ONNX model bytes for the optimized model cache key if the cache is enabled.
+  [[nodiscard]] common::Status HashModelForOptimizedModelCache(const void* model_data, size_t model_data_len);
+  [[nodiscard]] common::Status HashModelForOptimizedModelCache(const PathString& model_uri);
 #endif
 
   /**
@@ -643,6 +703,12 @@ class InferenceSession {
 
   [[nodiscard]] common::Status LoadOrtModelWithLoader(std::function<Status()> load_ort_format_model_bytes);
 
+  // Creates model_ from ort_format_model_bytes_.
+  [[nodiscard]] common::Status CreateModelFromOrtFormatBytes();
+
+  // Whether "session.use_ort_model_bytes_for_initializers" is set.
+  bool UseOrtModelBytesForInitializers() const;
+
   // Create a Logger for a single execution if possible. Otherwise use the default logger.
   // If a new logger is created, it will also be stored in new_run_logger,
   // which must remain valid for the duration of the execution.
@@ -786,6 +852,10 @@ class InferenceSession {
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_ = 0;
 
+  // Executes the RunAsync requests. Created by the first RunAsync call.
+  std::unique_ptr<RunAsyncScheduler> run_async_scheduler_;
+  onnxruntime::OrtMutex run_async_scheduler_mutex_;
+
   mutable onnxruntime::OrtMutex session_mutex_;  // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;                 // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                       // GUARDED_BY(session_mutex_)
@@ -833,7 +903,9 @@ class InferenceSession {
   // If the session is started with an input byte array contains model data, and the caller does not
   // specify ORT should use the model bytes directly
   // Or the session is started with a model_uri
-  //   We store them currently in the ort_format_model_bytes_data_holder_ to make the Load + Initialize
+  //   If "session.use_ort_model_bytes_for_initializers" is "1" the file is mapped into memory and the mapping is kept
+  //   in ort_format_model_mapped_bytes_ for the lifetime of the session, as initializers refer to it directly.
+  //   Otherwise we store them currently in the ort_format_model_bytes_data_holder_ to make the Load + Initialize
   //   behave the same way as for an ONNX model, as we need some of the bytes for the Load (create the Model)
   //   and some for the Initialize (create SessionState).
   // Short term we free them after Initialize.
@@ -847,8 +919,18 @@ class InferenceSession {
   // "session.use_ort_model_bytes_directly" to "1", this will be empty
   std::vector<uint8_t> ort_format_model_bytes_data_holder_;
 
+  // Memory mapped ORT format model file. Empty unless the model was loaded from a file path with
+  // "session.use_ort_model_bytes_for_initializers" set to "1".
+  Env::MappedMemoryPtr ort_format_model_mapped_bytes_;
+
   bool using_ort_model_bytes_for_initializers_{false};
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Hash of the ONNX model bytes, which is part of the optimized model cache key.
+  // Empty if the cache is disabled or the model was not loaded from a file path or a byte array.
+  std::string optimized_model_cache_model_hash_;
+#endif
+
   // Container to store pre-packed weights to share between sessions.
   // The life-cycle of the cache itself is maintained by the user and the user will ensure
   // the cache is valid until any session reliant on it is still in scope.
@@ -2195,6 +2195,39 @@ ORT_API_STATUS_IMPL(OrtApis::SessionGetProfilingStartTimeNs, _In_ const OrtSessi
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetProfilingSnapshot, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::string snapshot;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetProfilingSnapshot(snapshot));
+  *out = StrDup(snapshot, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetMemoryProfile, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::string report;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetMemoryProfile(report));
+  *out = StrDup(report, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetThreadPoolTelemetry, _In_ const OrtSession* sess,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::string telemetry;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetThreadPoolTelemetry(telemetry));
+  *out = StrDup(telemetry, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
 // End support for non-tensor types
 
 ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfg, _In_ size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
@@ -2730,6 +2763,11 @@ static constexpr OrtApi ort_api_1_to_19 = {
     &OrtApis::KernelInfoGetAllocator,
     &OrtApis::AddExternalInitializersFromFilesInMemory,
     // End of Version 18 - DO NOT MODIFY ABOVE (see above text for more information)
+
+    &OrtApis::SessionGetProfilingSnapshot,
+    &OrtApis::SessionGetMemoryProfile,
+    &OrtApis::SessionGetThreadPoolTelemetry,
+    &OrtApis::RunOptionsGetLatencyBreakdown,
 };
 
 // OrtApiBase can never change as there is no way to know what version of OrtApiBase is returned by OrtGetApiBase.
@@ -0,0 +1,206 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/session/optimized_model_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "core/common/cpuid_info.h"
+#include "core/framework/execution_providers.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/session_options.h"
+#include "core/framework/tensor_external_data_info.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph.h"
+#include "core/platform/env.h"
+#include "core/platform/path_lib.h"
+
+namespace onnxruntime {
+namespace optimized_model_cache {
+
+void KeyBuilder::Add(std::string_view value) {
+  // hash the length as well so consecutive values can't be confused with each other
+  const uint64_t size = value.size();
+  Add(&size, sizeof(size));
+  Add(value.data(), value.size());
+}
+
+void KeyBuilder::Add(const void* data, size_t size) {
+  MurmurHash3::x86_128_chain(data, size, hash_);
+}
+
+Status KeyBuilder::AddFileContents(const PathString& file_path) {
+  std::ifstream file(file_path, std::ios::binary);
+  ORT_RETURN_IF_NOT(file, "Failed to open ", ToUTF8String(file_path), " to compute the optimized model cache key.");
+
+  constexpr size_t chunk_size = 1 << 20;
+  std::vector<char> chunk(chunk_size);
+  uint64_t file_size = 0;
+  while (file) {
+    file.read(chunk.data(), chunk_size);
+    const auto num_read = static_cast<size_t>(file.gcount());
+    Add(chunk.data(), num_read);
+    file_size += num_read;
+  }
+  ORT_RETURN_IF_NOT(file.eof(), "Failed to read ", ToUTF8String(file_path),
+                    " to compute the optimized model cache key.");
+  Add(&file_size, sizeof(file_size));
+  return Status::OK();
+}
+
+void KeyBuilder::AddSessionOptions(const SessionOptions& session_options,
+                                   const InlinedHashSet<std::string>& optimizers_to_disable) {
+  const auto optimization_level = static_cast<int>(session_options.graph_optimization_level);
+  Add(&optimization_level, sizeof(optimization_level));
+
+  std::vector<std::string_view> disabled(optimizers_to_disable.begin(), optimizers_to_disable.end());
+  std::sort(disabled.begin(), disabled.end());
+  for (const auto& name : disabled) {
+    Add(name);
+  }
+
+  for (const auto& dim_override : session_options.free_dimension_overrides) {
+    Add(dim_override.dim_identifier);
+    const auto type = static_cast<int>(dim_override.dim_identifer_type);
+    Add(&type, sizeof(type));
+    Add(&dim_override.dim_value, sizeof(dim_override.dim_value));
+  }
+
+  // all config entries are included as many of them change which transformations run
+  std::vector<std::pair<std::string_view, std::string_view>> configs(
+      session_options.config_options.configurations.begin(), session_options.config_options.configurations.end());
+  std::sort(configs.begin(), configs.end());
+  for (const auto& [key, value] : configs) {
+    Add(key);
+    Add(value);
+  }
+}
+
+void KeyBuilder::AddExecutionProviders(const ExecutionProviders& execution_providers) {
+  // the order matters as it is the priority used when partitioning
+  for (const auto& execution_provider : execution_providers) {
+    Add(execution_provider->Type());
+
+    const auto provider_options = execution_provider->GetProviderOptions();
+    std::vector<std::pair<std::string_view, std::string_view>> options(provider_options.begin(),
+                                                                       provider_options.end());
+    std::sort(options.begin(), options.end());
+    for (const auto& [key, value] : options) {
+      Add(key);
+      Add(value);
+    }
+  }
+}
+
+void KeyBuilder::AddCpuFeatures() {
+  // transformers such as the NCHWc transformer produce hardware specific graphs
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  const bool features[] = {
+      cpu_info.HasSSE3(), cpu_info.HasSSE4_1(), cpu_info.HasAVX(), cpu_info.HasAVX2(), cpu_info.HasF16C(),
+      cpu_info.HasAVX512f(), cpu_info.HasAVX512Skylake(), cpu_info.HasAVX512_BF16(), cpu_info.HasAMX_BF16(),
+      cpu_info.HasArmNeonDot(), cpu_info.HasArmNeon_I8MM(), cpu_info.HasArmSVE_I8MM(), cpu_info.HasArmNeon_BF16(),
+      cpu_info.HasFp16VectorAcceleration()};
+  Add(features, sizeof(features));
+}
+
+Status KeyBuilder::AddExternalData(const Graph& graph, const PathString& model_path,
+                                   InlinedHashSet<PathString>& skip_files, bool& cacheable) {
+  PathString model_dir;
+  if (!model_path.empty()) {
+    ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(model_path, model_dir));
+  }
+
+  // sort by name so the key doesn't depend on the iteration order of the initializers
+  std::vector<const ONNX_NAMESPACE::TensorProto*> initializers;
+  for (const auto& [name, initializer] : graph.GetAllInitializedTensors()) {
+    if (utils::HasExternalData(*initializer)) {
+      initializers.push_back(initializer);
+    }
+  }
+  std::sort(initializers.begin(), initializers.end(), [](const auto* a, const auto* b) { return a->name() < b->name(); });
+
+  for (const auto* initializer : initializers) {
+    std::unique_ptr<ExternalDataInfo> external_data_info;
+    ORT_RETURN_IF_ERROR(ExternalDataInfo::Create(initializer->external_data(), external_data_info));
+    const PathString& location = external_data_info->GetRelPath();
+    if (location == utils::kTensorProtoMemoryAddressTag) {
+      cacheable = false;
+      return Status::OK();
+    }
+
+    const PathString file_path = model_dir.empty() ? location : ConcatPathComponent(model_dir, location);
+    if (skip_files.insert(file_path).second) {
+      Add(location);
+      ORT_RETURN_IF_ERROR(AddFileContents(file_path));
+    }
+  }
+
+  for (const auto& node : graph.Nodes()) {
+    if (!node.ContainsSubgraph()) {
+      continue;
+    }
+    for (const auto& subgraph : node.GetSubgraphs()) {
+      ORT_RETURN_IF_ERROR(AddExternalData(*subgraph, model_path, skip_files, cacheable));
+      if (!cacheable) {
+        return Status::OK();
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+std::string KeyBuilder::GetKey() const {
+  constexpr char hex_digits[] = "0123456789abcdef";
+  std::string key;
+  key.reserve(sizeof(hash_) * 2);
+  for (uint32_t word : hash_) {
+    for (int shift = 28; shift >= 0; shift -= 4) {
+      key.push_back(hex_digits[(word >> shift) & 0xf]);
+    }
+  }
+  return key;
+}
+
+PathString GetEntryPath(const PathString& cache_dir, const std::string& key) {
+  return ConcatPathComponent(cache_dir, ToPathString(key + ".ort"));
+}
+
+Status WriteEntry(const PathString& entry_path, const std::function<Status(const PathString&)>& save_fn) {
+  namespace fs = std::filesystem;
+
+  const fs::path path{entry_path};
+  std::error_code error;
+  fs::create_directories(path.parent_path(), error);
+  ORT_RETURN_IF(error, "Failed to create the optimized model cache directory: ", error.message());
+
+  // the pid keeps concurrent writers from different processes apart, and the counter the sessions of this process
+  // that create the same entry at the same time
+  static std::atomic<uint64_t> num_temp_files{0};
+  const fs::path temp_path = fs::path{path}.concat(ToPathString(
+      ".tmp" + std::to_string(Env::Default().GetSelfPid()) + "_" +
+      std::to_string(num_temp_files.fetch_add(1, std::memory_order_relaxed))));
+  Status status = save_fn(temp_path.native());
+  if (status.IsOK()) {
+    fs::rename(temp_path, path, error);
+    if (error) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to add the optimized model cache entry: ", error.message());
+    }
+  }
+
+  if (!status.IsOK()) {
+    fs::remove(temp_path, error);
+  }
+  return status;
+}
+
+}  // namespace optimized_model_cache
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/path_string.h"
+
+namespace onnxruntime {
+
+class ExecutionProviders;
+class Graph;
+struct SessionOptions;
+
+// Content addressed cache of optimized models. An entry is an ORT format model holding the graph after all graph
+// transformations and partitioning, stored under a key that covers everything those depend on: the model bytes and
+// external data, the session options, the execution providers and the CPU features of the machine.
+namespace optimized_model_cache {
+
+class KeyBuilder {
+ public:
+  void Add(std::string_view value);
+  void Add(const void* data, size_t size);
+
+  // hashes the contents of the file in fixed size chunks
+  Status AddFileContents(const PathString& file_path);
+
+  void AddSessionOptions(const SessionOptions& session_options,
+                         const InlinedHashSet<std::string>& optimizers_to_disable);
+  void AddExecutionProviders(const ExecutionProviders& execution_providers);
+  void AddCpuFeatures();
+
+  // Adds the contents of the external data files of the initializers in graph and its subgraphs.
+  // Files in skip_files are already covered by the key. 'cacheable' is set to false if an initializer refers to
+  // memory provided by the user, which cannot be identified by its contents.
+  Status AddExternalData(const Graph& graph, const PathString& model_path,
+                         InlinedHashSet<PathString>& skip_files, bool& cacheable);
+
+  // 128-bit key as a hex string
+  std::string GetKey() const;
+
+ private:
+  uint32_t hash_[4] = {0, 0, 0, 0};
+};
+
+// Metadata property of an entry holding its key, so that loading an entry can check that it was created for the key.
+constexpr const char* kKeyMetadataProperty = "onnxruntime.optimized_model_cache_key";
+
+PathString GetEntryPath(const PathString& cache_dir, const std::string& key);
+
+// Calls save_fn to write a new entry to a temporary file next to entry_path, then moves it into place so other
+// processes sharing the cache directory never observe a partially written entry.
+Status WriteEntry(const PathString& entry_path, const std::function<Status(const PathString&)>& save_fn);
+
+}  // namespace optimized_model_cache
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
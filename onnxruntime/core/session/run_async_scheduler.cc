@@ -0,0 +1,211 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/run_async_scheduler.h"
+
+#include <algorithm>
+
+#include "core/session/onnxruntime_run_options_config_keys.h"
+
+namespace onnxruntime {
+
+namespace {
+// how often the terminate flag of the caller's RunOptions is forwarded to a running request with a deadline
+constexpr std::chrono::milliseconds kTerminatePollInterval{10};
+
+Status RunRequest(const std::function<Status(const RunOptions&)>& run_fn, const RunOptions& run_options) {
+  Status status = Status::OK();
+  ORT_TRY {
+    status = run_fn(run_options);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+    });
+  }
+  ORT_CATCH(...) {
+    status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "unknown exception");
+  }
+  return status;
+}
+
+Status DeadlineExceeded() {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "RunAsync request exceeded its deadline before it started.");
+}
+}  // namespace
+
+RunAsyncScheduler::RunAsyncScheduler(size_t max_in_flight, size_t max_queue_size)
+    : max_in_flight_(max_in_flight), max_queue_size_(max_queue_size) {
+  ORT_ENFORCE(max_in_flight_ > 0, "RunAsync requires at least one request in flight.");
+}
+
+RunAsyncScheduler::~RunAsyncScheduler() {
+  std::vector<QueuedRequest> queued;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    shutdown_ = true;
+    queued.swap(queue_);
+  }
+  worker_cv_.notify_all();
+  deadline_cv_.notify_all();
+
+  for (auto& queued_request : queued) {
+    queued_request.request.done_fn(
+        ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "RunAsync request cancelled as the session is being destroyed."));
+  }
+
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  if (deadline_thread_.joinable()) {
+    deadline_thread_.join();
+  }
+}
+
+bool RunAsyncScheduler::StartsAfter(const QueuedRequest& a, const QueuedRequest& b) {
+  if (a.request.priority != b.request.priority) {
+    return a.request.priority < b.request.priority;
+  }
+  return a.sequence > b.sequence;
+}
+
+Status RunAsyncScheduler::Submit(Request&& request) {
+  ORT_RETURN_IF_NOT(request.run_fn && request.done_fn, "RunAsync request requires a run and a completion function.");
+
+  const bool has_deadline = request.deadline.has_value();
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    ORT_RETURN_IF(shutdown_, "RunAsync is not available as the session is being destroyed.");
+    ORT_RETURN_IF(max_queue_size_ > 0 && queue_.size() >= max_queue_size_,
+                  "RunAsync queue is full with ", queue_.size(), " requests waiting.");
+
+    queue_.push_back({std::move(request), next_sequence_++});
+    std::push_heap(queue_.begin(), queue_.end(), StartsAfter);
+
+    // workers are started on demand so a session that never uses RunAsync doesn't own any threads
+    if (queue_.size() > num_idle_workers_ && workers_.size() < max_in_flight_) {
+      workers_.emplace_back([this]() { WorkerLoop(); });
+    }
+    if (has_deadline && !deadline_thread_.joinable()) {
+      deadline_thread_ = std::thread([this]() { DeadlineLoop(); });
+    }
+  }
+
+  worker_cv_.notify_one();
+  if (has_deadline) {
+    deadline_cv_.notify_one();
+  }
+  return Status::OK();
+}
+
+void RunAsyncScheduler::WorkerLoop() {
+  std::unique_lock<OrtMutex> lock(mutex_);
+  for (;;) {
+    ++num_idle_workers_;
+    worker_cv_.wait(lock, [this]() { return shutdown_ || !queue_.empty(); });
+    --num_idle_workers_;
+    if (queue_.empty()) {
+      return;
+    }
+
+    std::pop_heap(queue_.begin(), queue_.end(), StartsAfter);
+    Request request = std::move(queue_.back().request);
+    queue_.pop_back();
+
+    const RunOptions default_run_options;
+    const RunOptions& user_run_options = request.run_options ? *request.run_options : default_run_options;
+
+    Status status = Status::OK();
+    if (request.deadline && Clock::now() >= *request.deadline) {
+      lock.unlock();
+      status = DeadlineExceeded();
+    } else if (user_run_options.terminate) {
+      lock.unlock();
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "RunAsync request terminated before it started.");
+    } else if (request.deadline) {
+      RunningRequest running{&user_run_options, user_run_options, *request.deadline};
+      running_with_deadline_.push_back(&running);
+      lock.unlock();
+      deadline_cv_.notify_one();
+
+      status = RunRequest(request.run_fn, running.run_options);
+      // otherwise the copy holds the breakdown the caller's options had before this run, which may be stale by now
+      if (running.run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigEnableLatencyBreakdown, "0") ==
+          "1") {
+        user_run_options.latency_breakdown.Set(running.run_options.latency_breakdown.Get());
+      }
+
+      lock.lock();
+      running_with_deadline_.erase(std::find(running_with_deadline_.begin(), running_with_deadline_.end(), &running));
+      lock.unlock();
+    } else {
+      lock.unlock();
+      status = RunRequest(request.run_fn, user_run_options);
+    }
+
+    request.done_fn(std::move(status));
+    lock.lock();
+  }
+}
+
+void RunAsyncScheduler::DeadlineLoop() {
+  std::unique_lock<OrtMutex> lock(mutex_);
+  while (!shutdown_) {
+    const auto now = Clock::now();
+    std::optional<Clock::time_point> next_wake;
+    auto wake_at = [&next_wake](Clock::time_point time) {
+      if (!next_wake || time < *next_wake) {
+        next_wake = time;
+      }
+    };
+
+    // queued requests past their deadline complete without running
+    std::vector<Request> expired;
+    auto is_expired = [&now](const QueuedRequest& queued) {
+      return queued.request.deadline && *queued.request.deadline <= now;
+    };
+    if (std::any_of(queue_.begin(), queue_.end(), is_expired)) {
+      auto first_expired = std::stable_partition(queue_.begin(), queue_.end(),
+                                                 [&is_expired](const QueuedRequest& q) { return !is_expired(q); });
+      for (auto it = first_expired; it != queue_.end(); ++it) {
+        expired.push_back(std::move(it->request));
+      }
+      queue_.erase(first_expired, queue_.end());
+      std::make_heap(queue_.begin(), queue_.end(), StartsAfter);
+    }
+    for (const auto& queued : queue_) {
+      if (queued.request.deadline) {
+        wake_at(*queued.request.deadline);
+      }
+    }
+
+    // running requests are terminated at their deadline, or when the caller terminates its RunOptions
+    for (RunningRequest* running : running_with_deadline_) {
+      if (running->run_options.terminate) {
+        continue;
+      }
+      if (running->deadline <= now || running->user_run_options->terminate) {
+        running->run_options.terminate = true;
+      } else {
+        wake_at(std::min(running->deadline, now + kTerminatePollInterval));
+      }
+    }
+
+    if (!expired.empty()) {
+      lock.unlock();
+      for (auto& request : expired) {
+        request.done_fn(DeadlineExceeded());
+      }
+      lock.lock();
+      continue;
+    }
+
+    if (next_wake) {
+      deadline_cv_.wait_for(lock, *next_wake - now);
+    } else {
+      deadline_cv_.wait(lock);
+    }
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/run_options.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * Executes the RunAsync requests of a session on threads owned by the scheduler, so they don't take workers away
+ * from the intra-op thread pool the kernels parallelize over.
+ *
+ * At most max_in_flight requests run at the same time. The others wait in a queue ordered by priority and then by
+ * submission. A request with a deadline that has not started by then completes with an error without running, and
+ * a running request is terminated through RunOptions::terminate once its deadline has passed.
+ */
+class RunAsyncScheduler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Request {
+    // options of the run. the caller must keep them alive until done_fn is called. may be nullptr.
+    const RunOptions* run_options = nullptr;
+    // requests with a higher priority start first
+    int priority = 0;
+    std::optional<Clock::time_point> deadline;
+    std::function<Status(const RunOptions& run_options)> run_fn;
+    // called exactly once with the status of the request, on a thread owned by the scheduler
+    std::function<void(Status status)> done_fn;
+  };
+
+  // max_queue_size of 0 means the queue is unbounded
+  RunAsyncScheduler(size_t max_in_flight, size_t max_queue_size);
+
+  // completes the queued requests with an error and waits for the running ones
+  ~RunAsyncScheduler();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunAsyncScheduler);
+
+  // queues the request. fails without calling done_fn if the queue is full.
+  Status Submit(Request&& request);
+
+ private:
+  struct QueuedRequest {
+    Request request;
+    uint64_t sequence;
+  };
+
+  // a running request with a deadline. it runs with a copy of the options so that only this request is terminated.
+  struct RunningRequest {
+    const RunOptions* user_run_options;
+    RunOptions run_options;
+    Clock::time_point deadline;
+  };
+
+  // heap comparison: higher priority first, then lower sequence number
+  static bool StartsAfter(const QueuedRequest& a, const QueuedRequest& b);
+
+  void WorkerLoop();
+  void DeadlineLoop();
+
+  const size_t max_in_flight_;
+  const size_t max_queue_size_;
+
+  OrtMutex mutex_;
+  OrtCondVar worker_cv_;
+  OrtCondVar deadline_cv_;
+  bool shutdown_ = false;
+  uint64_t next_sequence_ = 0;
+  size_t num_idle_workers_ = 0;
+  std::vector<QueuedRequest> queue_;  // binary heap ordered by StartsAfter
+  std::vector<RunningRequest*> running_with_deadline_;
+  std::vector<std::thread> workers_;
+  std::thread deadline_thread_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/log_linear_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/perftest/latency_histogram.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+template <typename Histogram>
+void CheckBuckets() {
+  constexpr uint64_t num_sub_buckets = uint64_t{1} << Histogram::kSubBucketBits;
+  const uint64_t max_value = (uint64_t{1} << Histogram::kMaxExponent) - 1;
+
+  // the bucket of a value starts at or below it, the next bucket starts above it, and a bucket is at most
+  // 2^-kSubBucketBits of its values wide
+  for (uint64_t value : {uint64_t{0}, uint64_t{1}, num_sub_buckets - 1, num_sub_buckets, num_sub_buckets + 1,
+                         2 * num_sub_buckets - 1, 2 * num_sub_buckets, 2 * num_sub_buckets + 1, uint64_t{1000},
+                         uint64_t{123456789}, max_value}) {
+    const size_t index = Histogram::BucketIndex(value);
+    ASSERT_LT(index, Histogram::kNumBuckets - 1) << value;
+    const uint64_t lower = Histogram::BucketLowerBound(index);
+    const uint64_t upper = Histogram::BucketLowerBound(index + 1);
+    EXPECT_LE(lower, value);
+    EXPECT_GT(upper, value);
+    EXPECT_LE((upper - lower) * num_sub_buckets, std::max(lower, num_sub_buckets)) << value;
+  }
+
+  // the buckets are contiguous
+  for (size_t index = 0; index + 1 < Histogram::kNumBuckets; ++index) {
+    ASSERT_EQ(Histogram::BucketIndex(Histogram::BucketLowerBound(index)), index);
+    ASSERT_LT(Histogram::BucketLowerBound(index), Histogram::BucketLowerBound(index + 1));
+  }
+
+  EXPECT_EQ(Histogram::BucketIndex(max_value + 1), Histogram::kNumBuckets - 1);
+  EXPECT_EQ(Histogram::BucketIndex(~uint64_t{0}), Histogram::kNumBuckets - 1);
+}
+}  // namespace
+
+TEST(LogLinearHistogramTest, Buckets) {
+  CheckBuckets<LogLinearHistogram<3, 40>>();
+  CheckBuckets<perftest::LatencyHistogram>();
+}
+
+TEST(LogLinearHistogramTest, OpenLoopLatencyPercentiles) {
+  perftest::LatencyHistogram histogram;
+  EXPECT_EQ(histogram.ValueAtPercentile(0.5), 0u);
+  EXPECT_EQ(histogram.Mean(), 0.0);
+
+  // 1ms to 1000ms
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    histogram.Record(i * 1000000);
+  }
+  EXPECT_EQ(histogram.Count(), 1000u);
+  EXPECT_EQ(histogram.Max(), 1000000000u);
+  EXPECT_EQ(histogram.Mean(), 500500000.0);
+
+  // within the 1/1024 width of the buckets
+  for (const double fraction : {0.5, 0.9, 0.99, 0.999}) {
+    const double expected = std::round(fraction * 1000) * 1e6;
+    EXPECT_NEAR(static_cast<double>(histogram.ValueAtPercentile(fraction)), expected, expected / 1024) << fraction;
+  }
+  EXPECT_LE(histogram.ValueAtPercentile(1.0), histogram.Max());
+  EXPECT_GE(histogram.ValueAtPercentile(1.0), histogram.Max() - histogram.Max() / 1024);
+
+  // each rate of a sweep starts from an empty histogram
+  histogram.Reset();
+  EXPECT_EQ(histogram.Count(), 0u);
+  EXPECT_EQ(histogram.Max(), 0u);
+  EXPECT_EQ(histogram.ValueAtPercentile(0.99), 0u);
+
+  // small values have a bucket each, so their percentiles are exact
+  for (uint64_t value : {uint64_t{3}, uint64_t{5}, uint64_t{7}, uint64_t{9}}) {
+    histogram.Record(value);
+  }
+  EXPECT_EQ(histogram.ValueAtPercentile(0.5), 5u);
+  EXPECT_EQ(histogram.ValueAtPercentile(1.0), 9u);
+}
+
+TEST(LogLinearHistogramTest, MergeAndBucketCounts) {
+  using Histogram = LogLinearHistogram<3, 40>;
+  Histogram all;
+  Histogram even;
+  Histogram odd;
+  std::vector<uint64_t> bucket_counts(Histogram::kNumBuckets);
+  uint64_t sum = 0;
+  for (uint64_t i = 0; i < 1000; ++i) {
+    const uint64_t value = i * i * 37;
+    all.Record(value);
+    (i % 2 == 0 ? even : odd).Record(value);
+    ++bucket_counts[Histogram::BucketIndex(value)];
+    sum += value;
+  }
+
+  even.Merge(odd);
+  Histogram from_counts(std::move(bucket_counts), sum, all.Max());
+  for (const Histogram* histogram : {&even, &from_counts}) {
+    EXPECT_EQ(histogram->Count(), all.Count());
+    EXPECT_EQ(histogram->Sum(), all.Sum());
+    EXPECT_EQ(histogram->Max(), all.Max());
+    for (const double fraction : {0.0, 0.25, 0.5, 0.9, 0.99, 1.0}) {
+      EXPECT_EQ(histogram->ValueAtPercentile(fraction), all.ValueAtPercentile(fraction)) << fraction;
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
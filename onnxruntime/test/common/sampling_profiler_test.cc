@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/sampling_profiler.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+using profiling::SamplingProfiler;
+using LatencyHistogram = SamplingProfiler::LatencyHistogram;
+
+TEST(SamplingProfilerTest, HistogramPercentiles) {
+  LatencyHistogram histogram;
+  // 1us to 100us
+  for (uint64_t i = 1; i <= 100; ++i) {
+    histogram.Record(i * 1000);
+  }
+
+  const auto snapshot = histogram.GetSnapshot();
+  EXPECT_EQ(snapshot.Count(), 100u);
+  EXPECT_EQ(snapshot.Max(), 100000u);
+  EXPECT_EQ(snapshot.Sum(), 5050000u);
+
+  // within the 12.5% width of the buckets
+  EXPECT_NEAR(static_cast<double>(snapshot.ValueAtPercentile(0.5)), 50000.0, 50000.0 * 0.125);
+  EXPECT_NEAR(static_cast<double>(snapshot.ValueAtPercentile(0.99)), 99000.0, 99000.0 * 0.125);
+  EXPECT_LE(snapshot.ValueAtPercentile(1.0), snapshot.Max());
+
+  EXPECT_EQ(LatencyHistogram().GetSnapshot().ValueAtPercentile(0.5), 0u);
+}
+
+TEST(SamplingProfilerTest, SnapshotAggregatesPerOpType) {
+  SamplingProfiler profiler(/*ring_buffer_size*/ 4, /*sample_interval*/ 1);
+  auto* conv_0 = profiler.AddNode("conv_0", "Conv");
+  auto* conv_1 = profiler.AddNode("conv_1", "Conv");
+  auto* relu = profiler.AddNode("relu", "Relu");
+  profiler.AddNode("unused", "Add");
+
+  const TimePoint start_time = std::chrono::high_resolution_clock::now();
+  const TimePoint end_time = start_time + std::chrono::microseconds(10);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 100; ++i) {
+        profiler.Record(*conv_0, start_time, end_time);
+        profiler.Record(*conv_1, start_time, end_time);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  profiler.Record(*relu, start_time, end_time);
+
+  const std::string snapshot = profiler.Snapshot();
+  EXPECT_NE(snapshot.find(R"({"name": "conv_0", "op_type": "Conv", "count": 400,)"), std::string::npos) << snapshot;
+  EXPECT_NE(snapshot.find(R"({"op_type": "Conv", "count": 800,)"), std::string::npos) << snapshot;
+  EXPECT_NE(snapshot.find(R"({"op_type": "Relu", "count": 1,)"), std::string::npos) << snapshot;
+  // nodes that never ran are left out
+  EXPECT_EQ(snapshot.find("Add"), std::string::npos) << snapshot;
+
+  // the ring buffer holds the last 4 sampled events, the newest being the Relu
+  size_t num_sampled_events = 0;
+  for (size_t pos = snapshot.find("\"tid\""); pos != std::string::npos; pos = snapshot.find("\"tid\"", pos + 1)) {
+    ++num_sampled_events;
+  }
+  EXPECT_EQ(num_sampled_events, 4u);
+  EXPECT_NE(snapshot.find(R"({"name": "relu", "op_type": "Relu", "tid")"), std::string::npos) << snapshot;
+}
+
+TEST(SamplingProfilerTest, SnapshotEscapesNames) {
+  SamplingProfiler profiler(/*ring_buffer_size*/ 4, /*sample_interval*/ 1);
+  auto* node = profiler.AddNode("say \"hi\"\\\n", "Custom\top");
+
+  const TimePoint start_time = std::chrono::high_resolution_clock::now();
+  profiler.Record(*node, start_time, start_time + std::chrono::microseconds(10));
+
+  const std::string snapshot = profiler.Snapshot();
+  EXPECT_NE(snapshot.find(R"({"name": "say \"hi\"\\\n", "op_type": "Custom\top", "count": 1,)"), std::string::npos)
+      << snapshot;
+  EXPECT_NE(snapshot.find(R"({"op_type": "Custom\top", "count": 1,)"), std::string::npos) << snapshot;
+  EXPECT_NE(snapshot.find(R"({"name": "say \"hi\"\\\n", "op_type": "Custom\top", "tid")"), std::string::npos)
+      << snapshot;
+}
+
+// profilers of sessions run on the same thread count the executions towards their sample interval separately
+TEST(SamplingProfilerTest, SampleIntervalPerProfiler) {
+  SamplingProfiler every_execution(/*ring_buffer_size*/ 1000, /*sample_interval*/ 1);
+  SamplingProfiler every_100th_execution(/*ring_buffer_size*/ 1000, /*sample_interval*/ 100);
+  auto* node = every_execution.AddNode("add", "Add");
+  auto* other_node = every_100th_execution.AddNode("mul", "Mul");
+
+  const TimePoint start_time = std::chrono::high_resolution_clock::now();
+  const TimePoint end_time = start_time + std::chrono::microseconds(10);
+  for (int i = 0; i < 300; ++i) {
+    every_execution.Record(*node, start_time, end_time);
+    every_100th_execution.Record(*other_node, start_time, end_time);
+  }
+
+  auto count_sampled_events = [](const std::string& snapshot) {
+    size_t count = 0;
+    for (size_t pos = snapshot.find("\"tid\""); pos != std::string::npos; pos = snapshot.find("\"tid\"", pos + 1)) {
+      ++count;
+    }
+    return count;
+  };
+  EXPECT_EQ(count_sampled_events(every_execution.Snapshot()), 300u);
+  EXPECT_EQ(count_sampled_events(every_100th_execution.Snapshot()), 3u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/string_lookup_table.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(StringLookupTableTest, EmplaceAndFind) {
+  StringLookupTable<int64_t> table;
+  EXPECT_TRUE(table.empty());
+  EXPECT_EQ(table.Find("a"), nullptr);
+
+  EXPECT_TRUE(table.Emplace("a", 1));
+  EXPECT_TRUE(table.Emplace("", 2));
+  EXPECT_TRUE(table.Emplace("a longer key that does not fit in the small string buffer", 3));
+  // first value wins for Emplace, last value wins for InsertOrAssign
+  EXPECT_FALSE(table.Emplace("a", 4));
+  table.InsertOrAssign("", 5);
+
+  ASSERT_EQ(table.size(), 3u);
+  ASSERT_NE(table.Find("a"), nullptr);
+  EXPECT_EQ(*table.Find("a"), 1);
+  ASSERT_NE(table.Find(""), nullptr);
+  EXPECT_EQ(*table.Find(""), 5);
+  ASSERT_NE(table.Find("a longer key that does not fit in the small string buffer"), nullptr);
+  EXPECT_EQ(*table.Find("a longer key that does not fit in the small string buffer"), 3);
+  EXPECT_EQ(table.Find("b"), nullptr);
+  EXPECT_EQ(table.Find("a "), nullptr);
+}
+
+TEST(StringLookupTableTest, FindAllMatchesUnorderedMap) {
+  // enough entries to force several rehashes and lookups spanning multiple prefetch blocks
+  constexpr int64_t num_keys = 5000;
+  StringLookupTable<int64_t> table;
+  std::unordered_map<std::string, int64_t> expected;
+  for (int64_t i = 0; i < num_keys; ++i) {
+    const std::string key = "key_" + std::to_string(i * 7);
+    table.Emplace(key, i);
+    expected.emplace(key, i);
+  }
+  ASSERT_EQ(table.size(), expected.size());
+
+  std::vector<std::string> input;
+  for (int64_t i = 0; i < num_keys * 2 + 3; ++i) {
+    input.push_back("key_" + std::to_string(i * 3));
+  }
+  std::vector<int64_t> output(input.size());
+  table.FindAll(input.data(), input.size(), output.data(), int64_t{-1});
+
+  for (size_t i = 0; i < input.size(); ++i) {
+    const auto it = expected.find(input[i]);
+    EXPECT_EQ(output[i], it == expected.end() ? -1 : it->second) << input[i];
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -41,5 +41,40 @@ TEST(Utf8UtilTest, Validate) {
   }
 }
 
+TEST(Utf8UtilTest, AsciiPrefixLength) {
+  using namespace utf8_util;
+  // Long enough to cover the vectorized, the 8 byte and the tail loops
+  std::string s(40, 'a');
+  for (size_t pos = 0; pos < s.size(); ++pos) {
+    std::string t = s;
+    t[pos] = '\xc3';
+    EXPECT_EQ(pos, ascii_prefix_length(reinterpret_cast<const unsigned char*>(t.data()), t.size()));
+    EXPECT_FALSE(is_ascii(reinterpret_cast<const unsigned char*>(t.data()), t.size()));
+  }
+  EXPECT_TRUE(is_ascii(reinterpret_cast<const unsigned char*>(s.data()), s.size()));
+}
+
+TEST(Utf8UtilTest, AsciiChangeCase) {
+  using namespace utf8_util;
+  const std::string input = "Hello, World! @[`{ \xc3\x89t\xc3\xa9 0123456789 abcXYZ";
+  std::string lower(input.size(), '\0');
+  std::string upper(input.size(), '\0');
+  ascii_to_lower(input.data(), input.size(), lower.data());
+  ascii_to_upper(input.data(), input.size(), upper.data());
+  EXPECT_EQ("hello, world! @[`{ \xc3\x89t\xc3\xa9 0123456789 abcxyz", lower);
+  EXPECT_EQ("HELLO, WORLD! @[`{ \xc3\x89T\xc3\xa9 0123456789 ABCXYZ", upper);
+}
+
+TEST(Utf8UtilTest, LengthWithAsciiRuns) {
+  using namespace utf8_util;
+  const std::string input = "plain ascii text that spans several words \xe2\x82\xac and more ascii after it";
+  size_t len = 0;
+  ASSERT_TRUE(utf8_validate(reinterpret_cast<const unsigned char*>(input.data()), input.size(), len));
+  EXPECT_EQ(input.size() - 2, len);
+  len = 0;
+  ASSERT_TRUE(utf8_len(reinterpret_cast<const unsigned char*>(input.data()), input.size(), len));
+  EXPECT_EQ(input.size() - 2, len);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
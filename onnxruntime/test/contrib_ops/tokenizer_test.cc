@@ -351,6 +351,50 @@ TEST(ContribOpTest, TokenizerWithSeparators_MixCharsWithMarkersC) {
   }  // namespace test
 }
 
+TEST(ContribOpTest, TokenizerWithSeparators_MixCharsWithMarkersManyRowsC) {
+  // Separators and strings with a mix of latin, Spanish, Cyrillic and Chinese
+  // characters and with start/end text markers. There are enough rows to be
+  // tokenized in several parallel batches, and the output of one thread and
+  // of several threads must be the same.
+  // [C] dimensions
+  // Output [C][D]
+  std::string sepexp = "(у|ñ)";
+
+  const std::vector<std::string> input_block{"Абсу中文", "Коñó", "aуbуc", "plain"};
+  const std::vector<std::vector<std::string>> tokens_block{{"Абс", "中文"}, {"Ко", "ó"}, {"a", "b", "c"}, {"plain"}};
+  constexpr size_t num_blocks = 2000;
+  // The longest row has 3 tokens plus start/end text markers
+  constexpr size_t row_size = 3 + 2;
+
+  std::vector<std::string> input;
+  std::vector<std::string> output;
+  for (size_t i = 0; i < num_blocks; ++i) {
+    for (size_t row = 0; row < input_block.size(); ++row) {
+      input.push_back(input_block[row]);
+      output.push_back(start_mark);
+      output.insert(output.end(), tokens_block[row].begin(), tokens_block[row].end());
+      output.push_back(end_mark);
+      output.resize(output.size() + row_size - tokens_block[row].size() - 2, padval);
+    }
+  }
+
+  for (int thread_pool_size : {1, 4}) {
+    OpTester test("Tokenizer", opset_ver, domain);
+    InitTestAttr(test, true, {sepexp}, 1);
+
+    std::vector<int64_t> dims{static_cast<int64_t>(input.size())};
+    test.AddInput<std::string>("T", dims, input);
+
+    std::vector<int64_t> output_dims(dims);
+    output_dims.push_back(int64_t(row_size));
+    test.AddOutput<std::string>("Y", output_dims, output);
+
+    SessionOptions so;
+    so.intra_op_param.thread_pool_size = thread_pool_size;
+    test.Config(so).RunWithConfig();
+  }
+}
+
 TEST(ContribOpTest, TokenizerWithSeparators_MixCharsWithMarkersCompleteMatchEmptyOutputC) {
   // Test entire separators match so we get nothing
   // in the output
@@ -6,8 +6,11 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <filesystem>
 #include <functional>
+#include <future>
 #include <iterator>
+#include <set>
 #include <thread>
 #include <fstream>
 
@@ -15,8 +18,10 @@
 #include "core/common/denormal.h"
 #include "core/common/logging/logging.h"
 #include "core/common/logging/sinks/clog_sink.h"
+#include "core/common/perf_event_profiler.h"
 #include "core/common/profiler.h"
 #include "core/framework/compute_capability.h"
+#include "core/framework/customregistry.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/kernel_registry.h"
@@ -47,6 +52,8 @@
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/optimized_model_cache.h"
+#include "core/session/run_async_scheduler.h"
 #include "dummy_provider.h"
 #include "test_utils.h"
 #include "test/capturing_sink.h"
@@ -434,6 +441,299 @@ TEST(InferenceSessionTests, DisableCPUArena) {
   RunModel(session_object, run_options);
 }
 
+// initializers with external data that are used on CPU should reference the memory mapped file directly
+TEST(InferenceSessionTests, ExternalInitializerIsNotAllocatedOnCpu) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ExternalInitializerIsNotAllocatedOnCpu";
+
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/model_with_external_initializers.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const SessionState& session_state = session_object.GetSessionState();
+  int ort_value_idx = -1;
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("Pads", ort_value_idx));
+  const auto& initializers = session_state.GetInitializedTensors();
+  auto it = initializers.find(ort_value_idx);
+  ASSERT_NE(it, initializers.end());
+
+  const Tensor& pads = it->second.Get<Tensor>();
+  ASSERT_EQ(pads.Location().alloc_type, OrtDeviceAllocator);
+  auto pads_data = pads.DataAsSpan<int64_t>();
+  ASSERT_EQ(std::vector<int64_t>(pads_data.begin(), pads_data.end()), (std::vector<int64_t>{0, 0, 1, 1}));
+
+  // nothing should have been allocated from the CPU arena for the initializer
+  OrtMemoryInfo mem_info(CPU, OrtArenaAllocator);
+  auto cpu_alloc = session_object.GetAllocator(mem_info);
+  if (cpu_alloc->Info().alloc_type == OrtArenaAllocator) {
+    AllocatorStats alloc_stats;
+    static_cast<BFCArena*>(cpu_alloc.get())->GetStats(&alloc_stats);
+    ASSERT_EQ(alloc_stats.num_allocs, 0);
+    ASSERT_EQ(alloc_stats.num_reserves, 0);
+  }
+}
+
+// memory patterns are cached per exact input shape signature, so transposed shapes don't share an entry
+TEST(InferenceSessionTests, MemoryPatternCacheUsesShapeSignature) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.MemoryPatternCacheUsesShapeSignature";
+
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/abs_free_dimensions.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  auto run = [&session_object](const std::vector<int64_t>& dims) {
+    OrtValue x;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims,
+                         std::vector<float>(static_cast<size_t>(TensorShape(dims).Size()), -1.0f), &x);
+    NameMLValMap feeds{{"x", x}};
+    std::vector<std::string> output_names{"y"};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+    ASSERT_EQ(fetches[0].Get<Tensor>().Shape(), TensorShape(dims));
+  };
+
+  run({2, 3, 5});
+  run({2, 3, 5});
+  run({3, 2, 5});
+
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  session_object.GetSessionState().GetMemoryPatternCacheStats(hits, misses);
+  ASSERT_EQ(hits, 1u);
+  ASSERT_EQ(misses, 2u);
+}
+
+// warm-up runs each set of input shapes twice, creating and then using their memory patterns
+TEST(InferenceSessionTests, WarmUpCreatesMemoryPatterns) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.WarmUpCreatesMemoryPatterns";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigWarmUp, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigWarmUpInputShapes, "x:2x3x5;x:3x2x5"));
+
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/abs_free_dimensions.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  session_object.GetSessionState().GetMemoryPatternCacheStats(hits, misses);
+  ASSERT_EQ(hits, 2u);
+  ASSERT_EQ(misses, 2u);
+
+  // the first request with a warmed up shape uses the cached memory pattern
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 2, 5},
+                       std::vector<float>(30, -1.0f), &x);
+  NameMLValMap feeds{{"x", x}};
+  std::vector<std::string> output_names{"y"};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+  session_object.GetSessionState().GetMemoryPatternCacheStats(hits, misses);
+  ASSERT_EQ(hits, 3u);
+  ASSERT_EQ(misses, 2u);
+
+  // explicit warm-up with the default shapes, and with a shape for an unknown input
+  std::chrono::microseconds duration{-1};
+  ASSERT_STATUS_OK(session_object.WarmUp(RunOptions{}, {}, &duration));
+  ASSERT_GE(duration.count(), 0);
+
+  std::vector<InlinedHashMap<std::string, TensorShape>> input_shapes{{{"z", TensorShape({1})}}};
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(session_object.WarmUp(RunOptions{}, input_shapes),
+                                      "not a required input of the model");
+}
+
+// queued RunAsync requests start by priority, are bounded by the queue size and fail once their deadline passes
+TEST(InferenceSessionTests, RunAsyncScheduler) {
+  RunAsyncScheduler scheduler(/*max_in_flight*/ 1, /*max_queue_size*/ 2);
+
+  OrtMutex mutex;
+  std::vector<std::string> completed;
+  auto make_request = [&](const std::string& name, int priority, std::function<void()> body) {
+    RunAsyncScheduler::Request request;
+    request.priority = priority;
+    request.run_fn = [body](const RunOptions&) {
+      body();
+      return Status::OK();
+    };
+    request.done_fn = [&, name](Status status) {
+      std::lock_guard<OrtMutex> lock(mutex);
+      completed.push_back(status.IsOK() ? name : name + ":failed");
+    };
+    return request;
+  };
+
+  auto wait_for_completed = [&](size_t num_completed) {
+    for (;;) {
+      {
+        std::lock_guard<OrtMutex> lock(mutex);
+        if (completed.size() >= num_completed) {
+          return;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  };
+
+  // occupies the only slot until released so the following requests are queued
+  auto submit_blocker = [&](std::shared_future<void> released) {
+    auto started = std::make_shared<std::promise<void>>();
+    auto started_future = started->get_future();
+    ASSERT_STATUS_OK(scheduler.Submit(make_request("blocker", 0, [started, released]() {
+      started->set_value();
+      released.wait();
+    })));
+    started_future.wait();
+  };
+
+  std::promise<void> release_first_blocker;
+  submit_blocker(release_first_blocker.get_future().share());
+  ASSERT_STATUS_OK(scheduler.Submit(make_request("low", 0, []() {})));
+  ASSERT_STATUS_OK(scheduler.Submit(make_request("high", 1, []() {})));
+  ASSERT_FALSE(scheduler.Submit(make_request("rejected", 0, []() {})).IsOK());
+  release_first_blocker.set_value();
+  wait_for_completed(3);
+
+  std::promise<void> release_second_blocker;
+  submit_blocker(release_second_blocker.get_future().share());
+  bool expired_ran = false;
+  auto expired = make_request("expired", 0, [&expired_ran]() { expired_ran = true; });
+  expired.deadline = RunAsyncScheduler::Clock::now() + std::chrono::milliseconds(1);
+  ASSERT_STATUS_OK(scheduler.Submit(std::move(expired)));
+  wait_for_completed(4);
+  release_second_blocker.set_value();
+  wait_for_completed(5);
+
+  ASSERT_FALSE(expired_ran);
+  ASSERT_EQ(completed, (std::vector<std::string>{"blocker", "high", "low", "expired:failed", "blocker"}));
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+TEST(InferenceSessionTests, OptimizedModelCache) {
+  const std::filesystem::path cache_dir{"optimized_model_cache_test"};
+  std::filesystem::remove_all(cache_dir);
+
+  auto get_entries = [&cache_dir]() {
+    std::vector<std::filesystem::path> entries(std::filesystem::directory_iterator(cache_dir),
+                                               std::filesystem::directory_iterator{});
+    std::sort(entries.begin(), entries.end());
+    return entries;
+  };
+
+  // cache hits are only observable in the log
+  auto capturing_sink = new CapturingSink();
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(capturing_sink), logging::Severity::kINFO, false,
+      LoggingManager::InstanceType::Temporal);
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+
+  auto count_messages = [capturing_sink](const std::string& text) {
+    const auto& msgs = capturing_sink->Messages();
+    return std::count_if(msgs.begin(), msgs.end(),
+                         [&text](const std::string& msg) { return msg.find(text) != std::string::npos; });
+  };
+  constexpr const char* added_message = "Added optimized model cache entry";
+  constexpr const char* loaded_message = "Loaded optimized model from cache entry";
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.OptimizedModelCache";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigOptimizedModelCacheDir,
+                                                    cache_dir.string().c_str()));
+
+  // the first session adds the entry, the second one is created from it
+  for (int i = 0; i < 2; ++i) {
+    InferenceSession session_object{so, *env};
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(get_entries().size(), 1u);
+    ASSERT_EQ(count_messages(added_message), 1);
+    ASSERT_EQ(count_messages(loaded_message), i);
+
+    // the key stored in the entry is not part of the model metadata
+    ASSERT_EQ(session_object.GetModelMetadata().second->custom_metadata_map.count(
+                  optimized_model_cache::kKeyMetadataProperty),
+              0u);
+
+    RunOptions run_options;
+    RunModel(session_object, run_options);
+  }
+  const auto first_entry = get_entries().front();
+
+  // a different optimization level must not use the same entry
+  so.graph_optimization_level = TransformerLevel::Default;
+  {
+    InferenceSession session_object{so, *env};
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(get_entries().size(), 2u);
+    ASSERT_EQ(count_messages(added_message), 2);
+    ASSERT_EQ(count_messages(loaded_message), 1);
+  }
+
+  // an entry created for another key is ignored and replaced
+  const auto entries = get_entries();
+  const auto& second_entry = entries[0] == first_entry ? entries[1] : entries[0];
+  std::filesystem::copy_file(first_entry, second_entry, std::filesystem::copy_options::overwrite_existing);
+  {
+    InferenceSession session_object{so, *env};
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(count_messages("The entry was created for a different key."), 1);
+    ASSERT_EQ(count_messages(added_message), 3);
+    ASSERT_EQ(count_messages(loaded_message), 1);
+  }
+
+  std::filesystem::remove_all(cache_dir);
+}
+
+// sessions of one process that create the same entry at the same time write separate temporary files
+TEST(InferenceSessionTests, OptimizedModelCacheConcurrentWriters) {
+  const std::filesystem::path cache_dir{"optimized_model_cache_concurrent_test"};
+  std::filesystem::remove_all(cache_dir);
+  const PathString entry_path = optimized_model_cache::GetEntryPath(cache_dir.native(), "key");
+
+  constexpr size_t num_writers = 8;
+  constexpr size_t entry_size = 1 << 20;
+  OrtMutex mutex;
+  std::set<PathString> temp_paths;
+  std::vector<Status> statuses(num_writers);
+  std::vector<std::thread> writers;
+  for (size_t i = 0; i < num_writers; ++i) {
+    writers.emplace_back([&, i]() {
+      statuses[i] = optimized_model_cache::WriteEntry(entry_path, [&](const PathString& temp_path) {
+        {
+          std::lock_guard<OrtMutex> lock(mutex);
+          temp_paths.insert(temp_path);
+        }
+        std::ofstream file(temp_path, std::ios::binary);
+        const std::string contents(entry_size, static_cast<char>('a' + i));
+        file.write(contents.data(), contents.size());
+        return file.good() ? Status::OK() : ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the entry.");
+      });
+    });
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+
+  EXPECT_EQ(temp_paths.size(), num_writers);
+  for (const auto& status : statuses) {
+    EXPECT_STATUS_OK(status);
+  }
+
+  // the entry is the complete output of one of the writers, and no temporary file is left behind
+  std::ifstream entry(entry_path, std::ios::binary);
+  const std::string contents((std::istreambuf_iterator<char>(entry)), std::istreambuf_iterator<char>());
+  ASSERT_EQ(contents.size(), entry_size);
+  EXPECT_EQ(std::count(contents.begin(), contents.end(), contents.front()), static_cast<ptrdiff_t>(entry_size));
+  entry.close();
+  EXPECT_EQ(std::distance(std::filesystem::directory_iterator(cache_dir), std::filesystem::directory_iterator{}), 1);
+
+  std::filesystem::remove_all(cache_dir);
+}
+#endif
+
 TEST(InferenceSessionTests, TestModelSerialization) {
   // Load model with level 0 transform level
   // and assert that the model has Identity nodes.
@@ -806,6 +1106,250 @@ TEST(InferenceSessionTests, CheckRunProfilerStartTime) {
   ASSERT_TRUE(before_start_time <= profiling_start_time && profiling_start_time <= after_start_time);
 }
 
+// the sampling profiler keeps running after a snapshot and doesn't need the trace file profiler
+TEST(InferenceSessionTests, SamplingProfilerSnapshot) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.SamplingProfilerSnapshot";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigEnableSamplingProfiler, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSamplingProfilerSampleInterval, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_FALSE(session_object.GetProfiling().IsEnabled());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+
+  std::string snapshot;
+  ASSERT_STATUS_OK(session_object.GetProfilingSnapshot(snapshot));
+  EXPECT_NE(snapshot.find(R"({"name": "mul_1", "op_type": "Mul", "count": 1,)"), std::string::npos) << snapshot;
+  EXPECT_NE(snapshot.find(R"({"op_type": "Mul", "count": 1,)"), std::string::npos) << snapshot;
+  EXPECT_NE(snapshot.find(R"("sampled_events": [)" "\n" R"({"name": "mul_1")"), std::string::npos) << snapshot;
+
+  RunModel(session_object, run_options);
+  ASSERT_STATUS_OK(session_object.GetProfilingSnapshot(snapshot));
+  EXPECT_NE(snapshot.find(R"({"op_type": "Mul", "count": 2,)"), std::string::npos) << snapshot;
+
+  InferenceSession session_without_sampling(SessionOptions{}, GetEnvironment());
+  ASSERT_STATUS_OK(session_without_sampling.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_without_sampling.Initialize());
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(session_without_sampling.GetProfilingSnapshot(snapshot), "not enabled");
+}
+
+TEST(InferenceSessionTests, MemoryProfile) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.MemoryProfile";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigEnableMemoryProfile, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  std::string report;
+  ASSERT_STATUS_OK(session_object.GetMemoryProfile(report));
+  EXPECT_EQ(report, "{\"runs\": 0,\n\"peak_run\": null}\n");
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+
+  // the output of the Mul node is allocated for the caller and outlives the run
+  ASSERT_STATUS_OK(session_object.GetMemoryProfile(report));
+  EXPECT_NE(report.find(R"({"runs": 2,)"), std::string::npos) << report;
+  EXPECT_NE(report.find(R"({"name": "Y", "node": "mul_1", "op_type": "Mul", )"), std::string::npos) << report;
+  EXPECT_NE(report.find(R"("bytes": 24, )"), std::string::npos) << report;
+  EXPECT_NE(report.find(R"("output": true, )"), std::string::npos) << report;
+  EXPECT_NE(report.find(R"("free_us": -1, "freed_by": ""})"), std::string::npos) << report;
+  EXPECT_NE(report.find(R"("event": "alloc", "tensor": 0, "live_bytes": 24, )"), std::string::npos) << report;
+  EXPECT_NE(report.find(R"("tensors": [{"tensor": 0, "name": "Y", "bytes": 24, "fraction": 1}])"), std::string::npos)
+      << report;
+
+  InferenceSession session_without_memory_profile(SessionOptions{}, GetEnvironment());
+  ASSERT_STATUS_OK(session_without_memory_profile.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_without_memory_profile.Initialize());
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(session_without_memory_profile.GetMemoryProfile(report), "not enabled");
+}
+
+TEST(InferenceSessionTests, MemoryProfileEscapesNames) {
+  onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(6);
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y \"out\"\t", &float_tensor);
+  graph.AddNode("abs \"1\"\n", "Abs", "node 1.", {&input_arg}, {&output_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.MemoryProfileEscapesNames";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigEnableMemoryProfile, "1"));
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  OrtValue ml_value_x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {6},
+                       {-1.0f, 2.0f, -3.0f, 4.0f, -5.0f, 6.0f}, &ml_value_x);
+  NameMLValMap feeds{{"X", ml_value_x}};
+  std::vector<std::string> output_names{"Y \"out\"\t"};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+
+  std::string report;
+  ASSERT_STATUS_OK(session_object.GetMemoryProfile(report));
+  EXPECT_NE(report.find(R"({"name": "Y \"out\"\t", "node": "abs \"1\"\n", "op_type": "Abs", )"), std::string::npos)
+      << report;
+  EXPECT_NE(report.find(R"("tensors": [{"tensor": 0, "name": "Y \"out\"\t", "bytes": 24, )"), std::string::npos)
+      << report;
+}
+
+TEST(InferenceSessionTests, RunLatencyBreakdown) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.RunLatencyBreakdown";
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  EXPECT_TRUE(run_options.latency_breakdown.Get().empty());
+
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigEnableLatencyBreakdown, "1"));
+  RunModel(session_object, run_options);
+  const std::string breakdown = run_options.latency_breakdown.Get();
+  EXPECT_EQ(breakdown.find(R"({"total_ns": )"), 0u) << breakdown;
+  EXPECT_NE(breakdown.find(R"(, "input_validation_ns": )"), std::string::npos) << breakdown;
+  EXPECT_NE(breakdown.find(R"(, "allocation_and_planning_ns": )"), std::string::npos) << breakdown;
+  // the feeds and fetches of a CPU only session are not copied
+  EXPECT_NE(breakdown.find(R"(, "data_transfer_ns": 0, "output_copy_ns": 0, )"), std::string::npos) << breakdown;
+  EXPECT_NE(breakdown.find(R"("partitions": [{"provider": "CPUExecutionProvider", "kernels": 1, )"),
+            std::string::npos)
+      << breakdown;
+}
+
+// concurrent runs sharing the run options each set the breakdown while it is read
+TEST(InferenceSessionTests, RunLatencyBreakdownSharedRunOptions) {
+  InferenceSession session_object(SessionOptions{}, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigEnableLatencyBreakdown, "1"));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 10; ++i) {
+        RunModel(session_object, run_options);
+        const std::string breakdown = run_options.latency_breakdown.Get();
+        EXPECT_EQ(breakdown.find(R"({"total_ns": )"), 0u) << breakdown;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Mul kernel that computes its output with a run of another session
+class NestedRunMulKernel : public OpKernel {
+ public:
+  NestedRunMulKernel(const OpKernelInfo& info, InferenceSession& inner_session)
+      : OpKernel(info), inner_session_(inner_session) {}
+
+  Status Compute(OpKernelContext* context) const override {
+    NameMLValMap feeds{{"X", *context->GetInputOrtValue(0)}};
+    std::vector<std::string> output_names{"Y"};
+    std::vector<OrtValue> fetches;
+    ORT_RETURN_IF_ERROR(inner_session_.Run(RunOptions{}, feeds, output_names, &fetches));
+    const auto& inner_y = fetches[0].Get<Tensor>();
+    auto* y = context->Output(0, inner_y.Shape());
+    std::copy_n(inner_y.Data<float>(), inner_y.Shape().Size(), y->MutableData<float>());
+    return Status::OK();
+  }
+
+ private:
+  InferenceSession& inner_session_;
+};
+
+// a run of another session started from within a kernel on the same thread doesn't add to the breakdown
+TEST(InferenceSessionTests, RunLatencyBreakdownExcludesNestedRuns) {
+  InferenceSession inner_session(SessionOptions{}, GetEnvironment());
+  ASSERT_STATUS_OK(inner_session.Load(MODEL_URI));
+  ASSERT_STATUS_OK(inner_session.Initialize());
+
+  KernelDefBuilder def;
+  def.SetName("Mul")
+      .SetDomain(kOnnxDomain)
+      .SinceVersion(7)
+      .Provider(kCpuExecutionProvider)
+      .TypeConstraint("T", DataTypeImpl::GetTensorType<float>());
+  auto registry = std::make_shared<CustomRegistry>();
+  ASSERT_STATUS_OK(registry->RegisterCustomKernel(
+      def, [&inner_session](FuncManager&, const OpKernelInfo& info, std::unique_ptr<OpKernel>& out) -> Status {
+        out = std::make_unique<NestedRunMulKernel>(info, inner_session);
+        return Status::OK();
+      }));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.RunLatencyBreakdownExcludesNestedRuns";
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.RegisterCustomRegistry(registry));
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigEnableLatencyBreakdown, "1"));
+  RunModel(session_object, run_options);
+
+  // the kernel of the outer session only, not the Mul of the inner session
+  const std::string breakdown = run_options.latency_breakdown.Get();
+  EXPECT_NE(breakdown.find(R"("partitions": [{"provider": "CPUExecutionProvider", "kernels": 1, )"),
+            std::string::npos)
+      << breakdown;
+}
+
+#if defined(__linux__)
+TEST(InferenceSessionTests, ProfileHardwareCounters) {
+  if (!profiling::PerfEventProfiler().StartProfiling(std::chrono::high_resolution_clock::now())) {
+    GTEST_SKIP() << "perf_event is not available";
+  }
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ProfileHardwareCounters";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_hardware_counters_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfileHardwareCounters, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  bool has_counters = false;
+  std::string line;
+  while (std::getline(profile, line)) {
+    if (line.find("\"mul_1_kernel_time\"") != std::string::npos) {
+      EXPECT_NE(line.find("\"hw_cycles\""), std::string::npos) << line;
+      EXPECT_NE(line.find("\"hw_ipc\""), std::string::npos) << line;
+      EXPECT_NE(line.find("\"hw_thread_cycles\" : {"), std::string::npos) << line;
+      has_counters = true;
+    }
+  }
+  EXPECT_TRUE(has_counters);
+}
+#endif
+
 TEST(InferenceSessionTests, MultipleSessionsNoTimeout) {
   SessionOptions session_options;
 
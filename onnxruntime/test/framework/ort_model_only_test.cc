@@ -5,6 +5,7 @@
 #include "core/framework/data_types.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/TensorSeq.h"
+#include "core/graph/graph_flatbuffers_utils.h"
 #include "core/graph/model.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/onnxruntime_cxx_api.h"
@@ -49,10 +50,10 @@ static void RunOrtModel(const OrtModelTestInfo& test_info) {
 
   if (test_info.disable_copy_ort_buffer) {
     ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseORTModelBytesDirectly, "1"));
+  }
 
-    if (test_info.use_buffer_for_initializers) {
-      ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "1"));
-    }
+  if (test_info.use_buffer_for_initializers) {
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "1"));
   }
 
   so.graph_optimization_level = test_info.optimization_level;
@@ -295,6 +296,48 @@ TEST(OrtModelOnlyTests, ValidateOrtFormatModelDoesNotRunOptimizersInFullBuild) {
   RunOrtModel(test_info);
 }
 
+// Load an ORT format model from a file path with the initializers using the bytes of the mapped file
+TEST(OrtModelOnlyTests, LoadOrtFormatModelInitializersUseMappedFile) {
+  const auto ort_file = ORT_TSTR("testdata/mnist.onnx.mapped_test_output.ort");
+  SaveAndCompareModels(ORT_TSTR("testdata/mnist.onnx"), ort_file);
+
+  SessionOptions so;
+  so.session_logid = "LoadOrtFormatModelInitializersUseMappedFile";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "1"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ort_file));
+
+  // the data of the large initializers is used in place, with the alignment it was written with
+  size_t num_in_place = 0;
+  for (const auto& [name, initializer] : session_object.GetGraph().GetAllInitializedTensors()) {
+    if (!utils::HasExternalData(*initializer)) {
+      continue;
+    }
+
+    void* data = nullptr;
+    SafeInt<size_t> data_length = 0;
+    OrtCallback deleter;
+    ASSERT_STATUS_OK(utils::GetExtDataFromTensorProto(Env::Default(), nullptr, *initializer, data, data_length,
+                                                      deleter));
+    EXPECT_EQ(deleter.f, nullptr) << name << " does not refer to the model bytes";
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % fbs::utils::kInitializerDataAlignment, 0u) << name;
+    ++num_in_place;
+  }
+  EXPECT_GT(num_in_place, 0u);
+
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  OrtValue ml_value;
+  std::vector<float> data(28 * 28, 0.0);
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1, 1, 28, 28}, data,
+                       &ml_value);
+  NameMLValMap feeds{{"Input3", ml_value}};
+  std::vector<std::string> output_names{"Plus214_Output_0"};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(feeds, output_names, &fetches));
+  ASSERT_EQ(fetches[0].Get<Tensor>().Shape().NumDimensions(), 2u);
+}
+
 TEST(OrtModelOnlyTests, SerializeToOrtFormat) {
   const auto ort_file = ORT_TSTR("testdata/ort_github_issue_4031.onnx.test_output.ort");
   SaveAndCompareModels(ORT_TSTR("testdata/ort_github_issue_4031.onnx"), ort_file);
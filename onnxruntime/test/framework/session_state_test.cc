@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <iostream>
+#include <thread>
 #include <absl/base/config.h>
 
 #include "asserts.h"
@@ -526,6 +527,7 @@ static void PlaceAllNodesToCPUEP(Graph& graph) {
 struct PrepackingTestParam {
   bool test_subgraph;
   bool test_prepacking;
+  bool test_parallel_initialization = false;
 };
 
 class SessionStatePrepackingTest : public testing::TestWithParam<PrepackingTestParam> {};
@@ -567,6 +569,8 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   sess_options.enable_mem_reuse = true;
   sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] =
       test_param.test_prepacking ? "0" : "1";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigParallelInitialization] =
+      test_param.test_parallel_initialization ? "1" : "0";
 
   SessionState session_state(model.MainGraph(),
                              execution_providers,
@@ -597,6 +601,169 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   const auto& const_initialized_tensors = session_state.GetConstantInitializedTensors();
   // check prepacking
   ASSERT_EQ(const_initialized_tensors.size(), size_t(test_param.test_prepacking ? 0 : 1));
+  ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(),
+            size_t(test_param.test_prepacking && !test_param.test_subgraph ? 1 : 0));
+}
+
+// Records the threads it is created and pre-packed on.
+class ThreadRecordingOpKernel : public OpKernel {
+ public:
+  ThreadRecordingOpKernel(const OpKernelInfo& info) : OpKernel(info), created_on(std::this_thread::get_id()) {}
+
+  Status Compute(OpKernelContext* context) const override {
+    ORT_UNUSED_PARAMETER(context);
+    return Status::OK();
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override {
+    ORT_UNUSED_PARAMETER(tensor);
+    ORT_UNUSED_PARAMETER(input_idx);
+    ORT_UNUSED_PARAMETER(alloc);
+    ORT_UNUSED_PARAMETER(prepacked_weights);
+    prepacked_on = std::this_thread::get_id();
+    is_packed = false;
+    return Status::OK();
+  }
+
+  std::thread::id created_on;
+  std::thread::id prepacked_on;
+};
+
+// Many CPU MatMul kernels with constant weights are created and pre-packed concurrently, while the kernel of a custom
+// registry stays on the calling thread. The result must be the same as with sequential initialization.
+TEST(SessionStateTest, ParallelInitializationOfCpuKernels) {
+  ONNX_OPERATOR_SCHEMA(ThreadRecordingTest)
+      .SetDoc("Faking Node recording the initialization threads")
+      .Input(0, "Input_0", "input 0", "tensor(float)")
+      .Input(1, "Input_1", "input 1", "tensor(float)")
+      .Output(0, "output_0", "docstr for output_0.", "tensor(float)");
+
+  constexpr int num_matmuls = 16;
+  constexpr int64_t dim = 16;
+
+  struct InitializationResult {
+    size_t num_prepacks;
+    size_t num_constant_initializers;
+  };
+
+  auto initialize = [&](bool parallel_initialization, InitializationResult& result) {
+    OrtThreadPoolParams to;
+    to.thread_pool_size = 4;
+    auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
+
+    ExecutionProviders execution_providers;
+    auto cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+    ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider, std::move(cpu_execution_provider)));
+
+    DataTransferManager dtm;
+    profiling::Profiler profiler;
+
+    std::unordered_map<std::string, int> domain_to_version;
+    domain_to_version[kOnnxDomain] = 13;
+    Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+    Graph& graph = model.MainGraph();
+
+    TypeProto x_type;
+    x_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+    x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    TypeProto w_type;
+    w_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    w_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    w_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+
+    auto& x_arg = graph.GetOrCreateNodeArg("X", &x_type);
+    std::vector<float> weights(static_cast<size_t>(dim * dim), 0.5f);
+    for (int i = 0; i < num_matmuls; ++i) {
+      const std::string suffix = std::to_string(i);
+      auto& w_arg = graph.GetOrCreateNodeArg("W_" + suffix, &w_type);
+      auto& y_arg = graph.GetOrCreateNodeArg("Y_" + suffix, &x_type);
+      graph.AddNode("matmul_" + suffix, "MatMul", "matmul " + suffix, {&x_arg, &w_arg}, {&y_arg});
+
+      ONNX_NAMESPACE::TensorProto tensor;
+      tensor.add_dims(dim);
+      tensor.add_dims(dim);
+      tensor.set_data_type(TensorProto_DataType_FLOAT);
+      tensor.set_name("W_" + suffix);
+      tensor.set_raw_data(weights.data(), weights.size() * sizeof(float));
+      graph.AddInitializedTensor(tensor);
+    }
+
+    TypeProto custom_type;
+    custom_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    custom_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+    auto& custom_input_arg = graph.GetOrCreateNodeArg("custom_input", &custom_type);
+    auto& custom_weight_arg = graph.GetOrCreateNodeArg("custom_weight", &custom_type);
+    auto& custom_output_arg = graph.GetOrCreateNodeArg("custom_output", &custom_type);
+    const Node& custom_node = graph.AddNode("custom", "ThreadRecordingTest", "custom",
+                                            {&custom_input_arg, &custom_weight_arg}, {&custom_output_arg});
+    ONNX_NAMESPACE::TensorProto tensor;
+    tensor.add_dims(1);
+    tensor.add_float_data(1.0f);
+    tensor.set_data_type(TensorProto_DataType_FLOAT);
+    tensor.set_name("custom_weight");
+    graph.AddInitializedTensor(tensor);
+
+    ASSERT_STATUS_OK(graph.Resolve());
+    PlaceAllNodesToCPUEP(graph);
+
+    SessionOptions sess_options;
+    sess_options.enable_mem_pattern = true;
+    sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+    sess_options.use_deterministic_compute = false;
+    sess_options.enable_mem_reuse = true;
+    sess_options.config_options.configurations[kOrtSessionOptionsConfigParallelInitialization] =
+        parallel_initialization ? "1" : "0";
+
+    SessionState session_state(graph,
+                               execution_providers,
+                               tp.get(),
+                               nullptr, /*inter_op_thread_pool*/
+                               dtm,
+                               DefaultLoggingManager().DefaultLogger(),
+                               profiler,
+                               sess_options);
+
+    KernelRegistryManager kernel_registry_manager;
+    ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+    std::shared_ptr<KernelRegistry> kernel_registry = std::make_shared<KernelRegistry>();
+    auto kernel_def =
+        KernelDefBuilder().SetName("ThreadRecordingTest").Provider(kCpuExecutionProvider).SinceVersion(1).Build();
+    ASSERT_STATUS_OK(kernel_registry->Register(
+        KernelCreateInfo(std::move(kernel_def),
+                         [](FuncManager&, const OpKernelInfo& info, std::unique_ptr<OpKernel>& out) -> Status {
+                           out = std::make_unique<ThreadRecordingOpKernel>(info);
+                           return Status::OK();
+                         })));
+    kernel_registry_manager.RegisterKernelRegistry(kernel_registry);
+
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager));
+
+    for (const auto& node : graph.Nodes()) {
+      ASSERT_NE(session_state.GetKernel(node.Index()), nullptr) << node.Name();
+    }
+
+    const auto* custom_kernel = static_cast<const ThreadRecordingOpKernel*>(session_state.GetKernel(custom_node.Index()));
+    EXPECT_EQ(custom_kernel->created_on, std::this_thread::get_id());
+    EXPECT_EQ(custom_kernel->prepacked_on, std::this_thread::get_id());
+
+    result.num_prepacks = session_state.GetNumberOfPrepacksCounter();
+    result.num_constant_initializers = session_state.GetConstantInitializedTensors().size();
+  };
+
+  InitializationResult sequential{};
+  ASSERT_NO_FATAL_FAILURE(initialize(false, sequential));
+  InitializationResult parallel{};
+  ASSERT_NO_FATAL_FAILURE(initialize(true, parallel));
+
+  EXPECT_EQ(parallel.num_prepacks, sequential.num_prepacks);
+  EXPECT_EQ(parallel.num_constant_initializers, sequential.num_constant_initializers);
+  // every MatMul weight is pre-packed and released when MLAS packs B on this platform
+  EXPECT_EQ(parallel.num_constant_initializers + parallel.num_prepacks, size_t(num_matmuls + 1));
 }
 
 class SessionStateTestSharedInitalizersWithPrePacking : public ::testing::Test {
@@ -983,12 +1150,102 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test4) {
   ASSERT_EQ(if_node_branches_shared_prepack_counter_2, static_cast<size_t>(2));
 }
 
+// Pre-packing enabled + pre-packed weights container + sharing initializers across sessions =
+// identical initializers are stored once in the container and their pre-packed weights are cached
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test5) {
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  // Enable pre-packing
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  // Enable sharing initializers across the sessions using the same container
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigShareInitializersAcrossSessions] = "1";
+
+  PrepackedWeightsContainer prepacked_weights_container;
+
+  // graph with a single node consuming an initializer large enough to be shared
+  auto create_graph = [](Graph& graph, float initializer_value) {
+    constexpr int64_t num_elements = 256;
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(num_elements);
+
+    auto& input_0_arg = graph.GetOrCreateNodeArg("node_0_input_0", &type);
+    auto& input_1_arg = graph.GetOrCreateNodeArg("node_0_input_1", &type);
+    auto& output_arg = graph.GetOrCreateNodeArg("node_0_output_0", &type);
+    graph.AddNode("node_0", "PrePackingTest", "node 0", {&input_0_arg, &input_1_arg}, {&output_arg});
+
+    std::vector<float> data(num_elements, initializer_value);
+    ONNX_NAMESPACE::TensorProto tensor;
+    tensor.add_dims(num_elements);
+    tensor.set_data_type(TensorProto_DataType_FLOAT);
+    tensor.set_raw_data(data.data(), data.size() * sizeof(float));
+    tensor.set_name("node_0_input_1");
+    graph.AddInitializedTensor(tensor);
+
+    ASSERT_STATUS_OK(graph.Resolve());
+  };
+
+  auto create_session_state = [&](Model& model, float initializer_value) {
+    create_graph(model.MainGraph(), initializer_value);
+    PlaceAllNodesToCPUEP(model.MainGraph());
+    return std::make_unique<SessionState>(model.MainGraph(),
+                                          execution_providers,
+                                          tp.get(),
+                                          nullptr, /*inter_op_thread_pool*/
+                                          dtm,
+                                          DefaultLoggingManager().DefaultLogger(),
+                                          profiler,
+                                          sess_options,
+                                          &prepacked_weights_container);
+  };
+
+  // First session/model
+  Model model_1("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+  auto session_state_1 = create_session_state(model_1, 1.f);
+  ASSERT_STATUS_OK(session_state_1->FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                         kernel_registry_manager));
+
+  // The initializer was added to the container and its pre-packed weight was cached
+  ASSERT_EQ(prepacked_weights_container.GetNumberOfSharedInitializers(), static_cast<size_t>(1));
+  ASSERT_EQ(session_state_1->GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+  ASSERT_EQ(session_state_1->GetUsedSharedPrePackedWeightCounter(), static_cast<size_t>(0));
+
+  // Second session/model with an identical initializer
+  Model model_2("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+  auto session_state_2 = create_session_state(model_2, 1.f);
+  ASSERT_STATUS_OK(session_state_2->FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                         kernel_registry_manager));
+
+  // The initializer in the container was used, including its cached pre-packed weight
+  ASSERT_EQ(prepacked_weights_container.GetNumberOfSharedInitializers(), static_cast<size_t>(1));
+  ASSERT_EQ(session_state_2->GetUsedSharedPrePackedWeightCounter(), static_cast<size_t>(1));
+
+  // Third session/model with an initializer of the same shape but different data
+  Model model_3("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+  auto session_state_3 = create_session_state(model_3, 2.f);
+  ASSERT_STATUS_OK(session_state_3->FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                         kernel_registry_manager));
+
+  ASSERT_EQ(prepacked_weights_container.GetNumberOfSharedInitializers(), static_cast<size_t>(2));
+}
+
 INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          SessionStatePrepackingTest,
                          testing::Values(PrepackingTestParam{false, false},
                                          PrepackingTestParam{false, true},
                                          PrepackingTestParam{true, false},
-                                         PrepackingTestParam{true, true}));
+                                         PrepackingTestParam{true, true},
+                                         PrepackingTestParam{false, true, true},
+                                         PrepackingTestParam{true, true, true}));
 #endif
 
 }  // namespace test
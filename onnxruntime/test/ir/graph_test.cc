@@ -1507,6 +1507,65 @@ TEST_F(GraphTest, ShapeInferenceErrorHandling) {
                                       "Node (node_1) Op (ShapeInferenceThrowsOp) [ShapeInferenceError] try harder");
 }
 
+// Resolve only re-runs type and shape inference for nodes that changed or whose inputs changed since the last
+// Resolve. Check the changes still reach every node they affect.
+TEST_F(GraphTest, ResolveInfersOnlyChangedNodes) {
+  Model model("graph", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  auto get_dims = [](const NodeArg& arg) {
+    std::vector<int64_t> dims;
+    if (arg.Shape() != nullptr) {
+      for (const auto& dim : arg.Shape()->dim()) {
+        dims.push_back(dim.has_dim_value() ? dim.dim_value() : -1);
+      }
+    }
+    return dims;
+  };
+
+  // input without a shape -> Relu -> Relu -> Transpose
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  auto& input = graph.GetOrCreateNodeArg("input", &tensor_float);
+  auto& relu_1_out = graph.GetOrCreateNodeArg("relu_1_out", nullptr);
+  auto& relu_2_out = graph.GetOrCreateNodeArg("relu_2_out", nullptr);
+  auto& transpose_out = graph.GetOrCreateNodeArg("transpose_out", nullptr);
+  graph.AddNode("relu_1", "Relu", "", {&input}, {&relu_1_out});
+  graph.AddNode("relu_2", "Relu", "", {&relu_1_out}, {&relu_2_out});
+  auto& transpose = graph.AddNode("transpose", "Transpose", "", {&relu_2_out}, {&transpose_out});
+  transpose.AddAttribute("perm", std::vector<int64_t>{0, 1});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(transpose_out.Shape(), nullptr);
+
+  // a new input shape flows through the unchanged nodes
+  TensorShapeProto input_shape;
+  input_shape.add_dim()->set_dim_value(2);
+  input_shape.add_dim()->set_dim_value(3);
+  input.SetShape(input_shape);
+  graph.SetGraphResolveNeeded();
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(get_dims(relu_1_out), (std::vector<int64_t>{2, 3}));
+  EXPECT_EQ(get_dims(relu_2_out), (std::vector<int64_t>{2, 3}));
+  EXPECT_EQ(get_dims(transpose_out), (std::vector<int64_t>{2, 3}));
+
+  // a changed attribute is picked up
+  transpose.AddAttribute("perm", std::vector<int64_t>{1, 0});
+  transpose_out.ClearShape();
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(get_dims(transpose_out), (std::vector<int64_t>{3, 2}));
+
+  // as is a new node
+  auto& relu_3_out = graph.GetOrCreateNodeArg("relu_3_out", nullptr);
+  graph.AddNode("relu_3", "Relu", "", {&transpose_out}, {&relu_3_out});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(get_dims(relu_3_out), (std::vector<int64_t>{3, 2}));
+}
+
 TEST_F(GraphTest, AddTensorAttribute) {
   OPERATOR_SCHEMA(__Constant)
       .SetDoc("Constant Op.")
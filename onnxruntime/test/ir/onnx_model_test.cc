@@ -2,7 +2,10 @@
 // Licensed under the MIT License.
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <cstdio>
+#include <fstream>
 #include <memory>
+#include "core/framework/tensorprotoutils.h"
 #include "core/platform/env.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
@@ -189,6 +192,123 @@ TEST_F(ONNXModelsTest, TestModelsWithAnOpContainingAFunctionBody) {
   ASSERT_STATUS_OK(model->MainGraph().Resolve());
 }
 
+// initializers with raw data of at least ModelOptions::in_place_initializer_min_size bytes should refer to their
+// data in the model file instead of holding a copy of it.
+TEST_F(ONNXModelsTest, LoadWithInPlaceInitializers) {
+  const char* code = R"ONNX(
+<
+  ir_version: 8,
+  opset_import: [ "" : 13 ]
+>
+agraph (float[4] x) => (float[4] y)
+{
+    t = Add(x, large)
+    y = Mul(t, small)
+}
+)ONNX";
+
+  ModelProto model_proto;
+  ONNX_NAMESPACE::OnnxParser parser(code);
+  ASSERT_TRUE(parser.Parse(model_proto).IsOK());
+
+  const std::vector<float> large_data{1.f, 2.f, 3.f, 4.f};
+  const std::vector<float> small_data{5.f};
+  auto add_initializer = [&model_proto](const std::string& name, const std::vector<float>& data) {
+    auto* initializer = model_proto.mutable_graph()->add_initializer();
+    initializer->set_name(name);
+    initializer->set_data_type(TensorProto_DataType_FLOAT);
+    initializer->add_dims(static_cast<int64_t>(data.size()));
+    initializer->set_raw_data(data.data(), data.size() * sizeof(float));
+  };
+  add_initializer("large", large_data);
+  add_initializer("small", small_data);
+
+  const PathString model_path = ORT_TSTR("load_with_in_place_initializers.onnx");
+  {
+    std::ofstream model_file(model_path, std::ios::binary);
+    ASSERT_TRUE(model_proto.SerializeToOstream(&model_file));
+  }
+
+  ModelOptions options;
+  options.in_place_initializer_min_size = 2 * sizeof(float);
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_path, model, nullptr, *logger_, options));
+  const Graph& graph = model->MainGraph();
+
+  const TensorProto* large = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("large", large));
+  ASSERT_TRUE(utils::HasExternalData(*large));
+  ASSERT_FALSE(utils::HasRawData(*large));
+  std::vector<uint8_t> unpacked;
+  ASSERT_STATUS_OK(utils::UnpackInitializerData(*large, model->ModelPath(), unpacked));
+  ASSERT_EQ(unpacked.size(), large_data.size() * sizeof(float));
+  EXPECT_EQ(memcmp(unpacked.data(), large_data.data(), unpacked.size()), 0);
+
+  const TensorProto* small = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("small", small));
+  ASSERT_FALSE(utils::HasExternalData(*small));
+  EXPECT_EQ(small->raw_data().size(), sizeof(float));
+
+  model.reset();
+  std::remove(ToUTF8String(model_path).c_str());
+}
+
+// initializer data is only used in place if its offset in the model file is aligned for its element type,
+// otherwise it is kept in the initializer.
+TEST_F(ONNXModelsTest, LoadWithInPlaceInitializersAlignment) {
+  const char* code = R"ONNX(
+<
+  ir_version: 8,
+  opset_import: [ "" : 13 ]
+>
+agraph (float[4] x) => (float[4] y)
+{
+    y = Add(x, large)
+}
+)ONNX";
+
+  ModelProto model_proto;
+  ONNX_NAMESPACE::OnnxParser parser(code);
+  ASSERT_TRUE(parser.Parse(model_proto).IsOK());
+
+  const std::vector<float> large_data{1.5f, 2.5f, 3.5f, 4.5f};
+  const std::string raw_data(reinterpret_cast<const char*>(large_data.data()), large_data.size() * sizeof(float));
+  auto* initializer = model_proto.mutable_graph()->add_initializer();
+  initializer->set_name("large");
+  initializer->set_data_type(TensorProto_DataType_FLOAT);
+  initializer->add_dims(static_cast<int64_t>(large_data.size()));
+  initializer->set_raw_data(raw_data);
+
+  const PathString model_path = ORT_TSTR("load_with_in_place_initializers_alignment.onnx");
+  // the doc string precedes the graph, so its length moves the offset of the raw data in the file
+  for (size_t padding = 0; padding < sizeof(float); ++padding) {
+    model_proto.set_doc_string(std::string(padding, 'x'));
+    const std::string serialized = model_proto.SerializeAsString();
+    const size_t offset = serialized.find(raw_data);
+    ASSERT_NE(offset, std::string::npos);
+    {
+      std::ofstream model_file(model_path, std::ios::binary);
+      model_file.write(serialized.data(), static_cast<std::streamsize>(serialized.size()));
+      ASSERT_TRUE(model_file.good());
+    }
+
+    ModelOptions options;
+    options.in_place_initializer_min_size = 2 * sizeof(float);
+    std::shared_ptr<Model> model;
+    ASSERT_STATUS_OK(Model::Load(model_path, model, nullptr, *logger_, options));
+
+    const TensorProto* large = nullptr;
+    ASSERT_TRUE(model->MainGraph().GetInitializedTensor("large", large));
+    EXPECT_EQ(utils::HasExternalData(*large), offset % sizeof(float) == 0) << "offset " << offset;
+    std::vector<uint8_t> unpacked;
+    ASSERT_STATUS_OK(utils::UnpackInitializerData(*large, model->ModelPath(), unpacked));
+    ASSERT_EQ(unpacked.size(), raw_data.size());
+    EXPECT_EQ(memcmp(unpacked.data(), raw_data.data(), unpacked.size()), 0);
+  }
+
+  std::remove(ToUTF8String(model_path).c_str());
+}
+
 // The following tests verify ORT can successfully load models which reference functions
 // present in the ModelProto aka model local functions. This feature was added to ONNX standard starting IRv8
 
@@ -24,6 +24,9 @@
 const OrtApi* g_ort = OrtGetApiBase()->GetApi(ORT_API_VERSION);
 OrtEnv* env = nullptr;
 
+// defined in model_kernels.cc
+void RegisterModelKernelBenchmarks();
+
 using namespace onnxruntime;
 
 static void BM_CPUAllocator(benchmark::State& state) {
@@ -79,6 +82,7 @@ int main(int argc, char** argv) {
   if (::benchmark::ReportUnrecognizedArguments(argc, argv))
     return -1;
   ORT_ABORT_ON_ERROR(g_ort->CreateEnv(ORT_LOGGING_LEVEL_ERROR, "test", &env));
+  RegisterModelKernelBenchmarks();
   ::benchmark::RunSpecifiedBenchmarks();
   g_ort->ReleaseEnv(env);
   return 0;
@@ -0,0 +1,536 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Benchmarks of the kernels of a model in isolation, with the shapes they see in the model. The model is loaded and
+// its shapes inferred, every distinct (op, input types and shapes, attributes) of its nodes becomes a benchmark, and
+// the kernel is run through the standalone op invoker (OrtApi::CreateOp and OrtApi::InvokeOp) across intra-op thread
+// counts. Unlike the MLAS benchmarks and their synthetic shape grids, this evaluates MLAS and kernel changes on the
+// shapes of the models that are deployed.
+//
+// The benchmarks are registered only if a model is given. As the command line belongs to Google Benchmark, it is set
+// with environment variables:
+//   ORT_BENCHMARK_KERNEL_MODEL    path of the model
+//   ORT_BENCHMARK_KERNEL_DIMS     values of the symbolic dimensions of the model inputs, e.g. "batch=8,sequence=128".
+//                                 Symbolic dimensions that are not listed are 1.
+//   ORT_BENCHMARK_KERNEL_THREADS  intra-op thread counts, e.g. "1,4". Default: 1
+//
+// Compare two builds by running
+//   ORT_BENCHMARK_KERNEL_MODEL=model.onnx onnxruntime_benchmark --benchmark_filter=BM_ModelKernel
+//       --benchmark_repetitions=10 --benchmark_out=results.json --benchmark_out_format=json
+// with each of them, and the results with tools/python/compare_benchmark_results.py.
+//
+// The kernels are CPU kernels created without a graph, so constant inputs are passed as regular inputs and kernels
+// that pre-pack constant weights run their path without pre-packing. Nodes whose shapes are not static after shape
+// inference, with non-tensor values, or with graph or tensor attributes, are skipped and listed on stderr.
+
+#include <benchmark/benchmark.h>
+#include <core/common/parse_string.h>
+#include <core/common/path_string.h>
+#include <core/common/string_utils.h>
+#include <core/framework/allocator.h>
+#include <core/framework/tensorprotoutils.h>
+#include <core/graph/model.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/onnxruntime_cxx_api.h>
+#include <core/session/ort_env.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+using namespace onnxruntime;
+
+void RegisterModelKernelBenchmarks();
+
+namespace {
+
+constexpr const char* kHostDomain = "ai.onnxruntime.benchmark";
+constexpr const char* kHostOpType = "KernelBenchmarkHost";
+
+// A tensor argument of a kernel. Missing optional inputs don't exist.
+struct KernelArg {
+  bool exists = false;
+  int32_t elem_type = 0;
+  std::vector<int64_t> shape;
+  // constant initializer of the model that is passed as the input, instead of random values
+  const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
+};
+
+// A distinct kernel of the model
+struct ModelKernel {
+  std::string op_type;
+  std::string domain;
+  int since_version = 0;
+  std::vector<ONNX_NAMESPACE::AttributeProto> attributes;
+  std::vector<std::string> type_constraint_names;
+  std::vector<ONNXTensorElementDataType> type_constraint_values;
+  std::vector<KernelArg> inputs;
+  std::vector<KernelArg> outputs;
+  // number of nodes of the model that run the kernel
+  int num_nodes = 0;
+  // owns the initializers
+  std::shared_ptr<Model> model;
+  PathString model_path;
+};
+
+Status GetStaticShape(const NodeArg& arg, KernelArg& kernel_arg) {
+  const auto* type = arg.TypeAsProto();
+  ORT_RETURN_IF(type == nullptr || !type->has_tensor_type(), "'", arg.Name(), "' is not a tensor");
+  const auto* shape = arg.Shape();
+  ORT_RETURN_IF(shape == nullptr, "the shape of '", arg.Name(), "' is unknown");
+  kernel_arg.exists = true;
+  kernel_arg.elem_type = type->tensor_type().elem_type();
+  for (const auto& dim : shape->dim()) {
+    ORT_RETURN_IF_NOT(dim.has_dim_value(), "the shape of '", arg.Name(), "' is not static");
+    kernel_arg.shape.push_back(dim.dim_value());
+  }
+  return Status::OK();
+}
+
+std::string ArgToString(const KernelArg& arg) {
+  if (!arg.exists) {
+    return "none";
+  }
+  std::string type = ONNX_NAMESPACE::TensorProto_DataType_Name(arg.elem_type);
+  std::transform(type.begin(), type.end(), type.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  std::ostringstream out;
+  out << type << "[";
+  for (size_t i = 0; i < arg.shape.size(); ++i) {
+    out << (i > 0 ? "," : "") << arg.shape[i];
+  }
+  out << "]";
+  return out.str();
+}
+
+// Fills kernel with the op, attributes and tensor arguments of node, and key with what identifies the kernel
+Status ExtractKernel(const Graph& graph, const Node& node, ModelKernel& kernel, std::string& key) {
+  const auto* schema = node.Op();
+  ORT_RETURN_IF(schema == nullptr, "the op schema is unknown");
+  kernel.op_type = node.OpType();
+  kernel.domain = node.Domain();
+  kernel.since_version = node.SinceVersion();
+
+  std::ostringstream key_stream;
+  key_stream << node.Domain() << ":" << node.OpType() << ":" << node.SinceVersion();
+
+  // attributes ordered by name for the key
+  std::map<std::string, const ONNX_NAMESPACE::AttributeProto*> attributes;
+  for (const auto& attribute : node.GetAttributes()) {
+    attributes.emplace(attribute.first, &attribute.second);
+  }
+  for (const auto& [name, attribute] : attributes) {
+    switch (attribute->type()) {
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_INT:
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_INTS:
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_FLOAT:
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_FLOATS:
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_STRING:
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_STRINGS:
+        break;
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "the standalone op invoker doesn't support the type of ",
+                               "attribute '", name, "'");
+    }
+    kernel.attributes.push_back(*attribute);
+    key_stream << ":" << attribute->SerializeAsString();
+  }
+
+  // the kernel is looked up with the element types of its type constraints
+  std::map<std::string, ONNXTensorElementDataType> type_constraints;
+  auto add_type_constraint = [&](const std::vector<ONNX_NAMESPACE::OpSchema::FormalParameter>& formals, size_t index,
+                                 int32_t elem_type) {
+    if (formals.empty()) {
+      return;
+    }
+    // the last formal parameter may be variadic
+    const auto& type_str = formals[std::min(index, formals.size() - 1)].GetTypeStr();
+    for (const auto& constraint : schema->typeConstraintParams()) {
+      if (constraint.type_param_str == type_str) {
+        type_constraints.emplace(type_str, static_cast<ONNXTensorElementDataType>(elem_type));
+      }
+    }
+  };
+
+  for (size_t i = 0; i < node.InputDefs().size(); ++i) {
+    const NodeArg& arg = *node.InputDefs()[i];
+    KernelArg input;
+    if (arg.Exists()) {
+      ORT_RETURN_IF_ERROR(GetStaticShape(arg, input));
+      graph.GetInitializedTensor(arg.Name(), input.initializer);
+      add_type_constraint(schema->inputs(), i, input.elem_type);
+    }
+    key_stream << ":" << ArgToString(input);
+    // small integer constants such as axes and shapes select what the kernel does
+    if (input.initializer != nullptr && input.elem_type != ONNX_NAMESPACE::TensorProto_DataType_FLOAT &&
+        input.initializer->ByteSizeLong() <= 1024) {
+      key_stream << "=" << input.initializer->SerializeAsString();
+    }
+    kernel.inputs.push_back(std::move(input));
+  }
+
+  // missing optional outputs can only be left out at the end
+  size_t num_outputs = node.OutputDefs().size();
+  while (num_outputs > 0 && !node.OutputDefs()[num_outputs - 1]->Exists()) {
+    --num_outputs;
+  }
+  for (size_t i = 0; i < num_outputs; ++i) {
+    const NodeArg& arg = *node.OutputDefs()[i];
+    ORT_RETURN_IF_NOT(arg.Exists(), "output ", i, " is missing, which the standalone op invoker doesn't support");
+    KernelArg output;
+    ORT_RETURN_IF_ERROR(GetStaticShape(arg, output));
+    add_type_constraint(schema->outputs(), i, output.elem_type);
+    key_stream << ":" << ArgToString(output);
+    kernel.outputs.push_back(std::move(output));
+  }
+
+  for (const auto& [name, value] : type_constraints) {
+    kernel.type_constraint_names.push_back(name);
+    kernel.type_constraint_values.push_back(value);
+  }
+  key = key_stream.str();
+  return Status::OK();
+}
+
+// Loads the model with the symbolic dimensions of its inputs set to dims, and returns its distinct kernels in the
+// order of their first node.
+Status LoadModelKernels(const PathString& model_path, const std::unordered_map<std::string, int64_t>& dims,
+                        const logging::Logger& logger, std::vector<std::shared_ptr<ModelKernel>>& kernels) {
+  ONNX_NAMESPACE::ModelProto model_proto;
+  ORT_RETURN_IF_ERROR(Model::Load(model_path, model_proto));
+  for (auto& input : *model_proto.mutable_graph()->mutable_input()) {
+    if (!input.type().has_tensor_type() || !input.type().tensor_type().has_shape()) {
+      continue;
+    }
+    for (auto& dim : *input.mutable_type()->mutable_tensor_type()->mutable_shape()->mutable_dim()) {
+      if (!dim.has_dim_value()) {
+        auto it = dims.find(dim.dim_param());
+        dim.set_dim_value(it != dims.end() ? it->second : 1);
+      }
+    }
+  }
+
+  // shape inference runs when the graph is resolved
+  std::shared_ptr<Model> model;
+  ORT_RETURN_IF_ERROR(Model::Load(std::move(model_proto), model_path, model, nullptr, logger));
+  const Graph& graph = model->MainGraph();
+
+  std::unordered_map<std::string, size_t> kernel_by_key;
+  for (const auto& node : graph.Nodes()) {
+    auto kernel = std::make_shared<ModelKernel>();
+    std::string key;
+    auto status = ExtractKernel(graph, node, *kernel, key);
+    if (!status.IsOK()) {
+      std::cerr << "Skipped node '" << node.Name() << "' (" << node.OpType() << "): " << status.ErrorMessage()
+                << std::endl;
+      continue;
+    }
+    auto it = kernel_by_key.emplace(key, kernels.size());
+    if (it.second) {
+      kernel->model = model;
+      kernel->model_path = model_path;
+      kernels.push_back(std::move(kernel));
+    }
+    ++kernels[it.first->second]->num_nodes;
+  }
+  return Status::OK();
+}
+
+// State of a benchmark shared with the kernel of the host op
+struct KernelBenchmarkContext {
+  const ModelKernel& kernel;
+  benchmark::State& state;
+  std::vector<const OrtValue*> inputs;
+  std::vector<OrtValue*> outputs;
+};
+
+// Kernel of the op that the benchmark session runs. The standalone op invoker needs the kernel info and the kernel
+// context of a custom op, so the benchmarked kernel is created and timed inside the host kernel, which leaves the
+// overhead of the session out of the measurement.
+struct KernelBenchmarkHostKernel {
+  KernelBenchmarkHostKernel(const OrtKernelInfo* info, KernelBenchmarkContext& context)
+      : info_copy_(Ort::ConstKernelInfo{info}.Copy()), context_(context) {
+    const ModelKernel& kernel = context_.kernel;
+    std::vector<const char*> type_constraint_names;
+    for (const auto& name : kernel.type_constraint_names) {
+      type_constraint_names.push_back(name.c_str());
+    }
+    std::vector<Ort::OpAttr> attributes;
+    for (const auto& attribute : kernel.attributes) {
+      attributes.push_back(CreateOpAttr(attribute));
+    }
+    op_ = Ort::Op::Create(info_copy_, kernel.op_type.c_str(), kernel.domain.c_str(), kernel.since_version,
+                          type_constraint_names.data(), kernel.type_constraint_values.data(),
+                          type_constraint_names.size(), attributes.data(), attributes.size(), kernel.inputs.size(),
+                          kernel.outputs.size());
+  }
+
+  void Compute(OrtKernelContext* context) {
+    auto invoke = [&]() {
+      op_.Invoke(context, context_.inputs.data(), context_.inputs.size(), context_.outputs.data(),
+                 context_.outputs.size());
+    };
+    // warm up, and report errors before timing
+    invoke();
+    for (auto _ : context_.state) {
+      invoke();
+    }
+
+    const int64_t output_shape[] = {1};
+    Ort::KernelContext{context}.GetOutput(0, output_shape, 1).GetTensorMutableData<float>()[0] = 0.0f;
+  }
+
+ private:
+  static Ort::OpAttr CreateOpAttr(const ONNX_NAMESPACE::AttributeProto& attribute) {
+    const char* name = attribute.name().c_str();
+    switch (attribute.type()) {
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_INT: {
+        const int64_t value = attribute.i();
+        return Ort::OpAttr(name, &value, 1, OrtOpAttrType::ORT_OP_ATTR_INT);
+      }
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_INTS:
+        return Ort::OpAttr(name, attribute.ints().data(), attribute.ints_size(), OrtOpAttrType::ORT_OP_ATTR_INTS);
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_FLOAT: {
+        const float value = attribute.f();
+        return Ort::OpAttr(name, &value, 1, OrtOpAttrType::ORT_OP_ATTR_FLOAT);
+      }
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_FLOATS:
+        return Ort::OpAttr(name, attribute.floats().data(), attribute.floats_size(),
+                           OrtOpAttrType::ORT_OP_ATTR_FLOATS);
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_STRING:
+        return Ort::OpAttr(name, attribute.s().c_str(), 1, OrtOpAttrType::ORT_OP_ATTR_STRING);
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_STRINGS: {
+        std::vector<const char*> values;
+        for (const auto& value : attribute.strings()) {
+          values.push_back(value.c_str());
+        }
+        return Ort::OpAttr(name, values.data(), static_cast<int>(values.size()), OrtOpAttrType::ORT_OP_ATTR_STRINGS);
+      }
+      default:
+        ORT_THROW("Unsupported type of attribute ", attribute.name());
+    }
+  }
+
+  Ort::KernelInfo info_copy_;
+  Ort::Op op_{nullptr};
+  KernelBenchmarkContext& context_;
+};
+
+// Custom op with a float input and a float output that hosts the benchmarked kernel
+struct KernelBenchmarkHostOp : Ort::CustomOpBase<KernelBenchmarkHostOp, KernelBenchmarkHostKernel> {
+  explicit KernelBenchmarkHostOp(KernelBenchmarkContext& context) : context_(context) {}
+
+  void* CreateKernel(const OrtApi& /* api */, const OrtKernelInfo* info) const {
+    return new KernelBenchmarkHostKernel(info, context_);
+  }
+  const char* GetName() const { return kHostOpType; }
+
+  size_t GetInputTypeCount() const { return 1; }
+  ONNXTensorElementDataType GetInputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; }
+
+  size_t GetOutputTypeCount() const { return 1; }
+  ONNXTensorElementDataType GetOutputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; }
+
+ private:
+  KernelBenchmarkContext& context_;
+};
+
+// A model with a single host op node from x to y, both float tensors of shape [1]
+std::string HostModel() {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  auto* onnx_opset = model.add_opset_import();
+  onnx_opset->set_domain("");
+  onnx_opset->set_version(17);
+  auto* host_opset = model.add_opset_import();
+  host_opset->set_domain(kHostDomain);
+  host_opset->set_version(1);
+
+  auto* graph = model.mutable_graph();
+  graph->set_name("kernel_benchmark_host");
+  auto* node = graph->add_node();
+  node->set_op_type(kHostOpType);
+  node->set_domain(kHostDomain);
+  node->add_input("x");
+  node->add_output("y");
+  auto set_value_info = [](ONNX_NAMESPACE::ValueInfoProto& value, const char* name) {
+    value.set_name(name);
+    auto* tensor_type = value.mutable_type()->mutable_tensor_type();
+    tensor_type->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    tensor_type->mutable_shape()->add_dim()->set_dim_value(1);
+  };
+  set_value_info(*graph->add_input(), "x");
+  set_value_info(*graph->add_output(), "y");
+  return model.SerializeAsString();
+}
+
+// Allocates the tensors of the arguments. Inputs get the initializer of the model or random values.
+Status CreateArgValues(const ModelKernel& kernel, const std::vector<KernelArg>& args, std::vector<OrtValue>& values) {
+  auto allocator = std::make_shared<CPUAllocator>();
+  std::mt19937 rand_engine(42);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  values.resize(args.size());
+  for (size_t i = 0; i < args.size(); ++i) {
+    const KernelArg& arg = args[i];
+    if (!arg.exists) {
+      continue;
+    }
+    if (arg.initializer != nullptr) {
+      ORT_RETURN_IF_ERROR(utils::TensorProtoToOrtValue(Env::Default(), kernel.model_path.c_str(), *arg.initializer,
+                                                       allocator, values[i]));
+      continue;
+    }
+    const auto* tensor_type = DataTypeImpl::TensorTypeFromONNXEnum(arg.elem_type);
+    ORT_RETURN_IF(tensor_type == nullptr, "unsupported element type ", arg.elem_type);
+    Tensor::InitOrtValue(tensor_type->GetElementType(), TensorShape(arg.shape), allocator, values[i]);
+    auto& tensor = *values[i].GetMutable<Tensor>();
+    if (tensor.IsDataType<float>()) {
+      auto data = tensor.MutableDataAsSpan<float>();
+      std::generate(data.begin(), data.end(), [&]() { return dist(rand_engine); });
+    } else if (!tensor.IsDataTypeString()) {
+      // zeros are valid indices and sizes
+      std::memset(tensor.MutableDataRaw(), 0, tensor.SizeInBytes());
+    }
+  }
+  return Status::OK();
+}
+
+// args: intra-op threads
+void BM_ModelKernel(benchmark::State& state, const ModelKernel& kernel) {
+  const int threads = static_cast<int>(state.range(0));
+  state.counters["nodes"] = kernel.num_nodes;
+
+  std::vector<OrtValue> input_values, output_values;
+  auto status = CreateArgValues(kernel, kernel.inputs, input_values);
+  if (status.IsOK()) {
+    status = CreateArgValues(kernel, kernel.outputs, output_values);
+  }
+  if (!status.IsOK()) {
+    state.SkipWithError(status.ErrorMessage().c_str());
+    return;
+  }
+
+  KernelBenchmarkContext context{kernel, state, {}, {}};
+  for (size_t i = 0; i < input_values.size(); ++i) {
+    context.inputs.push_back(kernel.inputs[i].exists ? &input_values[i] : nullptr);
+  }
+  for (auto& value : output_values) {
+    context.outputs.push_back(&value);
+  }
+
+  try {
+    KernelBenchmarkHostOp host_op(context);
+    Ort::CustomOpDomain host_domain(kHostDomain);
+    host_domain.Add(&host_op);
+    Ort::SessionOptions session_options;
+    session_options.SetIntraOpNumThreads(threads);
+    session_options.Add(host_domain);
+
+    const std::string model_data = HostModel();
+    OrtSession* raw_session = nullptr;
+    Ort::ThrowOnError(g_ort->CreateSessionFromArray(env, model_data.data(), model_data.size(), session_options,
+                                                    &raw_session));
+    auto release_session = [](OrtSession* session) { g_ort->ReleaseSession(session); };
+    std::unique_ptr<OrtSession, decltype(release_session)> session_owner(raw_session, release_session);
+    Ort::UnownedSession session(raw_session);
+
+    Ort::AllocatorWithDefaultOptions allocator;
+    const int64_t shape[] = {1};
+    auto x = Ort::Value::CreateTensor<float>(allocator, shape, 1);
+    x.GetTensorMutableData<float>()[0] = 0.0f;
+    const char* input_names[] = {"x"};
+    const char* output_names[] = {"y"};
+    // the host kernel runs the timing loop
+    session.Run(Ort::RunOptions{nullptr}, input_names, &x, 1, output_names, 1);
+  } catch (const std::exception& e) {
+    state.SkipWithError(e.what());
+  }
+}
+
+std::vector<int> ThreadCounts(const std::string& value) {
+  std::vector<int> thread_counts;
+  for (auto thread_count : utils::SplitString(value, ",")) {
+    int threads = 0;
+    if (TryParseStringWithClassicLocale(thread_count, threads) && threads > 0) {
+      thread_counts.push_back(threads);
+    } else {
+      std::cerr << "Ignored invalid thread count '" << thread_count << "'" << std::endl;
+    }
+  }
+  if (thread_counts.empty()) {
+    thread_counts.push_back(1);
+  }
+  return thread_counts;
+}
+
+std::unordered_map<std::string, int64_t> DimValues(const std::string& value) {
+  std::unordered_map<std::string, int64_t> dims;
+  for (auto dim : utils::SplitString(value, ",")) {
+    auto name_and_value = utils::SplitString(dim, "=");
+    int64_t dim_value = 0;
+    if (name_and_value.size() == 2 && TryParseStringWithClassicLocale(name_and_value[1], dim_value) &&
+        dim_value > 0) {
+      dims[std::string(name_and_value[0])] = dim_value;
+    } else {
+      std::cerr << "Ignored invalid dimension '" << dim << "'" << std::endl;
+    }
+  }
+  return dims;
+}
+
+}  // namespace
+
+void RegisterModelKernelBenchmarks() {
+  const auto& platform_env = Env::Default();
+  const std::string model_path = platform_env.GetEnvironmentVar("ORT_BENCHMARK_KERNEL_MODEL");
+  if (model_path.empty()) {
+    return;
+  }
+
+  auto logger = env->GetLoggingManager()->CreateLogger("test");
+  std::vector<std::shared_ptr<ModelKernel>> kernels;
+  auto status = LoadModelKernels(ToPathString(model_path),
+                                 DimValues(platform_env.GetEnvironmentVar("ORT_BENCHMARK_KERNEL_DIMS")), *logger,
+                                 kernels);
+  if (!status.IsOK()) {
+    std::cerr << "Failed to extract the kernels of " << model_path << ": " << status.ErrorMessage() << std::endl;
+    return;
+  }
+
+  const auto thread_counts = ThreadCounts(platform_env.GetEnvironmentVar("ORT_BENCHMARK_KERNEL_THREADS"));
+  // kernels that differ only by attributes or constant inputs get a suffix, so that the names identify them when
+  // results are compared
+  std::unordered_map<std::string, int> name_counts;
+  for (const auto& kernel : kernels) {
+    std::ostringstream name;
+    name << "BM_ModelKernel/" << (kernel->domain.empty() ? "" : kernel->domain + ".") << kernel->op_type << "(";
+    for (size_t i = 0; i < kernel->inputs.size(); ++i) {
+      name << (i > 0 ? "," : "") << ArgToString(kernel->inputs[i]);
+    }
+    name << ")";
+    const int count = ++name_counts[name.str()];
+    if (count > 1) {
+      name << "#" << count;
+    }
+
+    auto* b = benchmark::RegisterBenchmark(name.str().c_str(),
+                                           [kernel](benchmark::State& state) { BM_ModelKernel(state, *kernel); });
+    b->ArgName("threads");
+    for (int threads : thread_counts) {
+      b->Arg(threads);
+    }
+    b->UseRealTime();
+    b->Unit(benchmark::TimeUnit::kMicrosecond);
+  }
+}
@@ -0,0 +1,381 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// End-to-end inference benchmarks of small models that are representative of what is deployed: a transformer
+// encoder, a CNN, a tree ensemble and a quantized MLP. The models are generated here with fixed random weights, so
+// the suite doesn't depend on downloaded test data, and each is run across batch sizes and intra-op thread counts.
+//
+// Track regressions by running the suite with repetitions and JSON output for two builds, e.g.
+//   onnxruntime_benchmark --benchmark_filter=BM_ModelSuite --benchmark_repetitions=10
+//                         --benchmark_out=results.json --benchmark_out_format=json
+// and comparing the results with tools/python/compare_benchmark_results.py.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/constants.h>
+#include <core/graph/model.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/onnxruntime_cxx_api.h>
+#include <core/session/ort_env.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+using namespace onnxruntime;
+
+namespace {
+
+// Builds a model with the graph API. Initializers get random values from a fixed seed.
+class ModelSuiteBuilder {
+ public:
+  ModelSuiteBuilder(const std::string& name, const logging::Logger& logger)
+      : model_(name, false, logger), graph_(model_.MainGraph()), rand_engine_(42) {}
+
+  // float input with a symbolic batch dimension followed by dims
+  NodeArg* Input(const std::string& name, const std::vector<int64_t>& dims) {
+    ONNX_NAMESPACE::TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    auto* shape = type.mutable_tensor_type()->mutable_shape();
+    shape->add_dim()->set_dim_param("batch");
+    for (int64_t dim : dims) {
+      shape->add_dim()->set_dim_value(dim);
+    }
+    return &graph_.GetOrCreateNodeArg(name, &type);
+  }
+
+  NodeArg* RandomFloats(const std::vector<int64_t>& dims, float range) {
+    std::uniform_real_distribution<float> dist(-range, range);
+    auto& tensor = NewInitializer(dims, ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    for (int64_t i = 0; i < NumElements(dims); ++i) {
+      tensor.add_float_data(dist(rand_engine_));
+    }
+    return AddInitializer(tensor);
+  }
+
+  NodeArg* Floats(const std::vector<int64_t>& dims, const std::vector<float>& values) {
+    auto& tensor = NewInitializer(dims, ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    for (float value : values) {
+      tensor.add_float_data(value);
+    }
+    return AddInitializer(tensor);
+  }
+
+  NodeArg* FloatScalar(float value) { return Floats({}, {value}); }
+
+  NodeArg* Int64s(const std::vector<int64_t>& values) {
+    auto& tensor = NewInitializer({static_cast<int64_t>(values.size())}, ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    for (int64_t value : values) {
+      tensor.add_int64_data(value);
+    }
+    return AddInitializer(tensor);
+  }
+
+  NodeArg* RandomUint8s(const std::vector<int64_t>& dims) {
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::string data;
+    for (int64_t i = 0; i < NumElements(dims); ++i) {
+      data.push_back(static_cast<char>(dist(rand_engine_)));
+    }
+    auto& tensor = NewInitializer(dims, ONNX_NAMESPACE::TensorProto_DataType_UINT8);
+    tensor.set_raw_data(std::move(data));
+    return AddInitializer(tensor);
+  }
+
+  NodeArg* Uint8Scalar(uint8_t value) {
+    auto& tensor = NewInitializer({}, ONNX_NAMESPACE::TensorProto_DataType_UINT8);
+    tensor.set_raw_data(std::string(1, static_cast<char>(value)));
+    return AddInitializer(tensor);
+  }
+
+  // adds a node with a single output and returns the node, so that attributes can be added
+  Node& AddNode(const std::string& op_type, const std::vector<NodeArg*>& inputs, const std::string& domain = "") {
+    const std::string name = op_type + "_" + std::to_string(graph_.NumberOfNodes());
+    auto* output = &graph_.GetOrCreateNodeArg(name + "_out", nullptr);
+    return graph_.AddNode(name, op_type, "", inputs, {output}, nullptr, domain);
+  }
+
+  NodeArg* Op(const std::string& op_type, const std::vector<NodeArg*>& inputs) {
+    return AddNode(op_type, inputs).MutableOutputDefs()[0];
+  }
+
+  static NodeArg* Output(Node& node) { return node.MutableOutputDefs()[0]; }
+
+  Status Serialize(std::string& model_data) {
+    ORT_RETURN_IF_ERROR(graph_.Resolve());
+    model_data = model_.ToProto().SerializeAsString();
+    return Status::OK();
+  }
+
+ private:
+  static int64_t NumElements(const std::vector<int64_t>& dims) {
+    int64_t n = 1;
+    for (int64_t dim : dims) {
+      n *= dim;
+    }
+    return n;
+  }
+
+  ONNX_NAMESPACE::TensorProto& NewInitializer(const std::vector<int64_t>& dims, int32_t data_type) {
+    tensor_ = ONNX_NAMESPACE::TensorProto();
+    tensor_.set_name("initializer_" + std::to_string(num_initializers_++));
+    tensor_.set_data_type(data_type);
+    for (int64_t dim : dims) {
+      tensor_.add_dims(dim);
+    }
+    return tensor_;
+  }
+
+  NodeArg* AddInitializer(const ONNX_NAMESPACE::TensorProto& tensor) {
+    graph_.AddInitializedTensor(tensor);
+    ONNX_NAMESPACE::TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(tensor.data_type());
+    for (int64_t dim : tensor.dims()) {
+      type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+    return &graph_.GetOrCreateNodeArg(tensor.name(), &type);
+  }
+
+  Model model_;
+  Graph& graph_;
+  std::mt19937 rand_engine_;
+  ONNX_NAMESPACE::TensorProto tensor_;
+  int num_initializers_ = 0;
+};
+
+// Two pre-norm encoder layers with 4 heads, a hidden size of 256, a sequence length of 128 and an FFN of 1024 with
+// the Erf form of Gelu, like exported BERT models before fusion.
+Status BuildTransformer(const logging::Logger& logger, std::string& model_data) {
+  constexpr int64_t seq_len = 128, hidden = 256, heads = 4, head_size = hidden / heads, ffn = 1024;
+  ModelSuiteBuilder b("transformer", logger);
+
+  auto layer_norm = [&](NodeArg* x) {
+    auto& node = b.AddNode("LayerNormalization",
+                           {x, b.Floats({hidden}, std::vector<float>(hidden, 1.0f)), b.RandomFloats({hidden}, 0.1f)});
+    node.AddAttribute("axis", int64_t{-1});
+    return ModelSuiteBuilder::Output(node);
+  };
+  auto dense = [&](NodeArg* x, int64_t in, int64_t out) {
+    return b.Op("Add", {b.Op("MatMul", {x, b.RandomFloats({in, out}, 0.05f)}), b.RandomFloats({out}, 0.05f)});
+  };
+  auto transpose = [&](NodeArg* x, const std::vector<int64_t>& perm) {
+    auto& node = b.AddNode("Transpose", {x});
+    node.AddAttribute("perm", perm);
+    return ModelSuiteBuilder::Output(node);
+  };
+
+  NodeArg* x = b.Input("input", {seq_len, hidden});
+  for (int layer = 0; layer < 2; ++layer) {
+    NodeArg* ln = layer_norm(x);
+    NodeArg* head_shape = b.Int64s({0, 0, heads, head_size});
+    NodeArg* q = transpose(b.Op("Reshape", {dense(ln, hidden, hidden), head_shape}), {0, 2, 1, 3});
+    NodeArg* k = transpose(b.Op("Reshape", {dense(ln, hidden, hidden), head_shape}), {0, 2, 3, 1});
+    NodeArg* v = transpose(b.Op("Reshape", {dense(ln, hidden, hidden), head_shape}), {0, 2, 1, 3});
+
+    NodeArg* scale = b.FloatScalar(1.0f / std::sqrt(static_cast<float>(head_size)));
+    NodeArg* scores = b.Op("Mul", {b.Op("MatMul", {q, k}), scale});
+    auto& softmax = b.AddNode("Softmax", {scores});
+    softmax.AddAttribute("axis", int64_t{-1});
+    NodeArg* context = b.Op("MatMul", {ModelSuiteBuilder::Output(softmax), v});
+    context = b.Op("Reshape", {transpose(context, {0, 2, 1, 3}), b.Int64s({0, 0, hidden})});
+    x = b.Op("Add", {x, dense(context, hidden, hidden)});
+
+    NodeArg* ff = dense(layer_norm(x), hidden, ffn);
+    NodeArg* erf = b.Op("Erf", {b.Op("Mul", {ff, b.FloatScalar(1.0f / std::sqrt(2.0f))})});
+    NodeArg* gelu = b.Op("Mul", {b.Op("Mul", {ff, b.Op("Add", {erf, b.FloatScalar(1.0f)})}), b.FloatScalar(0.5f)});
+    x = b.Op("Add", {x, dense(gelu, ffn, hidden)});
+  }
+
+  return b.Serialize(model_data);
+}
+
+// Three 3x3 Conv + Relu blocks on a 64x64 RGB image, with max pooling, then global average pooling and a classifier.
+Status BuildCnn(const logging::Logger& logger, std::string& model_data) {
+  ModelSuiteBuilder b("cnn", logger);
+
+  NodeArg* x = b.Input("input", {3, 64, 64});
+  int64_t channels = 3;
+  for (int64_t out_channels : {16, 32, 64}) {
+    auto& conv = b.AddNode("Conv", {x, b.RandomFloats({out_channels, channels, 3, 3}, 0.1f),
+                                    b.RandomFloats({out_channels}, 0.1f)});
+    conv.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    x = b.Op("Relu", {ModelSuiteBuilder::Output(conv)});
+    if (out_channels != 64) {
+      auto& pool = b.AddNode("MaxPool", {x});
+      pool.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+      pool.AddAttribute("strides", std::vector<int64_t>{2, 2});
+      x = ModelSuiteBuilder::Output(pool);
+    }
+    channels = out_channels;
+  }
+  x = b.Op("Flatten", {b.Op("GlobalAveragePool", {x})});
+  b.Op("Gemm", {x, b.RandomFloats({channels, 10}, 0.1f), b.RandomFloats({10}, 0.1f)});
+
+  return b.Serialize(model_data);
+}
+
+#if !defined(DISABLE_ML_OPS)
+// TreeEnsembleRegressor with 100 complete trees of depth 6 over 32 features.
+Status BuildTreeEnsemble(const logging::Logger& logger, std::string& model_data) {
+  constexpr int64_t num_features = 32, num_trees = 100, depth = 6;
+  constexpr int64_t num_nodes = (int64_t{1} << (depth + 1)) - 1, first_leaf = (int64_t{1} << depth) - 1;
+  ModelSuiteBuilder b("tree_ensemble", logger);
+
+  std::mt19937 rand_engine(42);
+  std::uniform_int_distribution<int64_t> feature_dist(0, num_features - 1);
+  std::uniform_real_distribution<float> value_dist(-1.0f, 1.0f);
+  std::vector<int64_t> tree_ids, node_ids, feature_ids, true_ids, false_ids;
+  std::vector<int64_t> target_tree_ids, target_node_ids, target_ids;
+  std::vector<float> values, target_weights;
+  std::vector<std::string> modes;
+  for (int64_t tree = 0; tree < num_trees; ++tree) {
+    // node i has children 2i+1 and 2i+2
+    for (int64_t node = 0; node < num_nodes; ++node) {
+      const bool leaf = node >= first_leaf;
+      tree_ids.push_back(tree);
+      node_ids.push_back(node);
+      feature_ids.push_back(leaf ? 0 : feature_dist(rand_engine));
+      values.push_back(leaf ? 0.0f : value_dist(rand_engine));
+      modes.push_back(leaf ? "LEAF" : "BRANCH_LEQ");
+      true_ids.push_back(leaf ? 0 : 2 * node + 1);
+      false_ids.push_back(leaf ? 0 : 2 * node + 2);
+      if (leaf) {
+        target_tree_ids.push_back(tree);
+        target_node_ids.push_back(node);
+        target_ids.push_back(0);
+        target_weights.push_back(value_dist(rand_engine));
+      }
+    }
+  }
+
+  auto& node = b.AddNode("TreeEnsembleRegressor", {b.Input("input", {num_features})}, kMLDomain);
+  node.AddAttribute("n_targets", int64_t{1});
+  node.AddAttribute("nodes_treeids", tree_ids);
+  node.AddAttribute("nodes_nodeids", node_ids);
+  node.AddAttribute("nodes_featureids", feature_ids);
+  node.AddAttribute("nodes_values", values);
+  node.AddAttribute("nodes_modes", modes);
+  node.AddAttribute("nodes_truenodeids", true_ids);
+  node.AddAttribute("nodes_falsenodeids", false_ids);
+  node.AddAttribute("target_treeids", target_tree_ids);
+  node.AddAttribute("target_nodeids", target_node_ids);
+  node.AddAttribute("target_ids", target_ids);
+  node.AddAttribute("target_weights", target_weights);
+
+  return b.Serialize(model_data);
+}
+#endif
+
+// MLP of 256 -> 1024 -> 256 with uint8 QLinearMatMul, between QuantizeLinear and DequantizeLinear.
+Status BuildQuantizedMlp(const logging::Logger& logger, std::string& model_data) {
+  constexpr int64_t hidden = 256, ffn = 1024;
+  ModelSuiteBuilder b("quantized_mlp", logger);
+
+  NodeArg* scale = b.FloatScalar(0.02f);
+  NodeArg* zero_point = b.Uint8Scalar(128);
+  NodeArg* x = b.Op("QuantizeLinear", {b.Input("input", {hidden}), scale, zero_point});
+  x = b.Op("QLinearMatMul", {x, scale, zero_point, b.RandomUint8s({hidden, ffn}), scale, zero_point, scale,
+                             zero_point});
+  x = b.Op("QLinearMatMul", {x, scale, zero_point, b.RandomUint8s({ffn, hidden}), scale, zero_point, scale,
+                             zero_point});
+  b.Op("DequantizeLinear", {x, scale, zero_point});
+
+  return b.Serialize(model_data);
+}
+
+#define ORT_SKIP_ON_ERROR(expr)                                 \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0)
+
+// args: batch size, intra-op threads
+void BM_ModelSuite(benchmark::State& state, Status (*build_model)(const logging::Logger&, std::string&)) {
+  const int64_t batch_size = state.range(0);
+  const int threads = static_cast<int>(state.range(1));
+
+  auto logger = env->GetLoggingManager()->CreateLogger("test");
+  std::string model_data;
+  auto st = build_model(*logger, model_data);
+  if (!st.IsOK()) {
+    state.SkipWithError(st.ErrorMessage().c_str());
+    return;
+  }
+
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(threads);
+  OrtSession* raw_session = nullptr;
+  ORT_SKIP_ON_ERROR(g_ort->CreateSessionFromArray(env, model_data.data(), model_data.size(), session_options,
+                                                  &raw_session));
+  auto release_session = [](OrtSession* session) { g_ort->ReleaseSession(session); };
+  std::unique_ptr<OrtSession, decltype(release_session)> session_owner(raw_session, release_session);
+  Ort::UnownedSession session(raw_session);
+
+  // every input is float, with the batch size as the first dimension
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::mt19937 rand_engine(42);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<Ort::AllocatedStringPtr> name_ptrs;
+  std::vector<const char*> input_names, output_names;
+  std::vector<Ort::Value> inputs;
+  for (size_t i = 0; i < session.GetInputCount(); ++i) {
+    name_ptrs.push_back(session.GetInputNameAllocated(i, allocator));
+    input_names.push_back(name_ptrs.back().get());
+    auto shape = session.GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape();
+    shape[0] = batch_size;
+    inputs.push_back(Ort::Value::CreateTensor<float>(allocator, shape.data(), shape.size()));
+    auto* data = inputs.back().GetTensorMutableData<float>();
+    for (size_t j = 0; j < inputs.back().GetTensorTypeAndShapeInfo().GetElementCount(); ++j) {
+      data[j] = dist(rand_engine);
+    }
+  }
+  for (size_t i = 0; i < session.GetOutputCount(); ++i) {
+    name_ptrs.push_back(session.GetOutputNameAllocated(i, allocator));
+    output_names.push_back(name_ptrs.back().get());
+  }
+
+  auto run = [&]() {
+    return session.Run(Ort::RunOptions{nullptr}, input_names.data(), inputs.data(), inputs.size(),
+                       output_names.data(), output_names.size());
+  };
+  // the first run allocates the memory patterns
+  run();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(run());
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+void ModelSuiteArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"batch", "threads"});
+  b->ArgsProduct({{1, 8, 32}, {1, 4}});
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_ModelSuite, transformer, &BuildTransformer)
+    ->Apply(ModelSuiteArgs)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+BENCHMARK_CAPTURE(BM_ModelSuite, cnn, &BuildCnn)
+    ->Apply(ModelSuiteArgs)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+#if !defined(DISABLE_ML_OPS)
+BENCHMARK_CAPTURE(BM_ModelSuite, tree_ensemble, &BuildTreeEnsemble)
+    ->Apply(ModelSuiteArgs)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+#endif
+BENCHMARK_CAPTURE(BM_ModelSuite, quantized_mlp, &BuildQuantizedMlp)
+    ->Apply(ModelSuiteArgs)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond);
@@ -69,3 +69,72 @@ static void BM_CreateSession(benchmark::State& state) {
   g_ort->ReleaseSessionOptions(session_option);
 }
 BENCHMARK(BM_CreateSession);
+
+// Builds a model with a chain of state.range(0) Relu nodes.
+static std::unique_ptr<onnxruntime::Model> CreateReluChainModel(benchmark::State& state,
+                                                                const onnxruntime::logging::Logger& logger) {
+  auto model = std::make_unique<onnxruntime::Model>("relu_chain", false, logger);
+  auto& graph = model->MainGraph();
+
+  ONNX_NAMESPACE::TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64);
+
+  auto* input = &graph.GetOrCreateNodeArg("input", &tensor_float);
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    const std::string name = "relu_" + std::to_string(i);
+    auto* output = &graph.GetOrCreateNodeArg(name + "_out", nullptr);
+    graph.AddNode(name, "Relu", "", {input}, {output});
+    input = output;
+  }
+
+  return model;
+}
+
+static void BM_ResolveGraph(benchmark::State& state) {
+  auto logger = env->GetLoggingManager()->CreateLogger("test");
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto model = CreateReluChainModel(state, *logger);
+    state.ResumeTiming();
+
+    auto st = model->MainGraph().Resolve();
+    if (!st.IsOK()) {
+      state.SkipWithError(st.ErrorMessage().c_str());
+      break;
+    }
+  }
+}
+
+BENCHMARK(BM_ResolveGraph)->RangeMultiplier(4)->Range(1 << 8, 1 << 16)->Unit(benchmark::TimeUnit::kMillisecond);
+
+// Resolve after a graph transformer changed a single node, which is what most of the Resolve calls during
+// optimization are.
+static void BM_ResolveGraphAfterNodeChange(benchmark::State& state) {
+  auto logger = env->GetLoggingManager()->CreateLogger("test");
+  auto model = CreateReluChainModel(state, *logger);
+  auto& graph = model->MainGraph();
+  auto st = graph.Resolve();
+  if (!st.IsOK()) {
+    state.SkipWithError(st.ErrorMessage().c_str());
+    return;
+  }
+
+  auto* changed_node = graph.GetNode(static_cast<onnxruntime::NodeIndex>(state.range(0) / 2));
+  for (auto _ : state) {
+    changed_node->MutableOutputDefs()[0]->ClearShape();
+    graph.SetGraphResolveNeeded();
+
+    st = graph.Resolve();
+    if (!st.IsOK()) {
+      state.SkipWithError(st.ErrorMessage().c_str());
+      break;
+    }
+  }
+}
+
+BENCHMARK(BM_ResolveGraphAfterNodeChange)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 16)
+    ->Unit(benchmark::TimeUnit::kMillisecond);
@@ -0,0 +1,80 @@
+#include "common.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/string_lookup_table.h"
+
+namespace {
+
+// Dictionary of categorical values and 1M input rows of which roughly half hit the dictionary.
+struct StringLookupData {
+  std::vector<std::string> keys;
+  std::vector<std::string> rows;
+
+  StringLookupData(size_t num_keys, size_t num_rows) {
+    std::mt19937 gen(42);
+    keys.reserve(num_keys);
+    for (size_t i = 0; i < num_keys; ++i) {
+      keys.push_back("category_" + std::to_string(i));
+    }
+    std::uniform_int_distribution<size_t> dist(0, num_keys * 2);
+    rows.reserve(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+      rows.push_back("category_" + std::to_string(dist(gen)));
+    }
+  }
+};
+
+constexpr size_t kNumRows = 1000000;
+
+}  // namespace
+
+static void BM_StringLookupUnorderedMap(benchmark::State& state) {
+  StringLookupData data(static_cast<size_t>(state.range(0)), kNumRows);
+  std::unordered_map<std::string, int64_t> map;
+  for (size_t i = 0; i < data.keys.size(); ++i) {
+    map[data.keys[i]] = static_cast<int64_t>(i);
+  }
+  std::vector<int64_t> output(data.rows.size());
+  for (auto _ : state) {
+    const auto map_end = map.end();
+    for (size_t i = 0; i < data.rows.size(); ++i) {
+      auto it = map.find(data.rows[i]);
+      output[i] = it == map_end ? -1 : it->second;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(data.rows.size()));
+}
+
+BENCHMARK(BM_StringLookupUnorderedMap)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Arg(100)
+    ->Arg(10000)
+    ->Arg(1000000);
+
+static void BM_StringLookupTable(benchmark::State& state) {
+  StringLookupData data(static_cast<size_t>(state.range(0)), kNumRows);
+  onnxruntime::StringLookupTable<int64_t> table;
+  table.reserve(data.keys.size());
+  for (size_t i = 0; i < data.keys.size(); ++i) {
+    table.InsertOrAssign(data.keys[i], static_cast<int64_t>(i));
+  }
+  std::vector<int64_t> output(data.rows.size());
+  for (auto _ : state) {
+    table.FindAll(data.rows.data(), data.rows.size(), output.data(), int64_t{-1});
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(data.rows.size()));
+}
+
+BENCHMARK(BM_StringLookupTable)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Arg(100)
+    ->Arg(10000)
+    ->Arg(1000000);
@@ -70,6 +70,7 @@
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/optimizer/scaler_linear_fusion.h"
 #include "core/optimizer/shape_input_merge.h"
 #include "core/optimizer/slice_elimination.h"
 #include "core/optimizer/unsqueeze_elimination.h"
@@ -1974,6 +1975,57 @@ TEST_F(GraphTransformationTests, LabelEncoderFusion) {
   EXPECT_EQ(ret.first, COMPARE_RESULT::SUCCESS) << ret.second;
 }
 
+#if !defined(DISABLE_ML_OPS)
+TEST_F(GraphTransformationTests, ScalerLinearFusion) {
+  const char* code = R"ONNX(
+<
+  ir_version: 8,
+  opset_import: ["" : 17, "ai.onnx.ml" : 3]
+>
+agraph (float[N, 3] X) => (float[N, 2] Y) {
+  scaled = ai.onnx.ml.Scaler <offset: floats = [1.0, 2.0, -1.0], scale: floats = [0.5, 2.0, 4.0]> (X)
+  Y = ai.onnx.ml.LinearRegressor <coefficients: floats = [1.0, 2.0, 3.0, -1.0, 0.5, 0.25], intercepts: floats = [0.5, -0.5], targets: int = 2> (scaled)
+}
+)ONNX";
+
+  ONNX_NAMESPACE::OnnxParser parser(code);
+  ONNX_NAMESPACE::ModelProto model_proto;
+  auto parse_status = parser.Parse(model_proto);
+  ASSERT_TRUE(parse_status.IsOK()) << parse_status.ErrorMessage();
+
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(std::move(model_proto), model, nullptr, *logger_));
+  Graph& graph = model->MainGraph();
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.Scaler"], 1);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  auto rule_transformer_L1 = std::make_unique<RuleBasedGraphTransformer>("RuleTransformer1");
+  ASSERT_STATUS_OK(rule_transformer_L1->Register(std::make_unique<ScalerLinearFusion>()));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(rule_transformer_L1), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.Scaler"], 0);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.LinearRegressor"], 1);
+
+  // coefficients are scaled per feature and the offsets are folded into the intercepts
+  const std::vector<float> expected_coefficients = {0.5f, 4.0f, 12.0f, -0.5f, 1.0f, 1.0f};
+  const std::vector<float> expected_intercepts = {4.0f, -1.0f};
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "LinearRegressor") {
+      EXPECT_EQ(node.InputDefs()[0]->Name(), "X");
+      const auto& coefficients = node.GetAttributes().at("coefficients").floats();
+      const auto& intercepts = node.GetAttributes().at("intercepts").floats();
+      EXPECT_THAT(std::vector<float>(coefficients.begin(), coefficients.end()),
+                  testing::Pointwise(testing::FloatEq(), expected_coefficients));
+      EXPECT_THAT(std::vector<float>(intercepts.begin(), intercepts.end()),
+                  testing::Pointwise(testing::FloatEq(), expected_intercepts));
+    }
+  }
+}
+#endif  // !defined(DISABLE_ML_OPS)
+
 TEST_F(GraphTransformationTests, NotWhereFusion) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/not_where.onnx";
   std::shared_ptr<Model> model;
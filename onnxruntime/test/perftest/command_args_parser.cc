@@ -143,6 +143,13 @@ namespace perftest {
       "\t-D [Disable thread spinning]: disable spinning entirely for thread owned by onnxruntime intra-op thread pool.\n"
       "\t-Z [Force thread to stop spinning between runs]: disallow thread from spinning during runs to reduce cpu usage.\n"
       "\t-n [Exit after session creation]: allow user to measure session creation time to measure impact of enabling any initialization optimizations.\n"
+      "\t-Q [qps,...]: Open-loop mode. Requests are started with RunAsync at the target rate whether or not the previous ones completed,\n"
+      "\t for -t seconds at each of the comma separated rates. Prints the throughput and latency percentiles at each rate.\n"
+      "\t Latencies are measured from the scheduled start of the requests, so queueing delays are included.\n"
+      "\t-a [poisson|fixed]: Arrivals in open-loop mode, with exponentially distributed or fixed intervals. Default:'poisson'.\n"
+      "\t-N [num_sessions]: Number of sessions of the model that open-loop requests are spread over. Requires -Q. Default:1.\n"
+      "\t-R [Op report]: profile the run and print the achieved GFLOP/s and GB/s of every node against the measured peak of the machine,\n"
+      "\t sorted by the time lost against the roofline. The profile is written to the -p file, or to onnxruntime_perf_test_op_report_<time>.json.\n"
       "\t-h: help\n");
 }
 #ifdef _WIN32
@@ -203,9 +210,29 @@ static bool ParseSessionConfigs(const std::string& configs_string,
   return true;
 }
 
+static bool ParseOpenLoopQps(const std::string& qps_string, std::vector<double>& qps_values) {
+  std::istringstream ss(qps_string);
+  std::string token;
+
+  while (std::getline(ss, token, ',')) {
+    ORT_TRY {
+      const double qps = std::stod(token);
+      if (!(qps > 0)) {
+        return false;
+      }
+      qps_values.push_back(qps);
+    }
+    ORT_CATCH(...) {
+      return false;
+    }
+  }
+
+  return !qps_values.empty();
+}
+
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:AMPIDZvhsqzn"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:Q:a:N:AMPIDZvhsqznR"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -388,6 +415,32 @@ static bool ParseSessionConfigs(const std::string& configs_string,
       case 'n':
         test_config.run_config.exit_after_session_creation = true;
         break;
+      case 'R':
+        test_config.run_config.f_op_report = true;
+        break;
+      case 'Q':
+        if (!ParseOpenLoopQps(ToUTF8String(optarg), test_config.run_config.open_loop_qps)) {
+          return false;
+        }
+        break;
+      case 'a':
+        if (!CompareCString(optarg, ORT_TSTR("poisson"))) {
+          test_config.run_config.open_loop_poisson_arrivals = true;
+        } else if (!CompareCString(optarg, ORT_TSTR("fixed"))) {
+          test_config.run_config.open_loop_poisson_arrivals = false;
+        } else {
+          return false;
+        }
+        break;
+      case 'N': {
+        // parsed as signed so that a negative count is rejected rather than wrapping around
+        const long num_sessions = OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr);
+        if (num_sessions < 1) {
+          return false;
+        }
+        test_config.run_config.num_sessions = static_cast<size_t>(num_sessions);
+        break;
+      }
       case '?':
       case 'h':
       default:
@@ -395,6 +448,15 @@ static bool ParseSessionConfigs(const std::string& configs_string,
     }
   }
 
+  // only the open-loop mode spreads the requests over several sessions
+  if (test_config.run_config.num_sessions > 1 && test_config.run_config.open_loop_qps.empty()) {
+    return false;
+  }
+
+  if (test_config.run_config.f_op_report && test_config.run_config.profile_file.empty()) {
+    test_config.run_config.profile_file = ORT_TSTR("onnxruntime_perf_test_op_report");
+  }
+
   // parse model_path and result_file_path
   argc -= optind;
   argv += optind;
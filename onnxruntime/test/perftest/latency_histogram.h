@@ -0,0 +1,16 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/log_linear_histogram.h"
+
+namespace onnxruntime {
+namespace perftest {
+
+// Latencies of the open-loop test in nanoseconds. 1024 buckets per power of two keep the percentiles to about
+// 3 significant digits at any magnitude. Values of 2^40 ns (about 18 minutes) and above share the last bucket.
+using LatencyHistogram = LogLinearHistogram</*SubBucketBits*/ 10, /*MaxExponent*/ 40>;
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -0,0 +1,299 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "op_report.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/graph/onnx_protobuf.h"
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+namespace onnxruntime {
+namespace perftest {
+
+namespace {
+
+using Shape = std::vector<int64_t>;
+
+double NumElements(const Shape& shape) {
+  double n = 1;
+  for (int64_t dim : shape) {
+    n *= static_cast<double>(dim);
+  }
+  return n;
+}
+
+// product of all the dimensions but the first, i.e. the size of a filter of a Conv weight
+double FilterSize(const Shape& weight_shape) {
+  return weight_shape.empty() ? 0 : NumElements(Shape(weight_shape.begin() + 1, weight_shape.end()));
+}
+
+// input_type_shape and output_type_shape of a kernel event, e.g. [{"float":[1,3,224,224]},{"float":[64,3,7,7]}]
+std::vector<Shape> ParseShapes(const json& args, const char* name) {
+  std::vector<Shape> shapes;
+  auto it = args.find(name);
+  if (it == args.end() || !it->is_array()) {
+    return shapes;
+  }
+  for (const auto& type_shape : *it) {
+    Shape shape;
+    if (type_shape.is_object() && !type_shape.empty() && type_shape.begin()->is_array()) {
+      for (const auto& dim : *type_shape.begin()) {
+        shape.push_back(dim.is_number() ? dim.get<int64_t>() : 0);
+      }
+    }
+    shapes.push_back(std::move(shape));
+  }
+  return shapes;
+}
+
+// Rough FLOP count of a node. Multiply-adds count as 2 FLOPs.
+double EstimateFlops(const std::string& op_type, const std::vector<Shape>& inputs, const std::vector<Shape>& outputs) {
+  static const std::unordered_set<std::string> data_movement_ops = {
+      "Cast", "Concat", "DepthToSpace", "Expand", "Flatten", "Gather", "GatherElements", "GatherND", "Identity",
+      "MemcpyFromHost", "MemcpyToHost", "Pad", "Reshape", "Shape", "Slice", "SpaceToDepth", "Split", "Squeeze", "Tile",
+      "Transpose", "Unsqueeze"};
+  static const std::unordered_set<std::string> reduction_ops = {
+      "AveragePool", "GlobalAveragePool", "GlobalMaxPool", "MaxPool", "ReduceL2", "ReduceMax", "ReduceMean",
+      "ReduceMin", "ReduceSum", "ReduceSumSquare"};
+
+  if (outputs.empty() || data_movement_ops.count(op_type) > 0) {
+    return 0;
+  }
+  const double output_elements = NumElements(outputs[0]);
+
+  if ((op_type == "MatMul" || op_type == "MatMulInteger") && !inputs.empty() && !inputs[0].empty()) {
+    return 2 * output_elements * static_cast<double>(inputs[0].back());
+  }
+  if (op_type == "Gemm" && !inputs.empty() && !outputs[0].empty() && outputs[0][0] > 0) {
+    // A is M x K or K x M
+    return 2 * output_elements * NumElements(inputs[0]) / static_cast<double>(outputs[0][0]);
+  }
+  if ((op_type == "Conv" || op_type == "FusedConv" || op_type == "NhwcFusedConv" || op_type == "ConvInteger") &&
+      inputs.size() > 1) {
+    // every output element is a dot product with a filter of C/group x kernel size
+    return 2 * output_elements * FilterSize(inputs[1]);
+  }
+  if (op_type == "QLinearConv" && inputs.size() > 3) {
+    return 2 * output_elements * FilterSize(inputs[3]);
+  }
+  if (op_type == "ConvTranspose" && inputs.size() > 1) {
+    // every input element is scattered with a filter of M/group x kernel size
+    return 2 * NumElements(inputs[0]) * FilterSize(inputs[1]);
+  }
+  if (reduction_ops.count(op_type) > 0 && !inputs.empty()) {
+    return NumElements(inputs[0]);
+  }
+
+  // element-wise ops and everything else: one FLOP per output element
+  return output_elements;
+}
+
+double ArgAsNumber(const json& args, const char* name) {
+  auto it = args.find(name);
+  if (it == args.end() || !it->is_string()) {
+    return 0;
+  }
+  return std::strtod(it->get<std::string>().c_str(), nullptr);
+}
+
+struct NodeStats {
+  std::string op_type;
+  size_t count{0};
+  double total_us{0};
+  double flops{0};
+  double bytes{0};
+  // derived
+  double ideal_us{0};
+  double lost_us{0};
+};
+
+#if !defined(ORT_MINIMAL_BUILD)
+// model with a single float node of op_type, with inputs X0, X1, ... and output Y
+std::string MakeSingleNodeModel(const std::string& op_type, const std::vector<Shape>& input_shapes,
+                                const Shape& output_shape) {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(7);
+  auto* opset = model.add_opset_import();
+  opset->set_domain("");
+  opset->set_version(13);
+
+  auto* graph = model.mutable_graph();
+  graph->set_name("peak");
+  auto add_value_info = [](ONNX_NAMESPACE::ValueInfoProto* value_info, const std::string& name, const Shape& shape) {
+    value_info->set_name(name);
+    auto* tensor_type = value_info->mutable_type()->mutable_tensor_type();
+    tensor_type->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    for (int64_t dim : shape) {
+      tensor_type->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+  };
+
+  auto* node = graph->add_node();
+  node->set_op_type(op_type);
+  for (size_t i = 0; i < input_shapes.size(); ++i) {
+    const std::string name = "X" + std::to_string(i);
+    node->add_input(name);
+    add_value_info(graph->add_input(), name, input_shapes[i]);
+  }
+  node->add_output("Y");
+  add_value_info(graph->add_output(), "Y", output_shape);
+
+  return model.SerializeAsString();
+}
+
+// best time of a few runs of the model, in seconds
+double TimeSingleNodeModel(Ort::Env& env, const Ort::SessionOptions& session_options, const std::string& model_data,
+                           const std::vector<Shape>& input_shapes) {
+  Ort::Session session(env, model_data.data(), model_data.size(), session_options);
+  Ort::AllocatorWithDefaultOptions allocator;
+
+  std::vector<Ort::Value> inputs;
+  std::vector<std::string> input_names;
+  for (size_t i = 0; i < input_shapes.size(); ++i) {
+    inputs.push_back(Ort::Value::CreateTensor<float>(allocator, input_shapes[i].data(), input_shapes[i].size()));
+    float* data = inputs.back().GetTensorMutableData<float>();
+    std::fill(data, data + static_cast<size_t>(NumElements(input_shapes[i])), 1.0f);
+    input_names.push_back("X" + std::to_string(i));
+  }
+  std::vector<const char*> input_names_raw;
+  for (const auto& name : input_names) {
+    input_names_raw.push_back(name.c_str());
+  }
+  const char* output_name = "Y";
+
+  constexpr int num_runs = 10;
+  double best_seconds = std::numeric_limits<double>::max();
+  // the first run is a warm-up
+  for (int i = 0; i <= num_runs; ++i) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    session.Run(Ort::RunOptions{nullptr}, input_names_raw.data(), inputs.data(), inputs.size(), &output_name, 1);
+    const std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+    if (i > 0) {
+      best_seconds = std::min(best_seconds, duration.count());
+    }
+  }
+  return best_seconds;
+}
+#endif
+
+}  // namespace
+
+Status MeasureMachinePeak(Ort::Env& env, int intra_op_num_threads, MachinePeak& peak) {
+#if !defined(ORT_MINIMAL_BUILD)
+  Ort::SessionOptions session_options;
+  if (intra_op_num_threads > 0) {
+    session_options.SetIntraOpNumThreads(intra_op_num_threads);
+  }
+
+  // compute bound: 2 * n^3 FLOPs over 3 * n^2 floats
+  constexpr int64_t n = 1024;
+  const double matmul_seconds = TimeSingleNodeModel(
+      env, session_options, MakeSingleNodeModel("MatMul", {{n, n}, {n, n}}, {n, n}), {{n, n}, {n, n}});
+  peak.gflops = 2.0 * n * n * n / matmul_seconds / 1e9;
+
+  // memory bound: reads two and writes one buffer, each much larger than the last level cache
+  constexpr int64_t num_elements = int64_t{1} << 24;
+  const double add_seconds = TimeSingleNodeModel(
+      env, session_options, MakeSingleNodeModel("Add", {{num_elements}, {num_elements}}, {num_elements}),
+      {{num_elements}, {num_elements}});
+  peak.gbps = 3.0 * num_elements * sizeof(float) / add_seconds / 1e9;
+
+  return Status::OK();
+#else
+  ORT_UNUSED_PARAMETER(env);
+  ORT_UNUSED_PARAMETER(intra_op_num_threads);
+  ORT_UNUSED_PARAMETER(peak);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Measuring the machine peak requires ONNX model support.");
+#endif
+}
+
+Status PrintOpReport(const std::string& profile_file, const MachinePeak& peak, std::ostream& out) {
+  std::ifstream profile(profile_file);
+  ORT_RETURN_IF_NOT(profile.good(), "Failed to open the profile file ", profile_file);
+  const json events = json::parse(profile, nullptr, /*allow_exceptions*/ false);
+  ORT_RETURN_IF(events.is_discarded() || !events.is_array(), "Failed to parse the profile file ", profile_file);
+  ORT_RETURN_IF_NOT(peak.gflops > 0 && peak.gbps > 0, "The machine peak must be positive.");
+
+  static const std::string kernel_time_suffix = "_kernel_time";
+  std::unordered_map<std::string, NodeStats> node_stats;
+  for (const auto& event : events) {
+    if (event.value("cat", "") != "Node") {
+      continue;
+    }
+    const std::string name = event.value("name", "");
+    if (name.size() <= kernel_time_suffix.size() ||
+        name.compare(name.size() - kernel_time_suffix.size(), kernel_time_suffix.size(), kernel_time_suffix) != 0) {
+      continue;
+    }
+    const json& args = event.contains("args") ? event["args"] : json::object();
+    NodeStats& stats = node_stats[name.substr(0, name.size() - kernel_time_suffix.size())];
+    stats.op_type = args.value("op_name", "");
+    ++stats.count;
+    stats.total_us += event.value("dur", 0.0);
+    // estimated per event, as the shapes may differ between runs
+    stats.flops += EstimateFlops(stats.op_type, ParseShapes(args, "input_type_shape"),
+                                 ParseShapes(args, "output_type_shape"));
+    stats.bytes += ArgAsNumber(args, "activation_size") + ArgAsNumber(args, "parameter_size") +
+                   ArgAsNumber(args, "output_size");
+  }
+  ORT_RETURN_IF(node_stats.empty(), "The profile file ", profile_file, " has no kernel events.");
+
+  std::vector<std::pair<std::string, NodeStats>> nodes(node_stats.begin(), node_stats.end());
+  double total_us = 0;
+  double total_lost_us = 0;
+  for (auto& [name, stats] : nodes) {
+    // GFLOP/s and GB/s are FLOPs and bytes per nanosecond
+    stats.ideal_us = std::max(stats.flops / peak.gflops, stats.bytes / peak.gbps) / 1000.0;
+    stats.lost_us = std::max(0.0, stats.total_us - stats.ideal_us);
+    total_us += stats.total_us;
+    total_lost_us += stats.lost_us;
+  }
+  std::sort(nodes.begin(), nodes.end(), [](const auto& a, const auto& b) {
+    return a.second.lost_us > b.second.lost_us;
+  });
+
+  out << "\nOp report from " << profile_file << "\n"
+      << "Machine peak: " << peak.gflops << " GFLOP/s, " << peak.gbps << " GB/s (CPU execution provider)\n"
+      << "Total kernel time: " << total_us / 1000.0 << " ms, lost against the roofline: " << total_lost_us / 1000.0
+      << " ms\n\n";
+
+  const auto flags = out.flags();
+  const auto precision = out.precision();
+  out << std::left << std::setw(40) << "node" << std::setw(20) << "op_type" << std::right << std::setw(8) << "count"
+      << std::setw(12) << "avg_us" << std::setw(10) << "GFLOP/s" << std::setw(10) << "GB/s" << std::setw(10)
+      << "FLOP/B" << std::setw(9) << "bound" << std::setw(8) << "eff%" << std::setw(12) << "lost_ms" << "\n";
+  out << std::fixed << std::setprecision(2);
+  for (const auto& [name, stats] : nodes) {
+    const double total_ns = stats.total_us * 1000.0;
+    const bool compute_bound = stats.flops / peak.gflops >= stats.bytes / peak.gbps;
+    out << std::left << std::setw(40) << name.substr(0, 39) << std::setw(20) << stats.op_type.substr(0, 19)
+        << std::right << std::setw(8) << stats.count
+        << std::setw(12) << stats.total_us / stats.count
+        << std::setw(10) << (total_ns > 0 ? stats.flops / total_ns : 0.0)
+        << std::setw(10) << (total_ns > 0 ? stats.bytes / total_ns : 0.0)
+        << std::setw(10) << (stats.bytes > 0 ? stats.flops / stats.bytes : 0.0)
+        << std::setw(9) << (compute_bound ? "compute" : "memory")
+        << std::setw(8) << (stats.total_us > 0 ? 100.0 * stats.ideal_us / stats.total_us : 0.0)
+        << std::setw(12) << stats.lost_us / 1000.0 << "\n";
+  }
+  out.flags(flags);
+  out.precision(precision);
+  out << std::endl;
+
+  return Status::OK();
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
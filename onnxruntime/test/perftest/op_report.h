@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+
+#include <core/common/status.h>
+#include <core/session/onnxruntime_cxx_api.h>
+
+namespace onnxruntime {
+namespace perftest {
+
+// Peak compute throughput and memory bandwidth of the machine, measured by running a large MatMul and a large Add.
+struct MachinePeak {
+  double gflops{0};
+  double gbps{0};
+};
+
+// Measures the peak with the CPU execution provider, using intra_op_num_threads threads (0 for the default).
+Status MeasureMachinePeak(Ort::Env& env, int intra_op_num_threads, MachinePeak& peak);
+
+// Prints a roofline report of the kernels in the session profile at profile_file.
+// The FLOPs of every node are estimated from its op type and input/output shapes, and the bytes from the sizes of its
+// inputs and outputs. Nodes are sorted by the time lost against the roofline of the machine, i.e. the kernel time
+// minus the time the node would take running at the peak compute throughput or memory bandwidth, whichever bounds it.
+Status PrintOpReport(const std::string& profile_file, const MachinePeak& peak, std::ostream& out);
+
+}  // namespace perftest
+}  // namespace onnxruntime
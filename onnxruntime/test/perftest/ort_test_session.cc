@@ -42,6 +42,38 @@ std::chrono::duration<double> OnnxRuntimeTestSession::Run() {
   return duration_seconds;
 }
 
+namespace {
+struct AsyncRun {
+  std::function<void(Status status)> callback;
+  // filled by the run and released with it
+  std::vector<Ort::Value> outputs;
+};
+
+void OnAsyncRunDone(void* user_data, OrtValue** /*outputs*/, size_t /*num_outputs*/, OrtStatusPtr status_ptr) {
+  std::unique_ptr<AsyncRun> async_run(static_cast<AsyncRun*>(user_data));
+  Ort::Status status(status_ptr);
+  async_run->callback(status.IsOK() ? Status::OK()
+                                    : ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, status.GetErrorMessage()));
+}
+}  // namespace
+
+void OnnxRuntimeTestSession::RunAsync(std::function<void(Status status)> callback) {
+  const std::uniform_int_distribution<int>::param_type p(0, static_cast<int>(test_inputs_.size() - 1));
+  const size_t id = static_cast<size_t>(dist_(rand_engine_, p));
+  auto& input = test_inputs_.at(id);
+
+  auto async_run = std::make_unique<AsyncRun>();
+  async_run->callback = std::move(callback);
+  for (size_t i = 0; i < output_names_raw_ptr.size(); ++i) {
+    async_run->outputs.emplace_back(nullptr);
+  }
+  session_.RunAsync(Ort::RunOptions{nullptr}, input_names_.data(), input.data(), input_names_.size(),
+                    output_names_raw_ptr.data(), async_run->outputs.data(), output_names_raw_ptr.size(),
+                    OnAsyncRunDone, async_run.get());
+  // owned by the run from here on
+  async_run.release();
+}
+
 OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device& rd,
                                                const PerformanceTestConfig& performance_test_config,
                                                const TestModelInfo& m)
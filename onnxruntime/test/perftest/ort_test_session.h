@@ -30,6 +30,12 @@ class OnnxRuntimeTestSession : public TestSession {
   ~OnnxRuntimeTestSession() = default;
 
   std::chrono::duration<double> Run() override;
+  void RunAsync(std::function<void(Status status)> callback) override;
+
+  std::string EndProfiling() override {
+    Ort::AllocatorWithDefaultOptions allocator;
+    return session_.EndProfilingAllocated(allocator).get();
+  }
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OnnxRuntimeTestSession);
 
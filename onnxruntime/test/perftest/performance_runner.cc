@@ -8,9 +8,12 @@
 
 #include "performance_runner.h"
 #include <iostream>
+#include <sstream>
+#include <thread>
 
 #include "TestCase.h"
 #include "utils.h"
+#include "op_report.h"
 #include "ort_test_session.h"
 using onnxruntime::Status;
 
@@ -131,15 +134,19 @@ Status PerformanceRunner::Run() {
   performance_result_.start = std::chrono::high_resolution_clock::now();
 
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
-  switch (performance_test_config_.run_config.test_mode) {
-    case TestMode::kFixDurationMode:
-      ORT_RETURN_IF_ERROR(FixDurationTest());
-      break;
-    case TestMode::KFixRepeatedTimesMode:
-      ORT_RETURN_IF_ERROR(RepeatedTimesTest());
-      break;
-    default:
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+  if (!performance_test_config_.run_config.open_loop_qps.empty()) {
+    ORT_RETURN_IF_ERROR(OpenLoopTest());
+  } else {
+    switch (performance_test_config_.run_config.test_mode) {
+      case TestMode::kFixDurationMode:
+        ORT_RETURN_IF_ERROR(FixDurationTest());
+        break;
+      case TestMode::KFixRepeatedTimesMode:
+        ORT_RETURN_IF_ERROR(RepeatedTimesTest());
+        break;
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+    }
   }
   performance_result_.end = std::chrono::high_resolution_clock::now();
 
@@ -165,9 +172,33 @@ Status PerformanceRunner::Run() {
             << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes"
             << std::endl;
 
+  if (performance_test_config_.run_config.f_op_report) {
+    ORT_RETURN_IF_ERROR(PrintOpReport());
+  }
+
   return Status::OK();
 }
 
+Status PerformanceRunner::PrintOpReport() {
+  const std::string profile_file = session_->EndProfiling();
+  ORT_RETURN_IF(profile_file.empty(), "The op report is not supported by this backend.");
+
+  // measured after the test so that it doesn't interfere with it
+  MachinePeak peak;
+  auto status = Status::OK();
+  ORT_TRY {
+    status = MeasureMachinePeak(env_, performance_test_config_.run_config.intra_op_num_threads, peak);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to measure the machine peak: ", ex.what());
+    });
+  }
+  ORT_RETURN_IF_ERROR(status);
+
+  return perftest::PrintOpReport(profile_file, peak, std::cout);
+}
+
 Status PerformanceRunner::FixDurationTest() {
   if (performance_test_config_.run_config.concurrent_session_runs <= 1) {
     return RunFixDuration();
@@ -255,6 +286,118 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::OpenLoopTest() {
+  using Clock = std::chrono::steady_clock;
+  const auto& run_config = performance_test_config_.run_config;
+
+  std::vector<TestSession*> sessions{session_.get()};
+  for (auto& session : additional_sessions_) {
+    sessions.push_back(session.get());
+  }
+
+  // session_ was warmed up by Run()
+  auto status = Status::OK();
+  ORT_TRY {
+    for (auto& session : additional_sessions_) {
+      session->Run();
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::OpenLoopTest caught exception: ", ex.what());
+    });
+  }
+  ORT_RETURN_IF_ERROR(status);
+
+  std::mt19937 rand_engine(std::random_device{}());
+  std::ostringstream report;
+  report << "\nOpen-loop results (" << (run_config.open_loop_poisson_arrivals ? "poisson" : "fixed") << " arrivals, "
+         << sessions.size() << " session(s), " << run_config.duration_in_seconds << " s per rate):\n"
+         << "target_qps,achieved_qps,requests,failed,mean_ms,p50_ms,p90_ms,p99_ms,p999_ms,max_ms\n";
+
+  LatencyHistogram histogram;
+  for (const double qps : run_config.open_loop_qps) {
+    histogram.Reset();
+    size_t in_flight = 0;
+    size_t num_failed = 0;
+    std::string first_error;
+    Clock::time_point last_completion;
+    OrtCondVar cv;
+
+    auto on_done = [this, &histogram, &in_flight, &num_failed, &first_error, &last_completion, &cv](
+                       Clock::time_point scheduled_start, const Status& request_status) {
+      const auto now = Clock::now();
+      std::lock_guard<OrtMutex> guard(results_mutex_);
+      if (request_status.IsOK()) {
+        // from the scheduled start rather than the submission, so that a late generator doesn't hide queueing
+        const std::chrono::duration<double> latency = now - scheduled_start;
+        histogram.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count()));
+        performance_result_.time_costs.emplace_back(latency.count());
+        performance_result_.total_time_cost += latency.count();
+      } else {
+        if (num_failed++ == 0) {
+          first_error = request_status.ErrorMessage();
+        }
+      }
+      last_completion = std::max(last_completion, now);
+      --in_flight;
+      cv.notify_all();
+    };
+
+    std::exponential_distribution<double> interval_seconds(qps);
+    const auto fixed_interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / qps));
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::seconds(run_config.duration_in_seconds);
+    last_completion = start;
+    size_t num_requests = 0;
+    for (auto next_start = start; next_start < end; ++num_requests) {
+      std::this_thread::sleep_until(next_start);
+      {
+        std::lock_guard<OrtMutex> guard(results_mutex_);
+        ++in_flight;
+      }
+
+      auto submit_status = Status::OK();
+      ORT_TRY {
+        sessions[num_requests % sessions.size()]->RunAsync([next_start, &on_done](Status request_status) {
+          on_done(next_start, request_status);
+        });
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          submit_status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+        });
+      }
+      if (!submit_status.IsOK()) {
+        // e.g. the RunAsync queue of the session is full
+        on_done(next_start, submit_status);
+      }
+
+      next_start += run_config.open_loop_poisson_arrivals
+                        ? std::chrono::duration_cast<Clock::duration>(
+                              std::chrono::duration<double>(interval_seconds(rand_engine)))
+                        : fixed_interval;
+    }
+
+    std::unique_lock<OrtMutex> lock(results_mutex_);
+    cv.wait(lock, [&in_flight]() { return in_flight == 0; });
+
+    const std::chrono::duration<double> elapsed = last_completion - start;
+    const auto to_ms = [](uint64_t ns) { return ns / 1e6; };
+    report << qps << "," << (elapsed.count() > 0 ? histogram.Count() / elapsed.count() : 0.0) << ","
+           << num_requests << "," << num_failed << "," << histogram.Mean() / 1e6 << ","
+           << to_ms(histogram.ValueAtPercentile(0.5)) << "," << to_ms(histogram.ValueAtPercentile(0.9)) << ","
+           << to_ms(histogram.ValueAtPercentile(0.99)) << "," << to_ms(histogram.ValueAtPercentile(0.999)) << ","
+           << to_ms(histogram.Max()) << "\n";
+    if (num_failed > 0) {
+      std::cerr << num_failed << " request(s) failed at " << qps << " qps. First error: " << first_error << "\n";
+    }
+  }
+
+  std::cout << report.str() << std::endl;
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   const auto& file_path = performance_test_config_.model_info.model_file_path;
 #if !defined(ORT_MINIMAL_BUILD)
@@ -271,10 +414,15 @@ static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfi
 }
 
 PerformanceRunner::PerformanceRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd)
-    : performance_test_config_(test_config),
+    : env_(env),
+      performance_test_config_(test_config),
       test_model_info_(CreateModelInfo(test_config)) {
   session_create_start_ = std::chrono::high_resolution_clock::now();
   session_ = std::make_unique<OnnxRuntimeTestSession>(env, rd, performance_test_config_, *test_model_info_);
+  for (size_t i = 1; i < performance_test_config_.run_config.num_sessions; ++i) {
+    additional_sessions_.push_back(
+        std::make_unique<OnnxRuntimeTestSession>(env, rd, performance_test_config_, *test_model_info_));
+  }
   session_create_end_ = std::chrono::high_resolution_clock::now();
 }
 
@@ -299,10 +447,19 @@ bool PerformanceRunner::Initialize() {
   TestModelInfo* test_model_info = test_model_info_.get();
   test_case_ = CreateOnnxTestCase(narrow_model_name, std::move(test_model_info_), 0.0, 0.0);
 
+  std::vector<TestSession*> sessions{session_.get()};
+  for (auto& session : additional_sessions_) {
+    sessions.push_back(session.get());
+  }
+
   if (performance_test_config_.run_config.generate_model_input_binding) {
-    return static_cast<OnnxRuntimeTestSession*>(
-               session_.get())
-        ->PopulateGeneratedInputTestData(performance_test_config_.run_config.random_seed_for_input_data);
+    for (auto* session : sessions) {
+      if (!static_cast<OnnxRuntimeTestSession*>(session)->PopulateGeneratedInputTestData(
+              performance_test_config_.run_config.random_seed_for_input_data)) {
+        return false;
+      }
+    }
+    return true;
   }
 
   // TODO: Place input tensor on cpu memory if dnnl provider type to avoid CopyTensor logic in CopyInputAcrossDevices
@@ -311,19 +468,21 @@ bool PerformanceRunner::Initialize() {
     std::cout << "there is no test data for model " << test_case_->GetTestCaseName() << std::endl;
     return false;
   }
-  for (size_t test_data_id = 0; test_data_id != test_data_count; ++test_data_id) {
-    std::unordered_map<std::string, Ort::Value> feeds;
-    test_case_->LoadTestData(test_data_id /* id */, b_, feeds, true);
-    // Discard the names in feeds
-    int input_count = test_model_info->GetInputCount();
-    for (int i = 0; i != input_count; ++i) {
-      auto iter = feeds.find(test_model_info->GetInputName(i));
-      if (iter == feeds.end()) {
-        std::cout << "there is no test input data for input " << test_model_info->GetInputName(i) << " and model "
-                  << test_case_->GetTestCaseName() << std::endl;
-        return false;
+  for (auto* session : sessions) {
+    for (size_t test_data_id = 0; test_data_id != test_data_count; ++test_data_id) {
+      std::unordered_map<std::string, Ort::Value> feeds;
+      test_case_->LoadTestData(test_data_id /* id */, b_, feeds, true);
+      // Discard the names in feeds
+      int input_count = test_model_info->GetInputCount();
+      for (int i = 0; i != input_count; ++i) {
+        auto iter = feeds.find(test_model_info->GetInputName(i));
+        if (iter == feeds.end()) {
+          std::cout << "there is no test input data for input " << test_model_info->GetInputName(i) << " and model "
+                    << test_case_->GetTestCaseName() << std::endl;
+          return false;
+        }
+        session->PreLoadTestData(test_data_id, static_cast<size_t>(i), std::move(iter->second));
       }
-      session_->PreLoadTestData(test_data_id, static_cast<size_t>(i), std::move(iter->second));
     }
   }
 
@@ -19,6 +19,7 @@
 #include "test_configuration.h"
 #include "heap_buffer.h"
 #include "test_session.h"
+#include "latency_histogram.h"
 #include "OrtValueList.h"
 
 class ITestCase;
@@ -90,6 +91,8 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status OpenLoopTest();
+  Status PrintOpReport();
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
@@ -110,9 +113,12 @@ class PerformanceRunner {
   std::chrono::time_point<std::chrono::high_resolution_clock> session_create_end_;
   PerformanceResult initial_inference_result_;
   PerformanceResult performance_result_;
+  Ort::Env& env_;
   PerformanceTestConfig performance_test_config_;
   std::unique_ptr<TestModelInfo> test_model_info_;
   std::unique_ptr<TestSession> session_;
+  // sessions besides session_ that open-loop requests are spread over
+  std::vector<std::unique_ptr<TestSession>> additional_sessions_;
   onnxruntime::test::HeapBuffer b_;
   std::unique_ptr<ITestCase> test_case_;
 
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "core/graph/constants.h"
 #include "core/framework/session_options.h"
@@ -64,6 +65,11 @@ struct RunConfig {
   bool disable_spinning = false;
   bool disable_spinning_between_run = false;
   bool exit_after_session_creation = false;
+  bool f_op_report{false};
+  // open-loop mode: target request rates to sweep, in requests per second
+  std::vector<double> open_loop_qps;
+  bool open_loop_poisson_arrivals{true};
+  size_t num_sessions{1};
 };
 
 struct PerformanceTestConfig {
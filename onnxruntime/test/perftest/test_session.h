@@ -3,6 +3,10 @@
 
 #pragma once
 #include <stdlib.h>
+#include <functional>
+#include <string>
+
+#include "core/common/common.h"
 
 #include "OrtValueList.h"
 
@@ -16,6 +20,14 @@ class TestSession {
   // Please measure the perf at a higher level.
   void ThreadSafeRun() { abort(); }
   virtual void PreLoadTestData(size_t test_data_id, size_t input_id, Ort::Value&& value) = 0;
+  // Starts a run without waiting for it to complete. callback is called with the status of the run when it completes,
+  // possibly on another thread. Not thread safe, like Run().
+  virtual void RunAsync(std::function<void(Status status)> callback) {
+    ORT_UNUSED_PARAMETER(callback);
+    ORT_THROW("RunAsync is not supported by this backend.");
+  }
+  // Ends profiling and returns the profile file, or an empty string if the session does not support profiling.
+  virtual std::string EndProfiling() { return {}; }
 
   virtual ~TestSession() = default;
 };
@@ -2,9 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/platform/threadpool.h"
+#include "core/common/profiler.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
 #include "core/util/thread_utils.h"
+#include "test/util/include/file_util.h"
 #ifdef _WIN32
 #include "test/platform/windows/env.h"
 #include <Windows.h>
@@ -12,8 +14,11 @@
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <functional>
+#include <sstream>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -510,6 +515,89 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+TEST(ThreadPoolTest, TestTelemetry) {
+  ThreadPoolTelemetry no_pool = ThreadPool::GetTelemetry(nullptr);
+  EXPECT_TRUE(no_pool.tasks_executed.empty());
+  EXPECT_EQ(no_pool.parallel_loops, 0u);
+
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr, 4,
+                                         true);
+  const ThreadPoolTelemetry start = ThreadPool::GetTelemetry(tp.get());
+  ASSERT_EQ(start.tasks_executed.size(), 3u);
+
+  constexpr int num_loops = 10;
+  constexpr int num_tasks = 16;
+  auto test_data = CreateTestData(1000);
+  for (int i = 0; i < num_loops; i++) {
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t idx) { IncrementElement(*test_data, idx); });
+  }
+  ValidateTestData(*test_data, num_loops);
+
+  onnxruntime::Barrier barrier(num_tasks);
+  for (int i = 0; i < num_tasks; i++) {
+    ThreadPool::Schedule(tp.get(), [&]() { barrier.Notify(); });
+  }
+  barrier.Wait();
+
+  const ThreadPoolTelemetry delta = ThreadPool::GetTelemetry(tp.get()).Since(start);
+  uint64_t tasks_executed = 0;
+  for (auto tasks : delta.tasks_executed) {
+    tasks_executed += tasks;
+  }
+  // the tasks scheduled, and the shares of the parallel loops handed to the workers.  The last task may be counted
+  // after the barrier is notified.
+  EXPECT_GE(tasks_executed, static_cast<uint64_t>(num_tasks) - 1);
+  EXPECT_EQ(delta.parallel_loops, static_cast<uint64_t>(num_loops));
+  EXPECT_GE(delta.parallel_loop_ns, delta.parallel_loop_wait_ns);
+
+  const std::string json = delta.ToJson();
+  EXPECT_NE(json.find("\"threads\": 3, "), std::string::npos) << json;
+  EXPECT_NE(json.find("\"parallel_loops\": 10, "), std::string::npos) << json;
+  EXPECT_NE(json.find("\"load_imbalance\": "), std::string::npos) << json;
+}
+
+TEST(ThreadPoolTest, TestThreadPoolTrace) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr, 4,
+                                         true);
+  onnxruntime::profiling::Profiler profiler;
+  profiler.EnableThreadPoolTrace();
+  EXPECT_FALSE(profiler.IsThreadPoolTraceEnabled());
+  const auto trace_path = std::filesystem::temp_directory_path() / ORT_TSTR("threadpool_trace_test.json");
+  onnxruntime::test::ScopedFileDeleter trace_file_deleter(trace_path.native());
+  profiler.StartProfiling(trace_path.native());
+  ASSERT_TRUE(profiler.IsThreadPoolTraceEnabled());
+
+  auto test_data = CreateTestData(1000);
+  // loops outside of a trace scope are not recorded
+  ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t idx) { IncrementElement(*test_data, idx); });
+  {
+    const std::string parent = "matmul";
+    onnxruntime::profiling::TraceScope scope(profiler, parent);
+    EXPECT_EQ(onnxruntime::profiling::TraceScope::Current(), &scope);
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t idx) {
+      // the workers run under the scope of the caller
+      const auto* worker_scope = onnxruntime::profiling::TraceScope::Current();
+      ASSERT_NE(worker_scope, nullptr);
+      EXPECT_EQ(worker_scope->Parent(), "matmul");
+      IncrementElement(*test_data, idx);
+    });
+  }
+  EXPECT_EQ(onnxruntime::profiling::TraceScope::Current(), nullptr);
+  ValidateTestData(*test_data, 2);
+
+  profiler.EndProfiling();
+  std::stringstream trace;
+  {
+    std::ifstream profile(trace_path);
+    ASSERT_TRUE(profile);
+    trace << profile.rdbuf();
+  }
+  const std::string json = trace.str();
+  EXPECT_NE(json.find(R"("cat" : "ThreadPool")"), std::string::npos) << json;
+  EXPECT_NE(json.find(R"("name" :"matmul_parallel_work")"), std::string::npos) << json;
+  EXPECT_NE(json.find(R"("parent" : "matmul")"), std::string::npos) << json;
+}
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
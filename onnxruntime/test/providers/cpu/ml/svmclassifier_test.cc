@@ -1,12 +1,116 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
 namespace onnxruntime {
 namespace test {
 
+namespace {
+// Runs a one-vs-one RBF SVMClassifier and compares it with the kernels and pairwise decision sums computed directly
+// in double, the way the kernel did before the RBF kernels and the one-vs-one reduction went through GEMMs.
+void RunRbfSvcAgainstDirectKernel(const std::vector<float>& X, int64_t num_rows,
+                                  const std::vector<float>& support_vectors,
+                                  const std::vector<int64_t>& vectors_per_class,
+                                  const std::vector<float>& coefficients, const std::vector<float>& rho,
+                                  float gamma) {
+  const int64_t class_count = static_cast<int64_t>(vectors_per_class.size());
+  int64_t vector_count = 0;
+  std::vector<int64_t> starting_vector;
+  for (auto count : vectors_per_class) {
+    starting_vector.push_back(vector_count);
+    vector_count += count;
+  }
+  const int64_t feature_count = static_cast<int64_t>(support_vectors.size()) / vector_count;
+  const int64_t num_classifiers = class_count * (class_count - 1) / 2;
+  ASSERT_EQ(X.size(), static_cast<size_t>(num_rows * feature_count));
+  ASSERT_EQ(coefficients.size(), static_cast<size_t>((class_count - 1) * vector_count));
+  ASSERT_EQ(rho.size(), static_cast<size_t>(num_classifiers));
+
+  std::vector<float> expected_scores;
+  std::vector<int64_t> expected_predictions;
+  std::vector<bool> clear_votes;
+  for (int64_t n = 0; n < num_rows; ++n) {
+    std::vector<double> kernels(static_cast<size_t>(vector_count));
+    for (int64_t v = 0; v < vector_count; ++v) {
+      double distance = 0.;
+      for (int64_t f = 0; f < feature_count; ++f) {
+        const double diff = static_cast<double>(X[n * feature_count + f]) - support_vectors[v * feature_count + f];
+        distance += diff * diff;
+      }
+      kernels[v] = std::exp(-gamma * distance);
+    }
+
+    std::vector<int64_t> votes(static_cast<size_t>(class_count), 0);
+    bool clear = true;
+    size_t classifier_idx = 0;
+    for (int64_t i = 0; i < class_count - 1; ++i) {
+      for (int64_t j = i + 1; j < class_count; ++j) {
+        double sum = rho[classifier_idx++];
+        for (int64_t m = 0; m < vectors_per_class[i]; ++m) {
+          sum += coefficients[(j - 1) * vector_count + starting_vector[i] + m] * kernels[starting_vector[i] + m];
+        }
+        for (int64_t m = 0; m < vectors_per_class[j]; ++m) {
+          sum += coefficients[i * vector_count + starting_vector[j] + m] * kernels[starting_vector[j] + m];
+        }
+        expected_scores.push_back(static_cast<float>(sum));
+        ++votes[sum > 0 ? i : j];
+        // a vote on a score this close to 0 may go either way in float
+        clear = clear && std::abs(sum) > 1e-3;
+      }
+    }
+    expected_predictions.push_back(std::distance(votes.begin(), std::max_element(votes.begin(), votes.end())));
+    clear_votes.push_back(clear);
+  }
+
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+  std::vector<int64_t> classes(static_cast<size_t>(class_count));
+  std::iota(classes.begin(), classes.end(), 0);
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", std::vector<float>{gamma, 0.f, 3.f});
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {num_rows, feature_count}, X);
+  test.AddOutput<int64_t>("Y", {num_rows}, expected_predictions);
+  test.AddOutput<float>("Z", {num_rows, num_classifiers}, expected_scores);
+
+  test.SetCustomOutputVerifier([&](const std::vector<OrtValue>& fetches, const std::string& provider_type) {
+    ASSERT_EQ(fetches.size(), 2u);
+    const auto predictions = fetches[0].Get<Tensor>().DataAsSpan<int64_t>();
+    const auto scores = fetches[1].Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(scores.size(), expected_scores.size());
+    for (size_t i = 0; i < expected_scores.size(); ++i) {
+      EXPECT_NEAR(scores[i], expected_scores[i], 1e-4f * std::max(1.f, std::abs(expected_scores[i])))
+          << "score " << i << " provider " << provider_type;
+    }
+    for (int64_t n = 0; n < num_rows; ++n) {
+      if (clear_votes[n]) {
+        EXPECT_EQ(predictions[n], expected_predictions[n]) << "row " << n;
+      }
+    }
+  });
+  test.Run();
+}
+
+// deterministic values in [-1, 1)
+std::vector<float> MakeValues(size_t count, float seed) {
+  std::vector<float> values(count);
+  for (size_t i = 0; i < count; ++i) {
+    values[i] = std::sin(seed + 0.7f * static_cast<float>(i)) * std::cos(0.3f * static_cast<float>(i * i % 17));
+  }
+  return values;
+}
+}  // namespace
+
 TEST(MLOpTest, SVMClassifierMulticlassSVC) {
   OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
 
@@ -263,5 +367,53 @@ TEST(MLOpTest, SVMClassifierLinear) {
   test.Run();
 }
 
+TEST(MLOpTest, SVMClassifierRBFGemmMatchesDirectKernel) {
+  const std::vector<int64_t> vectors_per_class = {3, 2, 4, 1};
+  constexpr int64_t vector_count = 10;
+  constexpr int64_t feature_count = 5;
+  constexpr int64_t num_rows = 16;
+
+  std::vector<float> support_vectors = MakeValues(vector_count * feature_count, 0.1f);
+  std::vector<float> X = MakeValues(num_rows * feature_count, 2.3f);
+  std::vector<float> coefficients = MakeValues(3 * vector_count, 4.7f);
+  std::vector<float> rho = MakeValues(6, 1.9f);
+
+  RunRbfSvcAgainstDirectKernel(X, num_rows, support_vectors, vectors_per_class, coefficients, rho, 0.5f);
+}
+
+TEST(MLOpTest, SVMClassifierRBFGemmLargeNormsAndNearDuplicates) {
+  // support vectors and inputs far from the origin, where ||x||^2 + ||s||^2 - 2 x.s cancels catastrophically in
+  // float without centering, and inputs equal or very close to support vectors, where even the centered expansion
+  // cancels and the distances are recomputed directly.
+  const std::vector<int64_t> vectors_per_class = {2, 2, 2};
+  constexpr int64_t vector_count = 6;
+  constexpr int64_t feature_count = 4;
+
+  std::vector<float> support_vectors = MakeValues(vector_count * feature_count, 0.4f);
+  for (auto& value : support_vectors) {
+    value = 1000.f + 2.f * value;
+  }
+
+  std::vector<float> X;
+  for (int64_t v = 0; v < vector_count; ++v) {
+    // the support vector itself, and a point 1e-3 away in every feature
+    for (float delta : {0.f, 1e-3f}) {
+      for (int64_t f = 0; f < feature_count; ++f) {
+        X.push_back(support_vectors[v * feature_count + f] + delta);
+      }
+    }
+  }
+  // points between the support vectors
+  for (float value : MakeValues(4 * feature_count, 3.1f)) {
+    X.push_back(1000.f + value);
+  }
+  const int64_t num_rows = static_cast<int64_t>(X.size()) / feature_count;
+
+  std::vector<float> coefficients = MakeValues(2 * vector_count, 5.3f);
+  std::vector<float> rho = {0.1f, -0.2f, 0.05f};
+
+  RunRbfSvcAgainstDirectKernel(X, num_rows, support_vectors, vectors_per_class, coefficients, rho, 0.25f);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -689,6 +689,75 @@ TEST(TfIdfVectorizerTest, String_TFIDFWeights_onlyBigrams_Skip5_2rows) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+// ngram_indexes leaves gaps so the output is larger than weights. weights are indexed by output index,
+// outputs past the end of weights keep the count.
+TEST(TfIdfVectorizerTest, Int32_TFIDF_SparseNgramIndexes) {
+  OpTester test("TfIdfVectorizer", opset_ver);
+  // s=0, Min=Max=1, weights 4 for 10 outputs, int32
+  InitTestAttr(test, "TFIDF", 1, 1, 0,
+               {0},
+               {0, 7, 3, 9},  // 10 outputs
+               {0.5f, 2.f, 3.f, 4.f},
+               {2, 3, 5, 4},  // 1-grams
+               {});
+
+  test.AddInput<int32_t>("T", {8}, {2, 2, 3, 5, 4, 4, 4, 1});
+  test.AddOutput<float>("Y", {10}, {1.f, 0.f, 0.f, 4.f, 0.f, 0.f, 0.f, 1.f, 0.f, 3.f});
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
+// Fewer rows than threads: the scan lanes of each row are split across the threads.
+// The counts are checked against a direct count of the skip-grams.
+TEST(TfIdfVectorizerTest, Int64_TFIDF_UniAndBigrams_Skip5_LongRowsSplitAcrossThreads) {
+  OpTester test("TfIdfVectorizer", opset_ver);
+  const std::vector<int64_t> pool = {2, 3, 5, 4,         // 1-grams
+                                     5, 6, 7, 8, 6, 7};  // bi-grams
+  const std::vector<float> weights = {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f};
+  constexpr int64_t max_skip_count = 5;
+  InitTestAttr(test, "TFIDF", 1, 2, max_skip_count,
+               {0, 4},
+               {0, 1, 2, 3, 4, 5, 6},  // 7 output indexes
+               weights,
+               pool,
+               {});
+
+  constexpr size_t num_rows = 2;
+  constexpr size_t row_size = 1000;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int64_t> dis(1, 8);
+  std::vector<int64_t> input(num_rows * row_size);
+  for (auto& item : input) {
+    item = dis(gen);
+  }
+
+  std::vector<float> output(num_rows * weights.size(), 0.f);
+  for (size_t row = 0; row < num_rows; ++row) {
+    const int64_t* items = input.data() + row * row_size;
+    float* out = output.data() + row * weights.size();
+    for (size_t i = 0; i < row_size; ++i) {
+      for (size_t unigram = 0; unigram < 4; ++unigram) {
+        out[unigram] += items[i] == pool[unigram] ? 1.f : 0.f;
+      }
+      for (size_t distance = 1; distance <= max_skip_count + 1 && i + distance < row_size; ++distance) {
+        for (size_t bigram = 0; bigram < 3; ++bigram) {
+          out[4 + bigram] += items[i] == pool[4 + 2 * bigram] && items[i + distance] == pool[5 + 2 * bigram] ? 1.f : 0.f;
+        }
+      }
+    }
+    for (size_t i = 0; i < weights.size(); ++i) {
+      out[i] *= weights[i];
+    }
+  }
+
+  test.AddInput<int64_t>("T", {static_cast<int64_t>(num_rows), static_cast<int64_t>(row_size)}, input);
+  test.AddOutput<float>("Y", {static_cast<int64_t>(num_rows), static_cast<int64_t>(weights.size())}, output);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  test.Config(so).RunWithConfig();
+}
+
 // This test runs the inference 100 times to test the improvement
 // It enables profiling while running inference multiple times.
 // So we can manually inspect the profiling output
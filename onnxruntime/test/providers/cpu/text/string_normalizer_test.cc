@@ -194,6 +194,36 @@ TEST(ContribOpTest, StringNormalizerInsensitiveFilterOutUpperWithLocale) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(ContribOpTest, StringNormalizerInsensitiveFilterOutLowerManyRows) {
+  // - case-INSENSITIVE approach en_US locale
+  // - enough string data to be processed in several parallel batches, mixing ASCII strings
+  //   with strings that go through the locale
+  // - filter out monday in any case
+  // - the output of one thread and of several threads must be the same
+  const std::vector<std::string> input_block = {"monday", "Monday", "MONDAY", "TuesDay",
+                                                "BESANÇON", "ÉCOLE ÉLÉMENTAIRE", "ПОНЕДЕЛЬНИК", "中文"};
+  const std::vector<std::string> output_block = {"tuesday", "besançon", "école élémentaire", "понедельник", "中文"};
+  constexpr size_t num_blocks = 2000;
+
+  std::vector<std::string> input;
+  std::vector<std::string> output;
+  for (size_t i = 0; i < num_blocks; ++i) {
+    input.insert(input.end(), input_block.begin(), input_block.end());
+    output.insert(output.end(), output_block.begin(), output_block.end());
+  }
+
+  for (int thread_pool_size : {1, 4}) {
+    OpTester test("StringNormalizer", opset_ver, domain);
+    InitTestAttr(test, "LOWER", false, {"monday"}, test_locale);
+    test.AddInput<std::string>("T", {static_cast<int64_t>(input.size())}, input);
+    test.AddOutput<std::string>("Y", {static_cast<int64_t>(output.size())}, output);
+
+    SessionOptions so;
+    so.intra_op_param.thread_pool_size = thread_pool_size;
+    test.Config(so).RunWithConfig();
+  }
+}
+
 TEST(ContribOpTest, StringNormalizerSensitiveFilterOutUpperEmptyCase) {
   // Empty output case
   // - casesensitive approach
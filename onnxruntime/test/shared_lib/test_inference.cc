@@ -4373,7 +4373,7 @@ void CallbackFail(void*, OrtValue**, size_t, OrtStatusPtr) {
 
 TEST(CApiTest, RunAsyncFail) {
   Ort::SessionOptions session_options;
-  session_options.SetIntraOpNumThreads(1);  // This will cause RunAsync fail
+  session_options.AddConfigEntry("session.run_async_max_in_flight", "0");  // This will cause RunAsync fail
   Ort::Session session(*ort_env, MODEL_URI, session_options);
 
   const char* input_names[] = {"X"};
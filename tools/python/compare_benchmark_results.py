@@ -0,0 +1,138 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+# --------------------------------------------------------------------------
+# Compares the Google Benchmark JSON results of two builds, e.g. of the onnxruntime_benchmark model suite, and
+# reports the benchmarks that got significantly slower or faster.
+#
+# Run the benchmarks with repetitions so that there are samples to compare:
+#   onnxruntime_benchmark --benchmark_filter=BM_ModelSuite --benchmark_repetitions=10 \
+#       --benchmark_out=results.json --benchmark_out_format=json
+#
+# A change is reported when the Mann-Whitney U test rejects that both builds have the same distribution of times
+# at the given significance level, and the medians differ by more than the threshold. The exit code is 1 if there
+# are regressions, so the script can gate CI jobs.
+
+import argparse
+import json
+import math
+import statistics
+import sys
+from collections import defaultdict
+
+TIME_UNIT_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description="Compare Google Benchmark JSON results of two builds.")
+    parser.add_argument("baseline", help="JSON results of the baseline build")
+    parser.add_argument("contender", help="JSON results of the build to check")
+    parser.add_argument(
+        "--metric", choices=["real_time", "cpu_time"], default="real_time", help="time to compare. Default: real_time"
+    )
+    parser.add_argument("--alpha", type=float, default=0.05, help="significance level of the test. Default: 0.05")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.05,
+        help="minimum relative change of the median to report, e.g. 0.05 for 5%%. Default: 0.05",
+    )
+    return parser.parse_args()
+
+
+def load_samples(path, metric):
+    """Returns the times in ns of the repetitions of every benchmark, by benchmark name."""
+    with open(path) as f:
+        results = json.load(f)
+
+    samples = defaultdict(list)
+    for benchmark in results["benchmarks"]:
+        if benchmark.get("run_type", "iteration") != "iteration" or "error_occurred" in benchmark:
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        samples[name].append(benchmark[metric] * TIME_UNIT_NS[benchmark.get("time_unit", "ns")])
+    return samples
+
+
+def mann_whitney_u_p_value(a, b):
+    """Two-sided p-value of the Mann-Whitney U test, with the normal approximation corrected for ties."""
+    n1, n2 = len(a), len(b)
+    values = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+    n = n1 + n2
+
+    # average ranks of tied values
+    rank_sum_a = 0.0
+    tie_term = 0.0
+    i = 0
+    while i < n:
+        j = i
+        while j + 1 < n and values[j + 1][0] == values[i][0]:
+            j += 1
+        rank = (i + j) / 2.0 + 1.0
+        rank_sum_a += rank * sum(1 for k in range(i, j + 1) if values[k][1] == 0)
+        ties = j - i + 1
+        tie_term += ties**3 - ties
+        i = j + 1
+
+    u = rank_sum_a - n1 * (n1 + 1) / 2.0
+    mean = n1 * n2 / 2.0
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    # continuity correction
+    z = (abs(u - mean) - 0.5) / math.sqrt(variance)
+    return min(1.0, math.erfc(max(z, 0.0) / math.sqrt(2.0)))
+
+
+def format_time(ns):
+    for unit in ["s", "ms", "us"]:
+        if ns >= TIME_UNIT_NS[unit]:
+            return f"{ns / TIME_UNIT_NS[unit]:.3f} {unit}"
+    return f"{ns:.1f} ns"
+
+
+def main():
+    args = parse_arguments()
+    baseline = load_samples(args.baseline, args.metric)
+    contender = load_samples(args.contender, args.metric)
+
+    names = [name for name in baseline if name in contender]
+    if not names:
+        print("The results have no benchmarks in common.")
+        return 1
+
+    regressions = []
+    rows = []
+    for name in names:
+        a, b = baseline[name], contender[name]
+        median_a, median_b = statistics.median(a), statistics.median(b)
+        change = (median_b - median_a) / median_a if median_a > 0 else 0.0
+        # the test can't reach significance with fewer samples
+        p_value = mann_whitney_u_p_value(a, b) if min(len(a), len(b)) >= 3 else 1.0
+
+        verdict = ""
+        if p_value < args.alpha and abs(change) > args.threshold:
+            verdict = "REGRESSION" if change > 0 else "improvement"
+            if change > 0:
+                regressions.append(name)
+        rows.append((name, format_time(median_a), format_time(median_b), f"{change:+.1%}", f"{p_value:.4f}", verdict))
+
+    headers = ("benchmark", "baseline", "contender", "change", "p-value", "")
+    widths = [max(len(row[i]) for row in [headers, *rows]) for i in range(len(headers))]
+    for row in [headers, *rows]:
+        print("  ".join(cell.ljust(width) for cell, width in zip(row, widths)).rstrip())
+
+    missing = sorted(set(baseline) ^ set(contender))
+    if missing:
+        print(f"\n{len(missing)} benchmark(s) are only in one of the results: {', '.join(missing)}")
+
+    few_samples = [name for name in names if min(len(baseline[name]), len(contender[name])) < 3]
+    if few_samples:
+        print(f"\n{len(few_samples)} benchmark(s) have fewer than 3 repetitions and were not tested.")
+
+    print(f"\n{len(regressions)} regression(s) at alpha={args.alpha} and threshold={args.threshold:.1%} on {args.metric}.")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())